@@ -62,6 +62,7 @@
 #include <Base/Type.h>
 #include <Base/BaseClass.h>
 #include <Base/Persistence.h>
+#include <Base/Profiler.h>
 #include <Base/Reader.h>
 #include <Base/MatrixPy.h>
 #include <Base/VectorPy.h>
@@ -913,6 +914,7 @@ void Application::destruct(void)
 
     ScriptFactorySingleton::Destruct();
     InterpreterSingleton::Destruct();
+    Base::Profiler::destruct();
     Base::Type::destruct();
 }
 
@@ -1227,6 +1229,12 @@ void Application::initConfig(int argc, char ** argv)
         mConfig["AppTempPath"] = tmpPath + "/";
     }
 
+    // Console output can be delivered by a background thread and throttled
+    ParameterGrp::handle hGen = _pcUserParamMngr->GetGroup("BaseApp/Preferences/General");
+    if (hGen->GetBool("AsyncConsole", false))
+        Base::Console().SetMode(Base::ConsoleSingleton::Async);
+    Base::Console().SetRateLimit(hGen->GetInt("ConsoleRateLimit", 0));
+
 
     // capture python variables
     SaveEnv("PYTHONPATH");
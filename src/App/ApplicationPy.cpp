@@ -27,6 +27,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <sstream>
 # include <stdexcept>
 #endif
 
@@ -43,6 +44,8 @@
 #include <Base/Console.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
+#include <Base/Profiler.h>
+#include <Base/Stream.h>
 #include <Base/UnitsApi.h>
 
 //using Base::GetConsole;
@@ -129,6 +132,16 @@ PyMethodDef Application::Methods[] = {
     {"removeDocumentObserver",  (PyCFunction) Application::sRemoveDocObserver  ,1,
      "removeDocumentObserver() -> None\n\n"
      "Remove an added document observer."},
+    {"setProfiling",  (PyCFunction) Application::sSetProfiling  ,1,
+     "setProfiling(bool, [clear=True]) -> None\n\n"
+     "Enable or disable the profiler which records the run time of recomputes,\n"
+     "saving, restoring and other instrumented operations. Unless clear is False\n"
+     "enabling it removes the data recorded so far."},
+    {"writeProfile",  (PyCFunction) Application::sWriteProfile  ,1,
+     "writeProfile([string]) -> string\n\n"
+     "Return a table of the sections recorded by the profiler sorted by their\n"
+     "total time. If a file name is given the events are also written to this file\n"
+     "in the Chrome trace format."},
 
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
@@ -589,3 +602,45 @@ PyObject* Application::sRemoveDocObserver(PyObject * /*self*/, PyObject *args,Py
         Py_Return;
     } PY_CATCH;
 }
+
+PyObject* Application::sSetProfiling(PyObject * /*self*/, PyObject *args,PyObject * /*kwd*/)
+{
+    PyObject* on;
+    PyObject* clear=Py_True;
+    if (!PyArg_ParseTuple(args, "O!|O!",&PyBool_Type,&on,&PyBool_Type,&clear))
+        return NULL;
+    PY_TRY {
+        Base::Profiler& profiler = Base::Profiler::instance();
+        if (PyObject_IsTrue(on) && PyObject_IsTrue(clear))
+            profiler.clear();
+        profiler.setEnabled(PyObject_IsTrue(on) ? true : false);
+        Py_Return;
+    } PY_CATCH;
+}
+
+PyObject* Application::sWriteProfile(PyObject * /*self*/, PyObject *args,PyObject * /*kwd*/)
+{
+    char* traceFile=0;
+    if (!PyArg_ParseTuple(args, "|et","utf-8",&traceFile))
+        return NULL;
+    std::string fileName;
+    if (traceFile) {
+        fileName = traceFile;
+        PyMem_Free(traceFile);
+    }
+
+    PY_TRY {
+        Base::Profiler& profiler = Base::Profiler::instance();
+        if (!fileName.empty()) {
+            Base::FileInfo fi(fileName);
+            Base::ofstream str(fi, std::ios::out | std::ios::binary);
+            if (!str)
+                throw Base::FileException("Cannot open file", fi);
+            profiler.writeChromeTrace(str);
+        }
+
+        std::stringstream summary;
+        profiler.writeSummary(summary);
+        return Py::new_reference_to(Py::String(summary.str()));
+    } PY_CATCH;
+}
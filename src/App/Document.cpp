@@ -74,6 +74,8 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #include "DocumentPy.h"
 #include "Application.h"
 #include "DocumentObject.h"
+#include "GeoFeature.h"
+#include "PropertyFile.h"
 #include "PropertyLinks.h"
 #include "MergeDocuments.h"
 
@@ -81,6 +83,7 @@ recompute path. Also enables more complicated dependencies beyond trees.
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/TimeInfo.h>
+#include <Base/Profiler.h>
 #include <Base/Interpreter.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -129,11 +132,24 @@ typedef Traits::edge_descriptor Edge;
 namespace App {
 
 // Pimpl class
+// Orders the numeric suffixes of object names the same way as Base::Tools::getUniqueName
+struct SuffixCompare : public std::binary_function<std::string, std::string, bool>
+{
+    bool operator()(const std::string& s1, const std::string& s2) const
+    {
+        if (s1.size() != s2.size())
+            return s1.size() < s2.size();
+        return s1 < s2;
+    }
+};
+
 struct DocumentP
 {
     // Array to preserve the creation order of created objects
     std::vector<DocumentObject*> objectArray;
     std::map<std::string,DocumentObject*> objectMap;
+    // Numeric suffixes of the object names grouped by the name without its trailing digits
+    std::map<std::string, std::set<std::string, SuffixCompare> > nameSuffixes;
     DocumentObject* activeObject;
     Transaction *activeUndoTransaction;
     Transaction *activeTransaction;
@@ -149,6 +165,29 @@ struct DocumentP
     unsigned int UndoMaxStackSize;
     DependencyList DepList;
     std::map<DocumentObject*,Vertex> VertexObjectList;
+    // Cached out list of every object of the document and the reverse links
+    std::map<const DocumentObject*, std::vector<DocumentObject*> > outLists;
+    std::map<const DocumentObject*, std::vector<DocumentObject*> > inLists;
+    // Objects with expressions indexed by the identifiers their expressions use, so that
+    // only the objects which may refer to a new, removed or relabeled object are updated
+    std::map<std::string, std::set<DocumentObject*> > expressionObjects;
+    std::map<const DocumentObject*, std::set<std::string> > expressionNames;
+    // Objects created during a bulk creation which are not announced yet
+    std::vector<DocumentObject*> bulkObjects;
+    int bulkCreation;
+    // Files of the object properties inside the project file persistedArchive that
+    // are unchanged since the document was restored from or saved to this file
+    struct PersistedFile {
+        std::string file;
+        std::string object;
+        std::string property;
+    };
+    std::map<const Property*, PersistedFile> persistedFiles;
+    std::string persistedArchive;
+    unsigned int persistedSize;
+    Base::TimeInfo persistedTime;
+    int persistedVersion;
+    bool savingCopy;
 
     DocumentP() {
         activeObject = 0;
@@ -162,6 +201,147 @@ struct DocumentP
         iUndoMode = 0;
         UndoMemSize = 0;
         UndoMaxStackSize = 20;
+        bulkCreation = 0;
+        persistedSize = 0;
+        persistedVersion = 0;
+        savingCopy = false;
+    }
+
+    static std::string::size_type suffixPosition(const std::string& name) {
+        std::string::size_type index = name.find_last_not_of("0123456789");
+        return index == std::string::npos ? 0 : index + 1;
+    }
+    void addObjectName(const std::string& name) {
+        std::string::size_type index = suffixPosition(name);
+        if (index < name.size())
+            nameSuffixes[name.substr(0, index)].insert(name.substr(index));
+    }
+    bool removeBulkObject(DocumentObject* obj) {
+        std::vector<DocumentObject*>::iterator it = std::find(bulkObjects.begin(), bulkObjects.end(), obj);
+        if (it == bulkObjects.end())
+            return false;
+        bulkObjects.erase(it);
+        return true;
+    }
+    void setPersistedFiles(const Document* doc, const std::string& archive, int version,
+                           const std::map<const Base::Persistence*, std::string>& files) {
+        persistedFiles.clear();
+        persistedArchive = archive;
+        persistedVersion = version;
+        Base::FileInfo fi(archive);
+        persistedSize = fi.size();
+        persistedTime = fi.lastModified();
+        std::map<const Base::Persistence*, std::string>::const_iterator it;
+        for (it = files.begin(); it != files.end(); ++it) {
+            // only the properties of the objects are tracked, an included file
+            // may be modified in the transient directory without notification
+            if (!it->first->getTypeId().isDerivedFrom(Property::getClassTypeId()) ||
+                it->first->getTypeId().isDerivedFrom(PropertyFileIncluded::getClassTypeId()))
+                continue;
+            const Property* prop = static_cast<const Property*>(it->first);
+            PropertyContainer* container = prop->getContainer();
+            if (!container || !container->getTypeId().isDerivedFrom(DocumentObject::getClassTypeId()))
+                continue;
+            const DocumentObject* obj = static_cast<const DocumentObject*>(container);
+            if (obj->getDocument() != doc || !obj->getNameInDocument() || !prop->getName())
+                continue;
+            PersistedFile& file = persistedFiles[prop];
+            file.file = it->second;
+            file.object = obj->getNameInDocument();
+            file.property = prop->getName();
+        }
+    }
+    void removeExpressionNames(const DocumentObject* obj) {
+        std::map<const DocumentObject*, std::set<std::string> >::iterator it = expressionNames.find(obj);
+        if (it == expressionNames.end())
+            return;
+        for (std::set<std::string>::const_iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
+            std::map<std::string, std::set<DocumentObject*> >::iterator kt = expressionObjects.find(*jt);
+            if (kt != expressionObjects.end()) {
+                kt->second.erase(const_cast<DocumentObject*>(obj));
+                if (kt->second.empty())
+                    expressionObjects.erase(kt);
+            }
+        }
+        expressionNames.erase(it);
+    }
+    void addExpressionNames(DocumentObject* obj) {
+        removeExpressionNames(obj);
+        if (obj->ExpressionEngine.numExpressions() == 0)
+            return;
+        // every component of an identifier may be the name or label of an object
+        std::set<std::string> names;
+        typedef boost::unordered_map<const ObjectIdentifier, const PropertyExpressionEngine::ExpressionInfo> ExpressionMap;
+        ExpressionMap exprs = obj->ExpressionEngine.getExpressions();
+        for (ExpressionMap::const_iterator it = exprs.begin(); it != exprs.end(); ++it) {
+            std::set<ObjectIdentifier> deps;
+            it->second.expression->getDeps(deps);
+            for (std::set<ObjectIdentifier>::const_iterator jt = deps.begin(); jt != deps.end(); ++jt) {
+                std::vector<std::string> path = jt->getStringList();
+                names.insert(path.begin(), path.end());
+            }
+        }
+        for (std::set<std::string>::const_iterator jt = names.begin(); jt != names.end(); ++jt)
+            expressionObjects[*jt].insert(obj);
+        expressionNames[obj].swap(names);
+    }
+    void getExpressionObjects(const std::string& name, std::set<DocumentObject*>& objs) const {
+        if (name.empty())
+            return;
+        std::map<std::string, std::set<DocumentObject*> >::const_iterator it = expressionObjects.find(name);
+        if (it != expressionObjects.end())
+            objs.insert(it->second.begin(), it->second.end());
+        // labels with special characters are quoted in expressions
+        it = expressionObjects.find(App::quote(name));
+        if (it != expressionObjects.end())
+            objs.insert(it->second.begin(), it->second.end());
+    }
+    void removePersistedFiles(const DocumentObject* obj) {
+        if (persistedFiles.empty())
+            return;
+        std::vector<Property*> props;
+        obj->getPropertyList(props);
+        for (std::vector<Property*>::iterator it = props.begin(); it != props.end(); ++it)
+            persistedFiles.erase(*it);
+    }
+    void removePersistedGeoData(const DocumentObject* obj) {
+        if (persistedFiles.empty())
+            return;
+        std::vector<Property*> props;
+        obj->getPropertyList(props);
+        for (std::vector<Property*>::iterator it = props.begin(); it != props.end(); ++it) {
+            if ((*it)->getTypeId().isDerivedFrom(PropertyComplexGeoData::getClassTypeId()))
+                persistedFiles.erase(*it);
+        }
+    }
+    std::map<const Base::Persistence*, std::string> getReusableFiles(const Document* doc, int version) const {
+        std::map<const Base::Persistence*, std::string> files;
+        if (persistedFiles.empty() || version != persistedVersion)
+            return files;
+        // the project file must not have been replaced in the meantime
+        Base::FileInfo fi(persistedArchive);
+        if (!fi.exists() || fi.size() != persistedSize || !(fi.lastModified() == persistedTime))
+            return files;
+        // a removed object or property must not be mistaken for a new one at the same address
+        std::map<const Property*, PersistedFile>::const_iterator it;
+        for (it = persistedFiles.begin(); it != persistedFiles.end(); ++it) {
+            DocumentObject* obj = doc->getObject(it->second.object.c_str());
+            if (obj && obj->getPropertyByName(it->second.property.c_str()) == it->first)
+                files[it->first] = it->second.file;
+        }
+        return files;
+    }
+    void removeObjectName(const std::string& name) {
+        std::string::size_type index = suffixPosition(name);
+        if (index < name.size()) {
+            std::map<std::string, std::set<std::string, SuffixCompare> >::iterator it;
+            it = nameSuffixes.find(name.substr(0, index));
+            if (it != nameSuffixes.end()) {
+                it->second.erase(name.substr(index));
+                if (it->second.empty())
+                    nameSuffixes.erase(it);
+            }
+        }
     }
 };
 
@@ -827,10 +1007,43 @@ void Document::onBeforeChangeProperty(const DocumentObject *Who, const Property
         d->activeUndoTransaction->addObjectChange(Who,What);
 }
 
+void Document::onRemoveProperty(const DocumentObject *Who, const Property *What)
+{
+    // the property may be deleted and its address reused by a new one
+    d->persistedFiles.erase(What);
+}
+
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    // the file of the property in the project file is outdated now
+    d->persistedFiles.erase(What);
+    // a new placement is applied to the geometric data in place with setTransform(),
+    // which doesn't notify about a change, so their files are outdated as well
+    if (Who->getTypeId().isDerivedFrom(GeoFeature::getClassTypeId()) &&
+        What == &static_cast<const GeoFeature*>(Who)->Placement)
+        d->removePersistedGeoData(Who);
     if (d->activeTransaction && !d->rollback)
         d->activeTransaction->addObjectChange(Who,What);
+    Base::Type type = What->getTypeId();
+    if (type.isDerivedFrom(PropertyLink::getClassTypeId()) ||
+        type.isDerivedFrom(PropertyLinkSub::getClassTypeId()) ||
+        type.isDerivedFrom(PropertyLinkList::getClassTypeId()) ||
+        type.isDerivedFrom(PropertyLinkSubList::getClassTypeId())) {
+        _updateLinkIndex(const_cast<DocumentObject*>(Who));
+    }
+    else if (What == &Who->ExpressionEngine) {
+        DocumentObject* obj = const_cast<DocumentObject*>(Who);
+        if (d->outLists.find(obj) != d->outLists.end())
+            d->addExpressionNames(obj);
+        _updateLinkIndex(obj);
+    }
+    else if (What == &Who->Label) {
+        // expressions may have referred to the old label or now refer to the new one
+        std::set<std::string> names;
+        names.insert(Who->getOldLabel());
+        names.insert(Who->Label.getValue());
+        _updateExpressionLinks(names);
+    }
     signalChangedObject(*Who, *What);
 }
 
@@ -1246,6 +1459,10 @@ Document::readObjects(Base::XMLReader& reader)
     }
     reader.readEndElement("ObjectData");
 
+    // expressions may refer to objects that were restored later on
+    for (std::vector<App::DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it)
+        _updateLinkIndex(*it);
+
     return objs;
 }
 
@@ -1318,7 +1535,19 @@ bool Document::saveCopy(const char* file)
         this->FileName.setValue(file);
         this->Label.setValue(fi.fileNamePure());
         this->Uid.touch(); // this forces a rename of the transient directory
-        bool result = save();
+        d->savingCopy = true;
+        bool result = false;
+        try {
+            result = save();
+        }
+        catch (...) {
+            d->savingCopy = false;
+            this->FileName.setValue(originalFileName);
+            this->Label.setValue(originalLabel);
+            this->Uid.touch();
+            throw;
+        }
+        d->savingCopy = false;
         this->FileName.setValue(originalFileName);
         this->Label.setValue(originalLabel);
         this->Uid.touch();
@@ -1330,6 +1559,7 @@ bool Document::saveCopy(const char* file)
 // Save the document under the name it has been opened
 bool Document::save (void)
 {
+    FC_PROFILE_SCOPE("save", getName());
     int compression = App::GetApplication().GetParameterGroupByPath
         ("User parameter:BaseApp/Preferences/Document")->GetInt("CompressionLevel",3);
     compression = Base::clamp<int>(compression, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
@@ -1353,6 +1583,12 @@ bool Document::save (void)
         fn += "."; fn += uuid;
         Base::FileInfo tmp(fn);
 
+        // the files of unchanged properties are copied from the last saved or restored project file
+        bool reuseFiles = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Document")->GetBool("ReuseUnchangedFiles",true);
+        std::map<const Base::Persistence*, std::string> writtenFiles;
+        int fileVersion = 0;
+
         // open extra scope to close ZipWriter properly
         {
             Base::ofstream file(tmp, std::ios::out | std::ios::binary);
@@ -1360,6 +1596,8 @@ bool Document::save (void)
 
             writer.setComment("FreeCAD Document");
             writer.setLevel(compression);
+            if (reuseFiles)
+                writer.setReusableFiles(d->persistedArchive, d->getReusableFiles(this, writer.getFileVersion()));
             writer.putNextEntry("Document.xml");
 
             Document::Save(writer);
@@ -1374,6 +1612,8 @@ bool Document::save (void)
                 throw Base::FileException("Failed to write all data to file", tmp);
             }
 
+            writtenFiles = writer.getObjectFiles();
+            fileVersion = writer.getFileVersion();
             GetApplication().signalSaveDocument(*this);
         }
 
@@ -1433,6 +1673,8 @@ bool Document::save (void)
         if (tmp.renameFile(FileName.getValue()) == false)
             Base::Console().Warning("Cannot rename file from '%s' to '%s'\n",
             fn.c_str(), FileName.getValue());
+        else if (!d->savingCopy)
+            d->setPersistedFiles(this, FileName.getValue(), fileVersion, writtenFiles);
 
         return true;
     }
@@ -1443,6 +1685,7 @@ bool Document::save (void)
 // Open the document
 void Document::restore (void)
 {
+    FC_PROFILE_SCOPE("restore", FileName.getValue());
     // clean up if the document is not empty
     // !TODO mind exeptions while restoring!
     clearUndos();
@@ -1452,6 +1695,13 @@ void Document::restore (void)
     }
     d->objectArray.clear();
     d->objectMap.clear();
+    d->nameSuffixes.clear();
+    d->bulkObjects.clear();
+    d->bulkCreation = 0;
+    d->outLists.clear();
+    d->inLists.clear();
+    d->expressionObjects.clear();
+    d->expressionNames.clear();
     d->activeObject = 0;
 
     Base::FileInfo fi(FileName.getValue());
@@ -1483,6 +1733,11 @@ void Document::restore (void)
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
     reader.readFiles(zipstream);
+
+    // files of older schemas are always written anew
+    d->persistedFiles.clear();
+    if (reader.DocumentSchema == 4)
+        d->setPersistedFiles(this, FileName.getValue(), reader.FileVersion, reader.getObjectFiles());
     
     // reset all touched
     for (std::map<std::string,DocumentObject*>::iterator It= d->objectMap.begin();It!=d->objectMap.end();++It) {
@@ -1559,22 +1814,148 @@ int Document::countObjects(void) const
    return static_cast<int>(d->objectArray.size());
 }
 
-std::vector<App::DocumentObject*> Document::getInList(const DocumentObject* me) const
+void Document::beginBulkCreation()
 {
-    // result list
-    std::vector<App::DocumentObject*> result;
-    // go through all objects
-    for (std::map<std::string,DocumentObject*>::const_iterator It = d->objectMap.begin(); It != d->objectMap.end();++It) {
-        // get the outList and search if me is in that list
-        std::vector<DocumentObject*> OutList = It->second->getOutList();
-        for (std::vector<DocumentObject*>::const_iterator It2=OutList.begin();It2!=OutList.end();++It2)
-            if (*It2 && *It2 == me)
-                // add the parent object
-                result.push_back(It->second);
+    d->bulkCreation++;
+}
+
+void Document::endBulkCreation()
+{
+    if (d->bulkCreation == 0 || --d->bulkCreation > 0)
+        return;
+
+    std::vector<DocumentObject*> objects;
+    objects.swap(d->bulkObjects);
+    if (objects.empty())
+        return;
+
+    // listeners that can handle all new objects at once do it here and skip
+    // the objects they already know in the following signals
+    signalNewObjects(objects);
+    for (std::vector<DocumentObject*>::iterator it = objects.begin(); it != objects.end(); ++it)
+        signalNewObject(*(*it));
+    if (d->activeObject)
+        signalActivatedObject(*d->activeObject);
+}
+
+bool Document::isBulkCreation() const
+{
+    return d->bulkCreation > 0;
+}
+
+namespace App {
+struct ObjectNameLess {
+    bool operator () (const DocumentObject* a, const DocumentObject* b) const {
+        return strcmp(a->getNameInDocument(), b->getNameInDocument()) < 0;
     }
+};
+}
+
+std::vector<App::DocumentObject*> Document::getInList(const DocumentObject* me) const
+{
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::const_iterator it = d->inLists.find(me);
+    if (it == d->inLists.end())
+        return std::vector<App::DocumentObject*>();
+
+    // keep the order of the object names as before the index was introduced
+    std::vector<App::DocumentObject*> result = it->second;
+    std::stable_sort(result.begin(), result.end(), ObjectNameLess());
     return result;
 }
 
+void Document::_addToLinkIndex(DocumentObject* pcObject)
+{
+    d->outLists[pcObject];
+    d->addExpressionNames(pcObject);
+    _updateLinkIndex(pcObject);
+    // expressions of other objects may refer to this object by its name or label
+    std::set<std::string> names;
+    names.insert(pcObject->getNameInDocument());
+    names.insert(pcObject->Label.getValue());
+    _updateExpressionLinks(names);
+}
+
+void Document::_remFromLinkIndex(DocumentObject* pcObject)
+{
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator it = d->outLists.find(pcObject);
+    if (it == d->outLists.end())
+        return;
+
+    for (std::vector<DocumentObject*>::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
+        std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator kt = d->inLists.find(*jt);
+        if (kt != d->inLists.end()) {
+            std::vector<DocumentObject*>::iterator pos = std::find(kt->second.begin(), kt->second.end(), pcObject);
+            if (pos != kt->second.end())
+                kt->second.erase(pos);
+            if (kt->second.empty())
+                d->inLists.erase(kt);
+        }
+    }
+
+    d->outLists.erase(it);
+
+    // the objects still linking to pcObject must not keep a dangling pointer in their out list
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator in = d->inLists.find(pcObject);
+    if (in != d->inLists.end()) {
+        for (std::vector<DocumentObject*>::iterator jt = in->second.begin(); jt != in->second.end(); ++jt) {
+            std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator kt = d->outLists.find(*jt);
+            if (kt != d->outLists.end())
+                kt->second.erase(std::remove(kt->second.begin(), kt->second.end(), pcObject), kt->second.end());
+        }
+        d->inLists.erase(in);
+    }
+    d->removeExpressionNames(pcObject);
+}
+
+void Document::_updateLinkIndex(DocumentObject* pcObject)
+{
+    // only objects that are part of the document are tracked
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator it = d->outLists.find(pcObject);
+    if (it == d->outLists.end())
+        return;
+
+    std::vector<DocumentObject*> outList = pcObject->getOutList();
+    outList.erase(std::remove(outList.begin(), outList.end(), static_cast<DocumentObject*>(0)), outList.end());
+    if (outList == it->second)
+        return;
+
+    for (std::vector<DocumentObject*>::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
+        std::map<const DocumentObject*, std::vector<DocumentObject*> >::iterator kt = d->inLists.find(*jt);
+        if (kt != d->inLists.end()) {
+            std::vector<DocumentObject*>::iterator pos = std::find(kt->second.begin(), kt->second.end(), pcObject);
+            if (pos != kt->second.end())
+                kt->second.erase(pos);
+            if (kt->second.empty())
+                d->inLists.erase(kt);
+        }
+    }
+
+    for (std::vector<DocumentObject*>::iterator jt = outList.begin(); jt != outList.end(); ++jt)
+        d->inLists[*jt].push_back(pcObject);
+
+    it->second.swap(outList);
+}
+
+void Document::_changedObjectStatus(const DocumentObject* pcObject)
+{
+    signalChangedObjectStatus(*pcObject);
+    // the linking objects may test the touched state of pcObject in mustExecute()
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::const_iterator it = d->inLists.find(pcObject);
+    if (it != d->inLists.end()) {
+        for (std::vector<DocumentObject*>::const_iterator jt = it->second.begin(); jt != it->second.end(); ++jt)
+            signalChangedObjectStatus(**jt);
+    }
+}
+
+void Document::_updateExpressionLinks(const std::set<std::string>& names)
+{
+    std::set<DocumentObject*> objs;
+    for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+        d->getExpressionObjects(*it, objs);
+    for (std::set<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it)
+        _updateLinkIndex(*it);
+}
+
 namespace boost {
 // recursive helper function to get all dependencies
 void out_edges_recursive(const Vertex& v, const DependencyList& g, std::set<Vertex>& out)
@@ -1716,6 +2097,8 @@ void Document::_rebuildDependencyList(void)
 
 void Document::recompute()
 {
+    FC_PROFILE_SCOPE("recompute", getName());
+
     // delete recompute log
     for( std::vector<App::DocumentObjectExecReturn*>::iterator it=_RecomputeLog.begin();it!=_RecomputeLog.end();++it)
         delete *it;
@@ -1792,6 +2175,8 @@ void Document::recompute()
 #endif
     }
 
+    FC_PROFILE_COUNT("Recomputed objects", (long)recomputeList.size());
+
 #ifdef FC_LOGFEATUREUPDATE
     std::clog << "Have to recompute the following document objects" << std::endl;
     for (std::set<DocumentObject*>::const_iterator it = recomputeList.begin(); it != recomputeList.end(); ++it) {
@@ -1804,7 +2189,9 @@ void Document::recompute()
 
         if (recomputeList.find(Cur) != recomputeList.end() ||
                 Cur->ExpressionEngine.depsAreTouched()) {
-            if ( _recomputeFeature(Cur)) {
+            bool abort = _recomputeFeature(Cur);
+            signalChangedObjectStatus(*Cur);
+            if (abort) {
                 // if somthing happen break execution of recompute
                 d->vertexMap.clear();
                 return;
@@ -1839,7 +2226,10 @@ bool Document::_recomputeFeature(DocumentObject* Feat)
 
     DocumentObjectExecReturn  *returnCode = 0;
     try {
-        returnCode = Feat->ExpressionEngine.execute();
+        {
+            FC_PROFILE_SCOPE("expression", Feat->getNameInDocument());
+            returnCode = Feat->ExpressionEngine.execute();
+        }
         if (returnCode != DocumentObject::StdReturn) {
             returnCode->Which = Feat;
             _RecomputeLog.push_back(returnCode);
@@ -1850,6 +2240,7 @@ bool Document::_recomputeFeature(DocumentObject* Feat)
             return true;
         }
 
+        FC_PROFILE_SCOPE("execute", Feat->getNameInDocument());
         returnCode = Feat->recompute();
     }
     catch(Base::AbortException &e){
@@ -1908,6 +2299,7 @@ void Document::recomputeFeature(DocumentObject* Feat)
     _RecomputeLog.clear();
 
     _recomputeFeature(Feat);
+    signalChangedObjectStatus(*Feat);
 }
 
 DocumentObject * Document::addObject(const char* sType, const char* pObjectName)
@@ -1948,19 +2340,26 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName)
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    d->addObjectName(ObjectName);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
     // insert in the adjacence list and referenc through the ConectionMap
     //_DepConMap[pcObject] = add_vertex(_DepList);
+    _addToLinkIndex(pcObject);
 
     pcObject->Label.setValue( ObjectName );
 
     // mark the object as new (i.e. set status bit 2) and send the signal
     pcObject->StatusBits.set(2);
-    signalNewObject(*pcObject);
-    signalActivatedObject(*pcObject);
+    if (d->bulkCreation > 0) {
+        d->bulkObjects.push_back(pcObject);
+    }
+    else {
+        signalNewObject(*pcObject);
+        signalActivatedObject(*pcObject);
+    }
 
     // return the Object
     return pcObject;
@@ -1970,9 +2369,11 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
 {
     std::string ObjectName = getUniqueObjectName(pObjectName);
     d->objectMap[ObjectName] = pcObject;
+    d->addObjectName(ObjectName);
     d->objectArray.push_back(pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    _addToLinkIndex(pcObject);
 
     // do no transactions if we do a rollback!
     if(!d->rollback){
@@ -1984,10 +2385,16 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
             d->activeUndoTransaction->addObjectDel(pcObject);
     }
     // send the signal
-    signalNewObject(*pcObject);
+    if (d->bulkCreation > 0) {
+        d->bulkObjects.push_back(pcObject);
+        d->activeObject = pcObject;
+    }
+    else {
+        signalNewObject(*pcObject);
 
-    d->activeObject = pcObject;
-    signalActivatedObject(*pcObject);
+        d->activeObject = pcObject;
+        signalActivatedObject(*pcObject);
+    }
 }
 
 /// Remove an object out of the document
@@ -2004,7 +2411,9 @@ void Document::remObject(const char* sName)
     if (d->activeObject == pos->second)
         d->activeObject = 0;
 
-    signalDeletedObject(*(pos->second));
+    // an object of a running bulk creation has not been announced yet
+    if (!d->removeBulkObject(pos->second))
+        signalDeletedObject(*(pos->second));
     if (!d->vertexMap.empty()) {
         // recompute of document is running
         for (std::map<Vertex,DocumentObject*>::iterator it = d->vertexMap.begin(); it != d->vertexMap.end(); ++it) {
@@ -2017,6 +2426,11 @@ void Document::remObject(const char* sName)
 
     // Before deleting we must nullify all dependant objects
     breakDependency(pos->second, true);
+    std::set<std::string> names;
+    names.insert(pos->first);
+    names.insert(pos->second->Label.getValue());
+    _remFromLinkIndex(pos->second);
+    d->removePersistedFiles(pos->second);
 
     // do no transactions if we do a rollback!
     if(!d->rollback){
@@ -2046,7 +2460,10 @@ void Document::remObject(const char* sName)
     // remove from adjancy list
     //remove_vertex(_DepConMap[pos->second],_DepList);
     //_DepConMap.erase(pos->second);
+    d->removeObjectName(pos->first);
     d->objectMap.erase(pos);
+    // expressions of other objects may have referred to the removed object
+    _updateExpressionLinks(names);
 }
 
 /// Remove an object out of the document (internal)
@@ -2059,7 +2476,8 @@ void Document::_remObject(DocumentObject* pcObject)
     if (d->activeObject == pcObject)
         d->activeObject = 0;
 
-    signalDeletedObject(*pcObject);
+    if (!d->removeBulkObject(pcObject))
+        signalDeletedObject(*pcObject);
 
     // do no transactions if we do a rollback!
     if(!d->rollback){
@@ -2071,7 +2489,13 @@ void Document::_remObject(DocumentObject* pcObject)
         if (d->activeUndoTransaction)
             d->activeUndoTransaction->addObjectNew(pcObject);
     }
+    std::set<std::string> names;
+    names.insert(pos->first);
+    names.insert(pcObject->Label.getValue());
+    _remFromLinkIndex(pcObject);
+    d->removePersistedFiles(pcObject);
     // remove from map
+    d->removeObjectName(pos->first);
     d->objectMap.erase(pos);
     //// set name cache false
     //pcObject->pcNameInDocument = 0;
@@ -2082,14 +2506,23 @@ void Document::_remObject(DocumentObject* pcObject)
             break;
         }
     }
+    _updateExpressionLinks(names);
 }
 
 void Document::breakDependency(DocumentObject* pcObject, bool clear)
 {
+    // Only the objects linking to pcObject and pcObject itself can be affected
+    std::set<DocumentObject*> affected;
+    std::map<const DocumentObject*, std::vector<DocumentObject*> >::const_iterator in = d->inLists.find(pcObject);
+    if (in != d->inLists.end())
+        affected.insert(in->second.begin(), in->second.end());
+    if (clear && d->outLists.find(pcObject) != d->outLists.end())
+        affected.insert(pcObject);
+
     // Nullify all dependant objects
-    for (std::map<std::string,DocumentObject*>::iterator it = d->objectMap.begin(); it != d->objectMap.end(); ++it) {
+    for (std::set<DocumentObject*>::iterator it = affected.begin(); it != affected.end(); ++it) {
         std::map<std::string,App::Property*> Map;
-        it->second->getPropertyMap(Map);
+        (*it)->getPropertyMap(Map);
         // search for all properties that could have a link to the object
         for (std::map<std::string,App::Property*>::iterator pt = Map.begin(); pt != Map.end(); ++pt) {
             if (pt->second->getTypeId().isDerivedFrom(PropertyLink::getClassTypeId())) {
@@ -2277,11 +2710,36 @@ std::string Document::getUniqueObjectName(const char *Name) const
             }
         }
 
-        std::vector<std::string> names;
-        names.reserve(d->objectMap.size());
-        for (pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
-            names.push_back(pos->first);
+        // Only names which start with CleanName followed by digits only are
+        // relevant. They all have the same base name without trailing digits, so
+        // the highest suffix can be looked up in the suffix index instead of
+        // checking all object names.
+        std::string::size_type index = DocumentP::suffixPosition(CleanName);
+        std::string digits = CleanName.substr(index);
+        std::string num_suffix;
+        std::map<std::string, std::set<std::string, SuffixCompare> >::const_iterator it;
+        it = d->nameSuffixes.find(CleanName.substr(0, index));
+        if (it != d->nameSuffixes.end() && !it->second.empty()) {
+            // the suffixes are sorted by length and value, so for each length the
+            // highest suffix starting with the trailing digits of CleanName is the
+            // one right before the upper bound of these digits filled up with nines
+            const std::set<std::string, SuffixCompare>& suffixes = it->second;
+            for (std::size_t len = suffixes.rbegin()->size(); len > digits.size(); --len) {
+                std::string upper = digits + std::string(len - digits.size(), '9');
+                std::set<std::string, SuffixCompare>::const_iterator jt = suffixes.upper_bound(upper);
+                if (jt == suffixes.begin())
+                    break;
+                --jt;
+                if (jt->size() == len && jt->compare(0, digits.size(), digits) == 0) {
+                    num_suffix = jt->substr(digits.size());
+                    break;
+                }
+            }
         }
+
+        std::vector<std::string> names;
+        if (!num_suffix.empty())
+            names.push_back(CleanName + num_suffix);
         return Base::Tools::getUniqueName(CleanName, names, 3);
     }
 }
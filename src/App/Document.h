@@ -101,6 +101,11 @@ public:
     //@{
     /// signal on new Object
     boost::signal<void (const App::DocumentObject&)> signalNewObject;
+    /** signal on the objects created during a bulk creation
+     * It is given once at the end of the bulk creation and before the
+     * signalNewObject of each of the objects.
+     */
+    boost::signal<void (const std::vector<App::DocumentObject*>&)> signalNewObjects;
     //boost::signal<void (const App::DocumentObject&)>     m_sig;
     /// signal on deleted Object
     boost::signal<void (const App::DocumentObject&)> signalDeletedObject;
@@ -110,6 +115,8 @@ public:
     boost::signal<void (const App::DocumentObject&)> signalRelabelObject;
     /// signal on activated Object
     boost::signal<void (const App::DocumentObject&)> signalActivatedObject;
+    /// signal on changed status (touched, error) of an Object
+    boost::signal<void (const App::DocumentObject&)> signalChangedObjectStatus;
     /// signal on undo
     boost::signal<void (const App::Document&)> signalUndo;
     /// signal on redo
@@ -197,6 +204,18 @@ public:
     int countObjectsOfType(const Base::Type& typeId) const;
     /// get the number of objects in the document
     int countObjects(void) const;
+    /** Starts the creation of many objects at once.
+     * Until the matching endBulkCreation() the new objects are not announced
+     * one by one. Calls can be nested.
+     */
+    void beginBulkCreation();
+    /** Ends the creation of many objects.
+     * If it is the outermost call signalNewObjects is given for all objects
+     * created in the meantime, followed by signalNewObject for each of them.
+     */
+    void endBulkCreation();
+    /// checks whether objects are currently created in bulk
+    bool isBulkCreation() const;
     //@}
 
     /** @name methods for modification and state handling
@@ -310,11 +329,25 @@ protected:
     void onBeforeChangeProperty(const DocumentObject *Who, const Property *What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject *Who, const Property *What);
+    /// callback from the Document objects before a dynamic property is removed
+    void onRemoveProperty(const DocumentObject *Who, const Property *What);
     /// helper which Recompute only this feature
     bool _recomputeFeature(DocumentObject* Feat);
     void _clearRedos();
     /// refresh the internal dependency graph
     void _rebuildDependencyList(void);
+    /** @name Link index
+     * The document keeps the out list of every object and the reverse links
+     * so that getInList() doesn't need to scan the whole document.
+     */
+    //@{
+    void _addToLinkIndex(DocumentObject* pcObject);
+    void _remFromLinkIndex(DocumentObject* pcObject);
+    void _updateLinkIndex(DocumentObject* pcObject);
+    void _updateExpressionLinks(const std::set<std::string>& names);
+    //@}
+    /// signals the changed status of an object and of the objects whose mustExecute() tests it
+    void _changedObjectStatus(const DocumentObject* pcObject);
     std::string getTransientDirectoryName(const std::string& uuid, const std::string& filename) const;
 
 
@@ -177,6 +177,18 @@ void DocumentObject::onLostLinkToObject(DocumentObject*)
 
 }
 
+void DocumentObject::updateLinks()
+{
+    if (_pDoc)
+        _pDoc->_updateLinkIndex(this);
+}
+
+void DocumentObject::onRemoveProperty(const Property* prop)
+{
+    if (_pDoc)
+        _pDoc->onRemoveProperty(this, prop);
+}
+
 App::Document *DocumentObject::getDocument(void) const
 {
     return _pDoc;
@@ -212,7 +224,7 @@ void DocumentObject::onChanged(const Property* prop)
     if (prop->getType() & Prop_Output)
         return;
     // set object touched
-    StatusBits.set(0);
+    touch();
 }
 
 PyObject *DocumentObject::getPyObject(void)
@@ -232,7 +244,40 @@ std::vector<PyObject *> DocumentObject::getPySubObjects(const std::vector<std::s
 
 void DocumentObject::touch(void)
 {
+    bool touched = StatusBits.test(0);
     StatusBits.set(0);
+    if (!touched && _pDoc)
+        _pDoc->_changedObjectStatus(this);
+}
+
+void DocumentObject::purgeTouched(void)
+{
+    bool touched = isTouched();
+    StatusBits.reset(0);
+    setPropertyStatus(0,false);
+    if (touched && _pDoc)
+        _pDoc->_changedObjectStatus(this);
+}
+
+void DocumentObject::purgeError(void)
+{
+    resetError();
+}
+
+void DocumentObject::setError(void)
+{
+    bool error = StatusBits.test(1);
+    StatusBits.set(1);
+    if (!error && _pDoc)
+        _pDoc->_changedObjectStatus(this);
+}
+
+void DocumentObject::resetError(void)
+{
+    bool error = StatusBits.test(1);
+    StatusBits.reset(1);
+    if (error && _pDoc)
+        _pDoc->_changedObjectStatus(this);
 }
 
 /**
@@ -29,6 +29,8 @@
 
 #include "Document.h"
 #include <Base/FileInfo.h>
+#include <Base/Profiler.h>
+#include <Base/Stream.h>
 #include "DocumentObject.h"
 #include "DocumentObjectPy.h"
 #include "MergeDocuments.h"
@@ -343,6 +345,24 @@ PyObject*  DocumentPy::commitTransaction(PyObject * args)
     Py_Return;
 }
 
+PyObject*  DocumentPy::beginBulkCreation(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
+        return NULL;                    // NULL triggers exception 
+    getDocumentPtr()->beginBulkCreation();
+    Py_Return;
+}
+
+PyObject*  DocumentPy::endBulkCreation(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
+        return NULL;                    // NULL triggers exception 
+    PY_TRY {
+        getDocumentPtr()->endBulkCreation();
+        Py_Return;
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::undo(PyObject * args)
 {
     if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
@@ -377,6 +397,52 @@ PyObject*  DocumentPy::recompute(PyObject * args)
     Py_Return;
 }
 
+PyObject*  DocumentPy::recomputeProfile(PyObject * args)
+{
+    char* traceFile=0;
+    PyObject* all=Py_False;
+    if (!PyArg_ParseTuple(args, "|etO!", "utf-8", &traceFile, &PyBool_Type, &all))
+        return NULL;
+    std::string fileName;
+    if (traceFile) {
+        fileName = traceFile;
+        PyMem_Free(traceFile);
+    }
+
+    PY_TRY {
+        if (PyObject_IsTrue(all)) {
+            std::vector<DocumentObject*> objs = getDocumentPtr()->getObjects();
+            for (std::vector<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it)
+                (*it)->touch();
+        }
+
+        Base::Profiler& profiler = Base::Profiler::instance();
+        bool enabled = Base::Profiler::isEnabled();
+        profiler.clear();
+        profiler.setEnabled(true);
+        try {
+            getDocumentPtr()->recompute();
+        }
+        catch (...) {
+            profiler.setEnabled(enabled);
+            throw;
+        }
+        profiler.setEnabled(enabled);
+
+        if (!fileName.empty()) {
+            Base::FileInfo fi(fileName);
+            Base::ofstream str(fi, std::ios::out | std::ios::binary);
+            if (!str)
+                throw Base::FileException("Cannot open file", fi);
+            profiler.writeChromeTrace(str);
+        }
+
+        std::stringstream summary;
+        profiler.writeSummary(summary);
+        return Py::new_reference_to(Py::String(summary.str()));
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::getObject(PyObject *args)
 {
     char *sName;
@@ -63,6 +63,16 @@ void DynamicProperty::getPropertyMap(std::map<std::string,Property*> &Map) const
         Map[it->first] = it->second.property;
 }
 
+std::map<std::string,DynamicProperty::PropData>::const_iterator
+DynamicProperty::findProperty(const Property* prop) const
+{
+    boost::unordered_map<const Property*, std::map<std::string,PropData>::const_iterator>::const_iterator
+        it = propIndex.find(prop);
+    if (it != propIndex.end())
+        return it->second;
+    return props.end();
+}
+
 Property *DynamicProperty::getPropertyByName(const char* name) const
 {
     std::map<std::string,PropData>::const_iterator it = props.find(name);
@@ -108,10 +118,9 @@ void DynamicProperty::addDynamicProperties(const PropertyContainer* cont)
 
 const char* DynamicProperty::getPropertyName(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->first.c_str();
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->first.c_str();
     return this->pc->PropertyContainer::getPropertyName(prop);
 }
 
@@ -128,10 +137,9 @@ unsigned int DynamicProperty::getMemSize (void) const
 
 short DynamicProperty::getPropertyType(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.attr;
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->second.attr;
     return this->pc->PropertyContainer::getPropertyType(prop);
 }
 
@@ -145,10 +153,9 @@ short DynamicProperty::getPropertyType(const char *name) const
 
 const char* DynamicProperty::getPropertyGroup(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.group.c_str();
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->second.group.c_str();
     return this->pc->PropertyContainer::getPropertyGroup(prop);
 }
 
@@ -162,10 +169,9 @@ const char* DynamicProperty::getPropertyGroup(const char *name) const
 
 const char* DynamicProperty::getPropertyDocumentation(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.doc.c_str();
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->second.doc.c_str();
     return this->pc->PropertyContainer::getPropertyDocumentation(prop);
 }
 
@@ -179,10 +185,9 @@ const char* DynamicProperty::getPropertyDocumentation(const char *name) const
 
 bool DynamicProperty::isReadOnly(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.readonly;
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->second.readonly;
     return this->pc->PropertyContainer::isReadOnly(prop);
 }
 
@@ -196,10 +201,9 @@ bool DynamicProperty::isReadOnly(const char *name) const
 
 bool DynamicProperty::isHidden(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.hidden;
-    }
+    std::map<std::string,PropData>::const_iterator it = findProperty(prop);
+    if (it != props.end())
+        return it->second.hidden;
     return this->pc->PropertyContainer::isHidden(prop);
 }
 
@@ -240,7 +244,9 @@ Property* DynamicProperty::addDynamicProperty(const char* type, const char* name
     data.attr = attr;
     data.readonly = ro;
     data.hidden = hidden;
-    props[ObjectName] = data;
+    std::pair<std::map<std::string,PropData>::iterator, bool> res =
+        props.insert(std::make_pair(ObjectName, data));
+    propIndex[pcProperty] = res.first;
 
     return pcProperty;
 }
@@ -249,6 +255,7 @@ bool DynamicProperty::removeDynamicProperty(const char* name)
 {
     std::map<std::string,PropData>::iterator it = props.find(name);
     if (it != props.end()) {
+        propIndex.erase(it->second.property);
         delete it->second.property;
         props.erase(it);
         return true;
@@ -262,16 +269,14 @@ std::string DynamicProperty::getUniquePropertyName(const char *Name) const
     std::string CleanName = Base::Tools::getIdentifier(Name);
 
     // name in use?
-    std::map<std::string,Property*> objectProps;
-    getPropertyMap(objectProps);
-    std::map<std::string,Property*>::const_iterator pos;
-    pos = objectProps.find(CleanName);
-
-    if (pos == objectProps.end()) {
+    if (!getPropertyByName(CleanName.c_str())) {
         // if not, name is OK
         return CleanName;
     }
     else {
+        std::map<std::string,Property*> objectProps;
+        getPropertyMap(objectProps);
+        std::map<std::string,Property*>::const_iterator pos;
         std::vector<std::string> names;
         names.reserve(objectProps.size());
         for (pos = objectProps.begin();pos != objectProps.end();++pos) {
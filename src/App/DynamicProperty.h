@@ -28,6 +28,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <boost/unordered_map.hpp>
 
 namespace Base {
 class Writer;
@@ -112,10 +113,14 @@ private:
     /// Encodes an attribute upon saving.
     std::string encodeAttribute(const std::string&) const;
     std::string getUniquePropertyName(const char *Name) const;
+    /// find the entry of a dynamic property or return props.end()
+    std::map<std::string,PropData>::const_iterator findProperty(const Property* prop) const;
 
 private:
     PropertyContainer* pc;
     std::map<std::string,PropData> props;
+    /// reverse lookup of the entries by property
+    boost::unordered_map<const Property*, std::map<std::string,PropData>::const_iterator> propIndex;
 };
 
 } // namespace App
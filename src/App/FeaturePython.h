@@ -109,7 +109,13 @@ public:
         return props->addDynamicProperty(type, name, group, doc, attr, ro, hidden);
     }
     virtual bool removeDynamicProperty(const char* name) {
-        return props->removeDynamicProperty(name);
+        Property* prop = props->getDynamicPropertyByName(name);
+        if (prop)
+            this->onRemoveProperty(prop);
+        bool ok = props->removeDynamicProperty(name);
+        if (ok)
+            this->updateLinks();
+        return ok;
     }
     std::vector<std::string> getDynamicPropertyNames() const {
         return props->getDynamicPropertyNames();
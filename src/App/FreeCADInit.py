@@ -148,6 +148,21 @@ FreeCAD.addImportType("FreeCAD document (*.FCStd)","FreeCAD")
 # set to no gui, is overwritten by InitGui
 App.GuiUp = 0
 
+# announces the objects created in the block at once, even if an exception is raised:
+#   with FreeCAD.BulkCreation(doc):
+#       doc.addObject("App::FeatureTest","Test")
+class BulkCreation(object):
+	def __init__(self, doc):
+		self.doc = doc
+	def __enter__(self):
+		self.doc.beginBulkCreation()
+		return self.doc
+	def __exit__(self, type, value, traceback):
+		self.doc.endBulkCreation()
+		return False
+
+App.BulkCreation = BulkCreation
+
 # fill up unit definitions
 
 App.Units.NanoMetre     = App.Units.Quantity('nm')
@@ -248,6 +263,7 @@ App.Units.Power         = App.Units.Unit(2,1,-3)
 # clean up namespace
 del(InitApplications)
 del(test_ascii)
+del(BulkCreation)
 
 Log ('Init: App::FreeCADInit.py done\n')
 
@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <cassert>
 # include <algorithm>
+# include <climits>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -33,6 +34,7 @@
 #include <Base/Writer.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/Profiler.h>
 
 #include "Property.h"
 #include "PropertyContainer.h"
@@ -194,6 +196,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
                 // We must make sure to handle all exceptions accordingly so that
                 // the project file doesn't get invalidated. In the error case this
                 // means to proceed instead of aborting the write operation.
+                FC_PROFILE_SCOPE("save", it->second->getTypeId().getName());
                 it->second->Save(writer);
             }
             catch (const Base::Exception &e) {
@@ -234,8 +237,10 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
         // not its name. In this case we would force to read-in a wrong property
         // type and the behaviour would be undefined.
         try {
-            if (prop && strcmp(prop->getTypeId().getName(), TypeName) == 0)
+            if (prop && strcmp(prop->getTypeId().getName(), TypeName) == 0) {
+                FC_PROFILE_SCOPE("restore", TypeName);
                 prop->Restore(reader);
+            }
         }
         catch (const Base::XMLParseException&) {
             throw; // re-throw
@@ -260,12 +265,26 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
     reader.readEndElement("Properties");
 }
 
+std::size_t PropertyData::NameHash::operator()(const char* name) const
+{
+  // FNV-1a
+  std::size_t hash = 2166136261u;
+  for (; *name; ++name) {
+    hash ^= (unsigned char)*name;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool PropertyData::NameEqual::operator()(const char* name1, const char* name2) const
+{
+  return strcmp(name1,name2)==0;
+}
+
 void PropertyData::addProperty(const PropertyContainer *container,const char* PropName, Property *Prop, const char* PropertyGroup , PropertyType Type, const char* PropertyDocu)
 {
-  bool IsIn = false;
-  for (vector<PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(strcmp(It->Name,PropName)==0)
-      IsIn = true;
+  // The properties get registered by every instance, so only the first one adds them
+  bool IsIn = nameIndex.find(PropName) != nameIndex.end();
 
   if( !IsIn )
   {
@@ -275,30 +294,35 @@ void PropertyData::addProperty(const PropertyContainer *container,const char* Pr
     temp.Group  = PropertyGroup;
     temp.Type   = Type;
     temp.Docu   = PropertyDocu;
+    nameIndex.insert(std::make_pair(temp.Name, propertyData.size()));
+    offsetIndex.insert(std::make_pair(temp.Offset, propertyData.size()));
     propertyData.push_back(temp);
   }
 }
 
 const PropertyData::PropertySpec *PropertyData::findProperty(const PropertyContainer *container,const char* PropName) const
 {
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(strcmp(It->Name,PropName)==0)
-      return &(*It);
+  // the own properties hide the properties of the parent classes
+  NameIndex::const_iterator It = nameIndex.find(PropName);
+  if (It != nameIndex.end())
+    return &propertyData[It->second];
 
   if(parentPropertyData)
       return parentPropertyData->findProperty(container,PropName);
- 
+
   return 0;
 }
 
 const PropertyData::PropertySpec *PropertyData::findProperty(const PropertyContainer *container,const Property* prop) const
 {
   const int diff = (int) ((char*)prop - (char*)container);
+  if (diff < SHRT_MIN || diff > SHRT_MAX)
+    return 0;
+
+  OffsetIndex::const_iterator It = offsetIndex.find((short)diff);
+  if (It != offsetIndex.end())
+    return &propertyData[It->second];
 
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(diff == It->Offset)
-      return &(*It);
-  
   if(parentPropertyData)
       return parentPropertyData->findProperty(container,prop);
 
@@ -25,6 +25,7 @@
 #define APP_PROPERTYCONTAINER_H
 
 #include <map>
+#include <boost/unordered_map.hpp>
 #include <Base/Persistence.h>
 
 namespace Base {
@@ -60,6 +61,16 @@ struct AppExport PropertyData
   std::vector<PropertySpec> propertyData;
   const PropertyData *parentPropertyData;
 
+  struct NameHash  { std::size_t operator()(const char* name) const; };
+  struct NameEqual { bool operator()(const char* name1, const char* name2) const; };
+  typedef boost::unordered_map<const char*, std::size_t, NameHash, NameEqual> NameIndex;
+  typedef boost::unordered_map<short, std::size_t> OffsetIndex;
+  /** Hashed index of the positions of the own properties in propertyData.
+   * It is updated by addProperty(), the lookup continues in the parent classes.
+   */
+  NameIndex nameIndex;
+  OffsetIndex offsetIndex;
+
   void addProperty(const PropertyContainer *container,const char* PropName, Property *Prop, const char* PropertyGroup= 0, PropertyType = Prop_None, const char* PropertyDocu= 0 );
 
   const PropertySpec *findProperty(const PropertyContainer *container,const char* PropName) const;
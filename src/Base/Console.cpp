@@ -32,6 +32,12 @@
 # include <windows.h>
 # endif
 # include "fcntl.h"
+# include <QAtomicInt>
+# include <QAtomicPointer>
+# include <QMutex>
+# include <QMutexLocker>
+# include <QThread>
+# include <QWaitCondition>
 #endif
 
 #include "Console.h"
@@ -41,6 +47,120 @@
 using namespace Base;
 
 
+namespace Base {
+
+// A message waiting for the background thread
+struct ConsoleMessage
+{
+    ConsoleMessage() : type(0) {}
+    QAtomicPointer<ConsoleMessage> next;
+    int type;
+    std::string text;
+};
+
+// Delivers the queued messages to the observers
+class ConsoleSinkThread : public QThread
+{
+public:
+    ConsoleSinkThread(ConsoleSingleton& c) : console(c) {}
+    void run();
+
+private:
+    ConsoleSingleton& console;
+};
+
+struct ConsoleSingletonP
+{
+    ConsoleSingletonP() : observerMutex(QMutex::Recursive), enabled(~0), sink(0), stop(false),
+        rateLimit(0), window(0)
+    {
+        tail = new ConsoleMessage();
+        head = tail;
+        for (int i=0; i<4; i++) {
+            count[i] = 0;
+            suppressed[i] = 0;
+        }
+    }
+    ~ConsoleSingletonP()
+    {
+        while (pop()) {}
+        delete tail;
+    }
+
+    // The queue is a lock-free multi-producer single-consumer list: producers
+    // swap the head atomically and link the previous head to the new message,
+    // the consumer follows the links from the tail which is always an already
+    // delivered message.
+    void push(int type, const char* text)
+    {
+        ConsoleMessage* msg = new ConsoleMessage();
+        msg->type = type;
+        msg->text = text;
+        ConsoleMessage* prev = head.fetchAndStoreOrdered(msg);
+        prev->next.fetchAndStoreRelease(msg);
+        pushed.ref();
+    }
+    // must only be called from one thread at a time
+    ConsoleMessage* pop()
+    {
+        ConsoleMessage* next = tail->next.fetchAndAddAcquire(0);
+        if (!next)
+            return 0;
+        delete tail;
+        tail = next;
+        return next;
+    }
+    static int index(int type)
+    {
+        switch (type) {
+        case ConsoleSingleton::MsgType_Txt: return 0;
+        case ConsoleSingleton::MsgType_Log: return 1;
+        case ConsoleSingleton::MsgType_Wrn: return 2;
+        default: return 3;
+        }
+    }
+
+    // guards the observers and their notification
+    QMutex observerMutex;
+    // OR'ed message types which at least one observer takes
+    QAtomicInt enabled;
+
+    QAtomicPointer<ConsoleMessage> head;
+    ConsoleMessage* tail;
+    QAtomicInt pushed;
+    QAtomicInt delivered;
+    QMutex waitMutex;
+    QWaitCondition wakeSink;
+    QWaitCondition wakeFlush;
+    ConsoleSinkThread* sink;
+    volatile bool stop;
+
+    int rateLimit;
+    time_t window;
+    int count[4];
+    int suppressed[4];
+};
+
+void ConsoleSinkThread::run()
+{
+    ConsoleSingletonP* d = console.d;
+    for (;;) {
+        ConsoleMessage* msg;
+        while ((msg = d->pop()) != 0) {
+            console.Dispatch((ConsoleSingleton::FreeCAD_ConsoleMsgType)msg->type, msg->text.c_str());
+            d->delivered.ref();
+        }
+
+        QMutexLocker lock(&d->waitMutex);
+        d->wakeFlush.wakeAll();
+        if (d->stop)
+            break;
+        // producers don't signal to stay lock-free, so look again after a short while
+        d->wakeSink.wait(&d->waitMutex, 20);
+    }
+}
+
+} // namespace Base
 
 
 //**************************************************************************
@@ -48,15 +168,17 @@ using namespace Base;
 
 
 ConsoleSingleton::ConsoleSingleton(void)
-  :_bVerbose(false)
+  :_bVerbose(false), d(new ConsoleSingletonP)
 {
 
 }
 
 ConsoleSingleton::~ConsoleSingleton()
 {
+    StopSink();
     for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter)
         delete (*Iter);
+    delete d;
 }
 
 
@@ -68,16 +190,73 @@ ConsoleSingleton::~ConsoleSingleton()
  */
 void ConsoleSingleton::SetMode(ConsoleMode m)
 {
-    if(m && Verbose)
+    if(m & Verbose)
         _bVerbose = true;
+    if(m & Async)
+        StartSink();
 }
 /**  
  *  unsets the console from a special mode
  */
 void ConsoleSingleton::UnsetMode(ConsoleMode m)
 {
-    if(m && Verbose)
+    if(m & Verbose)
         _bVerbose = false;
+    if(m & Async)
+        StopSink();
+}
+
+/**
+ * The background thread takes the messages from a lock-free queue, so that
+ * the issuing thread doesn't wait for the observers and their I/O. Errors are
+ * still delivered before Error() returns.
+ */
+void ConsoleSingleton::StartSink()
+{
+    if (d->sink)
+        return;
+    d->stop = false;
+    d->sink = new ConsoleSinkThread(*this);
+    d->sink->start(QThread::LowPriority);
+}
+
+void ConsoleSingleton::StopSink()
+{
+    if (!d->sink)
+        return;
+    {
+        QMutexLocker lock(&d->waitMutex);
+        d->stop = true;
+        d->wakeSink.wakeOne();
+    }
+    d->sink->wait();
+    delete d->sink;
+    d->sink = 0;
+
+    // messages that came in while the thread was stopping
+    ConsoleMessage* msg;
+    while ((msg = d->pop()) != 0) {
+        Dispatch((FreeCAD_ConsoleMsgType)msg->type, msg->text.c_str());
+        d->delivered.ref();
+    }
+}
+
+void ConsoleSingleton::Flush()
+{
+    if (!d->sink || QThread::currentThread() == d->sink)
+        return;
+    int target = d->pushed;
+    QMutexLocker lock(&d->waitMutex);
+    while ((int)d->delivered - target < 0 && !d->stop) {
+        d->wakeSink.wakeOne();
+        d->wakeFlush.wait(&d->waitMutex, 20);
+    }
+}
+
+void ConsoleSingleton::SetRateLimit(int msgPerSecond)
+{
+    QMutexLocker lock(&d->observerMutex);
+    d->rateLimit = msgPerSecond;
 }
 
 /**
@@ -98,6 +277,7 @@ void ConsoleSingleton::UnsetMode(ConsoleMode m)
  */
 ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsgFlags type, bool b)
 {
+    QMutexLocker lock(&d->observerMutex);
     ConsoleObserver* pObs = Get(sObs);
     if ( pObs ){
         ConsoleMsgFlags flags=0;
@@ -122,6 +302,7 @@ ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsg
                 flags |= MsgType_Log;
             pObs->bLog = b;
         }
+        UpdateEnabled();
         return flags;
     }
     else {
@@ -170,11 +351,14 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
     char format[4024];
     const unsigned int format_len = 4024;
 
+    if (!IsEnabled(MsgType_Txt))
+        return;
+
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyMessage(format);
+    Post(MsgType_Txt, format);
 }
 
 /** Prints a Message
@@ -197,11 +381,14 @@ void ConsoleSingleton::Warning( const char *pMsg, ... )
     char format[4024];
     const unsigned int format_len = 4024;
 
+    if (!IsEnabled(MsgType_Wrn))
+        return;
+
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyWarning(format);
+    Post(MsgType_Wrn, format);
 }
 
 /** Prints a Message
@@ -224,11 +411,14 @@ void ConsoleSingleton::Error( const char *pMsg, ... )
     char format[4024];
     const unsigned int format_len = 4024;
 
+    if (!IsEnabled(MsgType_Err))
+        return;
+
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
     vsnprintf(format, format_len, pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyError(format);
+    Post(MsgType_Err, format);
 }
 
 
@@ -254,13 +444,13 @@ void ConsoleSingleton::Log( const char *pMsg, ... )
     char format[4024];
     const unsigned int format_len = 4024;
 
-    if (!_bVerbose)
+    if (!_bVerbose && IsEnabled(MsgType_Log))
     {
         va_list namelessVars;
         va_start(namelessVars, pMsg);  // Get the "..." vars
         vsnprintf(format, format_len, pMsg, namelessVars);
         va_end(namelessVars);
-        NotifyLog(format);
+        Post(MsgType_Log, format);
     }
 }
 
@@ -294,10 +484,12 @@ const char* ConsoleSingleton::Time(void)
  */
 void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
 {
+    QMutexLocker lock(&d->observerMutex);
     // double insert !!
     assert(_aclObservers.find(pcObserver) == _aclObservers.end() );
 
     _aclObservers.insert(pcObserver);
+    UpdateEnabled();
 }
 
 /** Detaches an Observer from Console
@@ -307,7 +499,94 @@ void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
  */
 void ConsoleSingleton::DetachObserver(ConsoleObserver *pcObserver)
 {
+    // the observer may be destroyed afterwards, so deliver the pending messages first
+    Flush();
+    QMutexLocker lock(&d->observerMutex);
     _aclObservers.erase(pcObserver);
+    UpdateEnabled();
+}
+
+bool ConsoleSingleton::IsEnabled(FreeCAD_ConsoleMsgType type) const
+{
+    return ((int)d->enabled & type) != 0;
+}
+
+void ConsoleSingleton::UpdateEnabled()
+{
+    // the flags of the observers are public and may be changed directly, so
+    // this is also refreshed after each delivered message
+    QMutexLocker locker(&d->observerMutex);
+    int flags = 0;
+    for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
+        if((*Iter)->bMsg)
+            flags |= MsgType_Txt;
+        if((*Iter)->bLog)
+            flags |= MsgType_Log;
+        if((*Iter)->bWrn)
+            flags |= MsgType_Wrn;
+        if((*Iter)->bErr)
+            flags |= MsgType_Err;
+    }
+    // without any observer nothing gets lost by formatting the messages anyway
+    if (_aclObservers.empty())
+        flags = ~0;
+    d->enabled = flags;
+}
+
+void ConsoleSingleton::Post(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    if (d->sink) {
+        d->push(type, sMsg);
+        if (type == MsgType_Err)
+            Flush();
+    }
+    else {
+        Dispatch(type, sMsg);
+    }
+}
+
+void ConsoleSingleton::Dispatch(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    QMutexLocker lock(&d->observerMutex);
+
+    // rate limiting, errors always get through
+    if (d->rateLimit > 0 && type != MsgType_Err) {
+        time_t now = time(0);
+        if (now != d->window) {
+            d->window = now;
+            for (int i=0; i<4; i++) {
+                d->count[i] = 0;
+                if (d->suppressed[i] > 0) {
+                    int msgType = (i == 0 ? MsgType_Txt : i == 1 ? MsgType_Log : MsgType_Wrn);
+                    char text[100];
+                    snprintf(text, sizeof(text), "(%d messages suppressed)\n", d->suppressed[i]);
+                    d->suppressed[i] = 0;
+                    Dispatch((FreeCAD_ConsoleMsgType)msgType, text);
+                }
+            }
+        }
+        int index = ConsoleSingletonP::index(type);
+        if (++d->count[index] > d->rateLimit) {
+            d->suppressed[index]++;
+            return;
+        }
+    }
+
+    switch (type) {
+    case MsgType_Txt:
+        NotifyMessage(sMsg);
+        break;
+    case MsgType_Log:
+        NotifyLog(sMsg);
+        break;
+    case MsgType_Wrn:
+        NotifyWarning(sMsg);
+        break;
+    case MsgType_Err:
+        NotifyError(sMsg);
+        break;
+    }
+    UpdateEnabled();
 }
 
 void ConsoleSingleton::NotifyMessage(const char *sMsg)
@@ -394,6 +673,8 @@ PyMethodDef ConsoleSingleton::Methods[] = {
      "Set the status for either Log, Msg, Wrn or Error for an observer"},
     {"GetStatus",            (PyCFunction) ConsoleSingleton::sPyGetStatus, 1,
      "Get the status for either Log, Msg, Wrn or Error for an observer"},
+    {"SetAsync",             (PyCFunction) ConsoleSingleton::sPySetAsync, 1,
+     "SetAsync(bool) -- Deliver the messages to the observers from a background thread"},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -582,6 +863,7 @@ PyObject *ConsoleSingleton::sPySetStatus(PyObject * /*self*/, PyObject *args, Py
             else
                 Py_Error(Base::BaseExceptionFreeCADError,"Unknown Message Type (use Log,Err,Msg or Wrn)");
 
+            Instance().UpdateEnabled();
             Py_INCREF(Py_None);
             return Py_None;
         } else {
@@ -591,6 +873,22 @@ PyObject *ConsoleSingleton::sPySetStatus(PyObject * /*self*/, PyObject *args, Py
     } PY_CATCH;
 }
 
+PyObject *ConsoleSingleton::sPySetAsync(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    PyObject *on;
+    if (!PyArg_ParseTuple(args, "O!", &PyBool_Type, &on))   // convert args: Python->C 
+        return NULL;                                       // NULL triggers exception 
+
+    PY_TRY{
+        if (PyObject_IsTrue(on))
+            Instance().SetMode(Async);
+        else
+            Instance().UnsetMode(Async);
+        Py_INCREF(Py_None);
+        return Py_None;
+    } PY_CATCH;
+}
+
 //=========================================================================
 // some special observers
 
@@ -52,6 +52,7 @@
  
 namespace Base {
 class ConsoleSingleton;
+struct ConsoleSingletonP;
 } // namespace Base
 
 typedef Base::ConsoleSingleton ConsoleMsgType;
@@ -126,6 +127,7 @@ public:
     /// enumaration for the console modes
     enum ConsoleMode{
         Verbose = 1,	// supress Log messages
+        Async   = 2,	// deliver the messages to the observers from a background thread
     };
 
     enum FreeCAD_ConsoleMsgType { 
@@ -143,6 +145,12 @@ public:
     ConsoleMsgFlags SetEnabledMsgType(const char* sObs, ConsoleMsgFlags type, bool b);
     /// Enables or disables message types of a cetain console observer
     bool IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
+    /// Limits the number of messages of each type (except errors) per second, 0 means no limit
+    void SetRateLimit(int msgPerSecond);
+    /// In Async mode waits until all messages issued so far are delivered to the observers
+    void Flush();
+    /// Must be called after an observer changed its message type flags directly
+    void UpdateEnabled();
 
     /// singleton 
     static ConsoleSingleton &Instance(void);
@@ -161,6 +169,7 @@ protected:
     static PyObject *sPyError    (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sPySetStatus(PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sPyGetStatus(PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPySetAsync (PyObject *self,PyObject *args,PyObject *kwd);
 
     bool _bVerbose;
 
@@ -178,9 +187,18 @@ private:
     void NotifyWarning(const char *sMsg);
     void NotifyError  (const char *sMsg);
     void NotifyLog    (const char *sMsg);
+    // checks whether any observer takes messages of this type
+    bool IsEnabled(FreeCAD_ConsoleMsgType type) const;
+    // passes the message to the observers or the queue of the background thread
+    void Post(FreeCAD_ConsoleMsgType type, const char *sMsg);
+    void Dispatch(FreeCAD_ConsoleMsgType type, const char *sMsg);
+    void StartSink();
+    void StopSink();
+    friend class ConsoleSinkThread;
 
     // observer list
     std::set<ConsoleObserver * > _aclObservers;
+    ConsoleSingletonP* d;
 };
 
 /** Access to the Console
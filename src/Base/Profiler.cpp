@@ -0,0 +1,283 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <iomanip>
+# include <map>
+# include <ostream>
+# include <sstream>
+# include <vector>
+# include <QMutex>
+# include <QMutexLocker>
+# include <QThread>
+# ifdef FC_OS_WIN32
+#  include <windows.h>
+# else
+#  include <sys/time.h>
+# endif
+#endif
+
+#include "Profiler.h"
+
+using namespace Base;
+
+namespace Base {
+struct ProfilerP {
+    struct Event {
+        const char* category;
+        std::string name;
+        double start;
+        double duration;
+        int thread;
+    };
+    struct Counter {
+        std::string name;
+        double time;
+        long value;
+    };
+    struct Statistic {
+        Statistic() : calls(0), total(0.0), maximum(0.0) {}
+        unsigned long calls;
+        double total;
+        double maximum;
+    };
+
+    ProfilerP() : origin(0.0) {}
+
+    static double systemTime()
+    {
+#ifdef FC_OS_WIN32
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return 1.0e6 * (double)count.QuadPart / (double)freq.QuadPart;
+#else
+        struct timeval tv;
+        gettimeofday(&tv, 0);
+        return 1.0e6 * (double)tv.tv_sec + (double)tv.tv_usec;
+#endif
+    }
+
+    int threadIndex()
+    {
+        Qt::HANDLE id = QThread::currentThreadId();
+        std::map<Qt::HANDLE, int>::iterator it = threads.find(id);
+        if (it != threads.end())
+            return it->second;
+        int index = (int)threads.size() + 1;
+        threads[id] = index;
+        return index;
+    }
+
+    static void writeString(std::ostream& str, const std::string& text)
+    {
+        str << '"';
+        for (std::string::const_iterator it = text.begin(); it != text.end(); ++it) {
+            unsigned char c = (unsigned char)*it;
+            if (c == '"' || c == '\\')
+                str << '\\' << *it;
+            else if (c < 0x20)
+                str << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+                    << std::dec << std::setfill(' ');
+            else
+                str << *it;
+        }
+        str << '"';
+    }
+
+    QMutex mutex;
+    double origin;
+    std::vector<Event> events;
+    std::vector<Counter> counters;
+    std::map<std::string, long> counterValues;
+    std::map<Qt::HANDLE, int> threads;
+};
+}
+
+// created on static initialization, so that threads never race for the creation
+Profiler* Profiler::_instance = new Profiler();
+volatile bool Profiler::_enabled = false;
+
+Profiler& Profiler::instance()
+{
+    return *_instance;
+}
+
+void Profiler::destruct()
+{
+    _enabled = false;
+    delete _instance;
+    _instance = 0;
+}
+
+Profiler::Profiler() : d(new ProfilerP)
+{
+    d->origin = ProfilerP::systemTime();
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+void Profiler::setEnabled(bool on)
+{
+    _enabled = on;
+}
+
+void Profiler::clear()
+{
+    QMutexLocker locker(&d->mutex);
+    d->events.clear();
+    d->counters.clear();
+    d->counterValues.clear();
+}
+
+double Profiler::currentTime() const
+{
+    return ProfilerP::systemTime() - d->origin;
+}
+
+void Profiler::addEvent(const char* category, const char* name, double start, double duration)
+{
+    QMutexLocker locker(&d->mutex);
+    ProfilerP::Event event;
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    event.thread = d->threadIndex();
+    d->events.push_back(event);
+}
+
+void Profiler::count(const char* name, long value)
+{
+    double time = currentTime();
+    QMutexLocker locker(&d->mutex);
+    long& total = d->counterValues[name];
+    total += value;
+    ProfilerP::Counter counter;
+    counter.name = name;
+    counter.time = time;
+    counter.value = total;
+    d->counters.push_back(counter);
+}
+
+void Profiler::writeChromeTrace(std::ostream& str) const
+{
+    QMutexLocker locker(&d->mutex);
+    std::ios::fmtflags flags = str.flags();
+    std::streamsize precision = str.precision();
+    str << "{\"traceEvents\":[";
+    bool first = true;
+    str << std::fixed << std::setprecision(3);
+    for (std::vector<ProfilerP::Event>::const_iterator it = d->events.begin(); it != d->events.end(); ++it) {
+        if (!first)
+            str << ",";
+        first = false;
+        str << "\n{\"name\":";
+        ProfilerP::writeString(str, it->name);
+        str << ",\"cat\":";
+        ProfilerP::writeString(str, it->category);
+        str << ",\"ph\":\"X\",\"ts\":" << it->start << ",\"dur\":" << it->duration
+            << ",\"pid\":1,\"tid\":" << it->thread << "}";
+    }
+    for (std::vector<ProfilerP::Counter>::const_iterator it = d->counters.begin(); it != d->counters.end(); ++it) {
+        if (!first)
+            str << ",";
+        first = false;
+        str << "\n{\"name\":";
+        ProfilerP::writeString(str, it->name);
+        str << ",\"ph\":\"C\",\"ts\":" << it->time
+            << ",\"pid\":1,\"args\":{\"value\":" << it->value << "}}";
+    }
+    str << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    str.flags(flags);
+    str.precision(precision);
+}
+
+void Profiler::writeSummary(std::ostream& str) const
+{
+    typedef std::pair<std::string, std::string> Key;
+    std::map<Key, ProfilerP::Statistic> stats;
+    std::map<std::string, long> counters;
+    {
+        QMutexLocker locker(&d->mutex);
+        for (std::vector<ProfilerP::Event>::const_iterator it = d->events.begin(); it != d->events.end(); ++it) {
+            ProfilerP::Statistic& s = stats[Key(it->category, it->name)];
+            s.calls++;
+            s.total += it->duration;
+            s.maximum = std::max<double>(s.maximum, it->duration);
+        }
+        counters = d->counterValues;
+    }
+
+    // sort by the total time, the most expensive sections first
+    std::vector<std::pair<double, Key> > order;
+    order.reserve(stats.size());
+    for (std::map<Key, ProfilerP::Statistic>::const_iterator it = stats.begin(); it != stats.end(); ++it)
+        order.push_back(std::make_pair(-it->second.total, it->first));
+    std::sort(order.begin(), order.end());
+
+    std::ios::fmtflags flags = str.flags();
+    std::streamsize precision = str.precision();
+
+    str << std::left << std::setw(12) << "Category" << std::setw(32) << "Name"
+        << std::right << std::setw(8) << "Calls" << std::setw(14) << "Total [ms]"
+        << std::setw(14) << "Mean [ms]" << std::setw(14) << "Max [ms]" << "\n";
+    str << std::fixed << std::setprecision(3);
+    for (std::vector<std::pair<double, Key> >::const_iterator it = order.begin(); it != order.end(); ++it) {
+        const ProfilerP::Statistic& s = stats[it->second];
+        str << std::left << std::setw(12) << it->second.first << std::setw(32) << it->second.second
+            << std::right << std::setw(8) << s.calls << std::setw(14) << s.total / 1000.0
+            << std::setw(14) << s.total / (1000.0 * s.calls) << std::setw(14) << s.maximum / 1000.0 << "\n";
+    }
+
+    if (!counters.empty()) {
+        str << "\n" << std::left << std::setw(44) << "Counter" << std::right << std::setw(14) << "Value" << "\n";
+        for (std::map<std::string, long>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+            str << std::left << std::setw(44) << it->first << std::right << std::setw(14) << it->second << "\n";
+    }
+
+    str.flags(flags);
+    str.precision(precision);
+}
+
+// --------------------------------------------------------------------
+
+void ProfileScope::begin(const char* cat, const char* text)
+{
+    category = cat;
+    name = text ? text : "";
+    start = Profiler::instance().currentTime();
+}
+
+void ProfileScope::end()
+{
+    Profiler& profiler = Profiler::instance();
+    double duration = profiler.currentTime() - start;
+    profiler.addEvent(category, name.c_str(), start, duration);
+}
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_PROFILER_H
+#define BASE_PROFILER_H
+
+#include <string>
+#include <iosfwd>
+
+namespace Base
+{
+
+struct ProfilerP;
+
+/**
+ * \brief The Profiler collects the run time of scoped code sections and the
+ * values of named counters.
+ *
+ * It is disabled by default. As long as it is disabled a ProfileScope costs
+ * not more than checking a flag, so the instrumentation can stay in release
+ * builds. Events may be recorded from any thread.
+ *
+ * The collected data can be written as Chrome trace JSON (which can be loaded
+ * with chrome://tracing) or as a summary table sorted by the total time spent
+ * in each section.
+ *  \code
+ *  #include <Base/Profiler.h>
+ *
+ *  void Feature::execute()
+ *  {
+ *      FC_PROFILE_SCOPE("occ", "BRepAlgoAPI_Fuse");
+ *      ...
+ *  }
+ *  \endcode
+ */
+class BaseExport Profiler
+{
+public:
+    /// the profiler singleton, it must not be used after destruct()
+    static Profiler& instance();
+    static void destruct();
+
+    /// enables or disables the recording of events
+    void setEnabled(bool on);
+    /// checks whether events are recorded
+    static bool isEnabled() {
+        return _enabled;
+    }
+    /// removes all recorded events and counters
+    void clear();
+
+    /// returns the time in microseconds since the creation of the profiler
+    double currentTime() const;
+    /// records a section of \a category named \a name that ran \a duration microseconds
+    void addEvent(const char* category, const char* name, double start, double duration);
+    /// adds \a value to the counter \a name
+    void count(const char* name, long value = 1);
+
+    /// writes all events and counters in the Chrome trace event format
+    void writeChromeTrace(std::ostream&) const;
+    /// writes a table with the number of calls and times of each section
+    void writeSummary(std::ostream&) const;
+
+private:
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+    ProfilerP* d;
+    static Profiler* _instance;
+    static volatile bool _enabled;
+};
+
+/**
+ * ProfileScope measures the time between its construction and destruction
+ * and passes it to the Profiler if this is enabled.
+ * The category must be a string literal while the name is copied.
+ */
+class BaseExport ProfileScope
+{
+public:
+    ProfileScope(const char* category, const char* name)
+      : active(Profiler::isEnabled()), start(0.0), category(0)
+    {
+        if (active)
+            begin(category, name);
+    }
+    ~ProfileScope()
+    {
+        if (active)
+            end();
+    }
+
+private:
+    void begin(const char* category, const char* name);
+    void end();
+
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator=(const ProfileScope&);
+
+    bool active;
+    double start;
+    const char* category;
+    std::string name;
+};
+
+} //namespace Base
+
+/// measures the time until the end of the current block
+#define FC_PROFILE_SCOPE(_category_, _name_) \
+    Base::ProfileScope _profile_scope_(_category_, _name_)
+
+/// increases the counter \a _name_ while the profiler is enabled
+#define FC_PROFILE_COUNT(_name_, _value_) \
+    do { \
+        if (Base::Profiler::isEnabled()) \
+            Base::Profiler::instance().count(_name_, _value_); \
+    } while (0)
+
+#endif // BASE_PROFILER_H
@@ -37,7 +37,7 @@ PyObject* Base::BaseExceptionFreeCADError = 0;
 
 // Constructor
 PyObjectBase::PyObjectBase(void* p,PyTypeObject *T)
-  : _pcTwinPointer(p), parent(0), attribute(0)
+  : _pcTwinPointer(p), parent(0), attribute(0), busyCount(0)
 {
     this->ob_type = T;
     _Py_NewReference(this);
@@ -283,3 +283,52 @@ void PyObjectBase::startNotify()
             PyErr_Clear();
     }
 }
+
+// --------------------------------------------------------------------
+
+PyAllowThreads::PyAllowThreads() : state(0)
+{
+}
+
+PyAllowThreads::~PyAllowThreads()
+{
+    // grab the global interpreter lock again before touching any Python object
+    if (state)
+        PyEval_RestoreThread(state);
+    for (std::vector<PyObjectBase*>::iterator it = readers.begin(); it != readers.end(); ++it) {
+        (*it)->busyCount--;
+        Py_DECREF(*it);
+    }
+    for (std::vector<PyObjectBase*>::iterator it = writers.begin(); it != writers.end(); ++it) {
+        (*it)->busyCount = 0;
+        Py_DECREF(*it);
+    }
+}
+
+void PyAllowThreads::read(PyObjectBase* obj)
+{
+    if (state)
+        throw Base::RuntimeError("Cannot register an object after the GIL has been released");
+    if (obj->isModifying())
+        throw Base::RuntimeError("Object is being modified by another thread");
+    Py_INCREF(obj);
+    obj->busyCount++;
+    readers.push_back(obj);
+}
+
+void PyAllowThreads::write(PyObjectBase* obj)
+{
+    if (state)
+        throw Base::RuntimeError("Cannot register an object after the GIL has been released");
+    if (obj->isBusy())
+        throw Base::RuntimeError("Object is in use by another thread");
+    Py_INCREF(obj);
+    obj->busyCount = -1;
+    writers.push_back(obj);
+}
+
+void PyAllowThreads::release()
+{
+    if (!state)
+        state = PyEval_SaveThread();
+}
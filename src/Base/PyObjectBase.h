@@ -48,6 +48,7 @@
 #define slots
 #include <iostream>
 #include <bitset>
+#include <vector>
 
 #include <typeinfo>
 #include "Exception.h"
@@ -296,6 +297,16 @@ public:
         return StatusBits.test(1);
     }
 
+    /// returns true if C++ code modifies the twin object while the GIL is released
+    bool isModifying() const {
+        return busyCount < 0;
+    }
+
+    /// returns true if C++ code reads or modifies the twin object while the GIL is released
+    bool isBusy() const {
+        return busyCount != 0;
+    }
+
     void setAttributeOf(const char* attr, const PyObjectBase* par);
     void startNotify();
 
@@ -307,6 +318,54 @@ protected:
     void * _pcTwinPointer;
     PyObjectBase* parent;
     char* attribute;
+
+private:
+    friend class PyAllowThreads;
+    /// number of readers or -1 for a writer, see PyAllowThreads
+    int busyCount;
+};
+
+/**
+ * PyAllowThreads releases the global interpreter lock (GIL) while a long running
+ * C++ operation is executed so that other Python threads can continue meanwhile.
+ *
+ * The Python objects whose twins are accessed by the operation must be registered
+ * with read() or write() before calling release(). As long as they are registered
+ * other threads get an exception when they call a method that would modify them
+ * (or any method of a written object). After release() no Python object must be
+ * touched until the PyAllowThreads instance is destroyed. The destructor takes the
+ * GIL again, even if an exception is thrown, so that PY_CATCH can safely be used:
+ * \code
+ * PY_TRY {
+ *     Base::PyAllowThreads threads;
+ *     threads.write(this);
+ *     threads.release();
+ *     getMeshObjectPtr()->load(Name);
+ * } PY_CATCH;
+ * \endcode
+ * The twin objects must be kept alive by the caller, e.g. with a Base::Reference
+ * or by copying the data before release() is called.
+ */
+class BaseExport PyAllowThreads
+{
+public:
+    PyAllowThreads();
+    ~PyAllowThreads();
+
+    /// the twin of \a obj is read while the GIL is released
+    void read(PyObjectBase* obj);
+    /// the twin of \a obj is modified while the GIL is released
+    void write(PyObjectBase* obj);
+    /// release the GIL
+    void release();
+
+private:
+    PyAllowThreads(const PyAllowThreads&);
+    PyAllowThreads& operator=(const PyAllowThreads&);
+
+    std::vector<PyObjectBase*> readers;
+    std::vector<PyObjectBase*> writers;
+    PyThreadState* state;
 };
 
 
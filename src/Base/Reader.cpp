@@ -37,6 +37,7 @@
 #include "Base64.h"
 #include "Exception.h"
 #include "Persistence.h"
+#include "Profiler.h"
 #include "InputSource.h"
 #include "Console.h"
 #include "Sequencer.h"
@@ -320,6 +321,7 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
         if (jt != FileList.end()) {
             try {
                 Base::Reader reader(zipstream, jt->FileName, DocumentSchema);
+                FC_PROFILE_SCOPE("restore", jt->Object->getTypeId().getName());
                 jt->Object->RestoreDocFile(reader);
             }
             catch(...) {
@@ -364,6 +366,19 @@ const std::vector<std::string>& Base::XMLReader::getFilenames() const
     return FileNames;
 }
 
+std::map<const Base::Persistence*, std::string> Base::XMLReader::getObjectFiles() const
+{
+    std::map<const Base::Persistence*, std::string> files;
+    std::set<const Base::Persistence*> multiple;
+    for (std::vector<FileEntry>::const_iterator it = FileList.begin(); it != FileList.end(); ++it) {
+        if (!files.insert(std::make_pair(it->Object, it->FileName)).second)
+            multiple.insert(it->Object);
+    }
+    for (std::set<const Base::Persistence*>::iterator it = multiple.begin(); it != multiple.end(); ++it)
+        files.erase(*it);
+    return files;
+}
+
 bool Base::XMLReader::isRegistered(Base::Persistence *Object) const
 {
     if (Object) {
@@ -160,6 +160,8 @@ public:
     void readFiles(zipios::ZipInputStream &zipstream) const;
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
+    /// get the file name of each object that registered exactly one file
+    std::map<const Base::Persistence*, std::string> getObjectFiles() const;
     bool isRegistered(Base::Persistence *Object) const;
     virtual void addName(const char*, const char*);
     virtual const char* getName(const char*) const;
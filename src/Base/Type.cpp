@@ -26,6 +26,8 @@
 # include <assert.h>
 #endif
 
+#include <boost/unordered_map.hpp>
+
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include "Type.h"
 #include "Exception.h"
@@ -49,9 +51,15 @@ struct Base::TypeData
   Type parent;
   Type type;
   Type::instantiationMethod instMethod;
+  /// the keys of all base types, starting with the root of the hierarchy and ending with the type itself
+  std::vector<unsigned int> ancestors;
 };
 
-map<string,unsigned int> Type::typemap;
+namespace {
+// hashed names of all registered types
+boost::unordered_map<std::string, unsigned int> typemap;
+}
+
 vector<TypeData*>        Type::typedata;
 set<string>              Type::loadModuleSet;
 
@@ -144,10 +152,15 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   Type newType;
   newType.index = Type::typedata.size();
   TypeData * typeData = new TypeData(name, newType, parent,method);
+  // super classes are registered first, so the chain of base types is known
+  // here and allows to check the derivation in constant time
+  if (!parent.isBad())
+    typeData->ancestors = Type::typedata[parent.getKey()]->ancestors;
+  typeData->ancestors.push_back(newType.getKey());
   Type::typedata.push_back(typeData);
 
   // add to dictionary for fast lookup
-  Type::typemap[name] = newType.getKey();
+  typemap[name] = newType.getKey();
 
   return newType;
 }
@@ -159,7 +172,7 @@ void Type::init(void)
 
 
   Type::typedata.push_back(new TypeData("BadType"));
-  Type::typemap["BadType"] = 0;
+  typemap["BadType"] = 0;
 
 
 }
@@ -175,7 +188,7 @@ void Type::destruct(void)
 
 Type Type::fromName(const char *name)
 {
-  std::map<std::string,unsigned int>::const_iterator pos;
+  boost::unordered_map<std::string,unsigned int>::const_iterator pos;
   
   pos = typemap.find(name);
   if(pos != typemap.end())
@@ -196,15 +209,14 @@ const Type Type::getParent(void) const
 
 bool Type::isDerivedFrom(const Type type) const
 {
-  
-  Type temp(*this);
-  do {
-    if(temp == type)
-      return true;
-    temp = temp.getParent();
-  } while (temp != badType());
-
-  return false;
+  // the bad type is only derived from itself
+  if (type.isBad() || this->isBad())
+    return this->index == type.index;
+
+  // 'type' is a base type if it's at the same depth in our chain of base types
+  const std::vector<unsigned int>& ancestors = typedata[this->index]->ancestors;
+  std::vector<unsigned int>::size_type depth = typedata[type.index]->ancestors.size() - 1;
+  return depth < ancestors.size() && ancestors[depth] == type.index;
 }
 
 int Type::getAllDerivedFrom(const Type type, std::vector<Type> & List)
@@ -127,7 +127,6 @@ private:
   unsigned int index;
 
 
-  static std::map<std::string,unsigned int> typemap;
   static std::vector<TypeData*>     typedata;
 
   static std::set<std::string>  loadModuleSet;
@@ -29,6 +29,7 @@
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include "Writer.h"
 #include "Persistence.h"
+#include "Profiler.h"
 #include "Exception.h"
 #include "Base64.h"
 #include "FileInfo.h"
@@ -37,6 +38,7 @@
 
 #include <algorithm>
 #include <locale>
+#include <memory>
 
 using namespace Base;
 using namespace std;
@@ -141,6 +143,19 @@ void Writer::clearModes()
     Modes.clear();
 }
 
+void Writer::setSharedName(const void* key, const std::string& name)
+{
+    SharedNames[key] = name;
+}
+
+std::string Writer::getSharedName(const void* key) const
+{
+    std::map<const void*, std::string>::const_iterator it = SharedNames.find(key);
+    if (it != SharedNames.end())
+        return it->second;
+    return std::string();
+}
+
 void Writer::addError(const std::string& msg)
 {
     Errors.push_back(msg);
@@ -214,6 +229,19 @@ const std::vector<std::string>& Writer::getFilenames() const
     return FileNames;
 }
 
+std::map<const Base::Persistence*, std::string> Writer::getObjectFiles() const
+{
+    std::map<const Base::Persistence*, std::string> files;
+    std::set<const Base::Persistence*> multiple;
+    for (std::vector<FileEntry>::const_iterator it = FileList.begin(); it != FileList.end(); ++it) {
+        if (!files.insert(std::make_pair(it->Object, it->FileName)).second)
+            multiple.insert(it->Object);
+    }
+    for (std::set<const Base::Persistence*>::iterator it = multiple.begin(); it != multiple.end(); ++it)
+        files.erase(*it);
+    return files;
+}
+
 void Writer::incInd(void)
 {
     if (indent < 1020) {
@@ -265,15 +293,89 @@ ZipWriter::ZipWriter(std::ostream& os)
     ZipStream.setf(ios::fixed,ios::floatfield);
 }
 
+void ZipWriter::setReusableFiles(const std::string& FileName,
+                                 const std::map<const Base::Persistence*, std::string>& files)
+{
+    ReuseArchive = FileName;
+    ReuseFiles = files;
+}
+
+bool ZipWriter::copyFile(zipios::ZipFile& source, std::istream& raw, const FileEntry& entry)
+{
+    std::map<const Base::Persistence*, std::string>::const_iterator it = ReuseFiles.find(entry.Object);
+    if (it == ReuseFiles.end())
+        return false;
+    // the extension tells the format the object has chosen to write
+    if (FileInfo(it->second).extension() != FileInfo(entry.FileName).extension())
+        return false;
+
+    zipios::ZipCDirEntry copy(entry.FileName);
+    try {
+        zipios::ConstEntryPointer ent = source.getEntry(it->second);
+        const zipios::ZipCDirEntry* cdir = dynamic_cast<const zipios::ZipCDirEntry*>(ent.get());
+        if (!cdir)
+            return false;
+
+        // the compressed data follows the local header
+        zipios::ZipLocalEntry local;
+        raw.clear();
+        raw.seekg(cdir->getLocalHeaderOffset());
+        raw >> local;
+        if (!raw || local.getMethod() != cdir->getMethod())
+            return false;
+
+        // the whole compressed data must be there
+        std::streampos start = raw.tellg();
+        raw.seekg(0, std::ios::end);
+        std::streampos end = raw.tellg();
+        raw.seekg(start);
+        if (!raw || end - start < static_cast<std::streamoff>(cdir->getCompressedSize()))
+            return false;
+
+        copy.setMethod(cdir->getMethod());
+        copy.setCrc(cdir->getCrc());
+        copy.setSize(cdir->getSize());
+        copy.setCompressedSize(cdir->getCompressedSize());
+        copy.setTime(cdir->getTime());
+    }
+    catch (const zipios::IOException&) {
+        // the local header could not be read
+        return false;
+    }
+
+    // there is no fall back from here on because a failure while copying leaves
+    // a partly written entry in the archive, so the exception aborts the saving
+    FC_PROFILE_SCOPE("save", "copy");
+    ZipStream.putRawEntry(copy, raw);
+    return true;
+}
+
 void ZipWriter::writeFiles(void)
 {
+    // the archive the unchanged files are copied from
+    std::auto_ptr<zipios::ZipFile> source;
+    std::auto_ptr<Base::ifstream> raw;
+    Base::FileInfo fi(ReuseArchive);
+    if (!ReuseFiles.empty() && fi.isReadable()) {
+        try {
+            source.reset(new zipios::ZipFile(ReuseArchive));
+            raw.reset(new Base::ifstream(fi, std::ios::in | std::ios::binary));
+        }
+        catch (const std::exception&) {
+            source.reset();
+        }
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList.begin()[index];
-        ZipStream.putNextEntry(entry.FileName);
-        entry.Object->SaveDocFile(*this);
+        if (!source.get() || !copyFile(*source, *raw, entry)) {
+            ZipStream.putNextEntry(entry.FileName);
+            FC_PROFILE_SCOPE("save", entry.Object->getTypeId().getName());
+            entry.Object->SaveDocFile(*this);
+        }
         index++;
     }
 }
@@ -325,6 +427,7 @@ void FileWriter::writeFiles(void)
 
             std::string fileName = DirName + "/" + entry.FileName;
             this->FileStream.open(fileName.c_str(), std::ios::out | std::ios::binary);
+            FC_PROFILE_SCOPE("save", entry.Object->getTypeId().getName());
             entry.Object->SaveDocFile(*this);
             this->FileStream.close();
         }
@@ -24,6 +24,7 @@
 #define BASE_WRITER_H
 
 
+#include <map>
 #include <set>
 #include <string>
 #include <sstream>
@@ -81,6 +82,8 @@ public:
     virtual void writeFiles(void)=0;
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
+    /// get the file name of each object that registered exactly one file
+    std::map<const Base::Persistence*, std::string> getObjectFiles() const;
     /// Set mode
     void setMode(const std::string& mode);
     /// Set modes
@@ -95,6 +98,14 @@ public:
     void clearModes();
     //@}
 
+    /** @name Shared data */
+    //@{
+    /// remember the name under which the data identified by \a key has been written
+    void setSharedName(const void* key, const std::string& name);
+    /// get the name under which the data identified by \a key has been written or an empty string
+    std::string getSharedName(const void* key) const;
+    //@}
+
     /** @name Error handling */
     //@{
     void addError(const std::string&);
@@ -128,6 +139,7 @@ protected:
     std::vector<std::string> FileNames;
     std::vector<std::string> Errors;
     std::set<std::string> Modes;
+    std::map<const void*, std::string> SharedNames;
 
     short indent;
     char indBuf[1024];
@@ -158,8 +170,20 @@ public:
     void setLevel(int level){ZipStream.setLevel( level );}
     void putNextEntry(const char* str){ZipStream.putNextEntry(str);}
 
+    /** Copies the files of the given objects from the zip archive \a FileName
+     * instead of saving them again. \a files holds the name of the file of each
+     * object inside this archive. The compressed data is copied as it is. If
+     * a file cannot be copied the object is saved as usual.
+     */
+    void setReusableFiles(const std::string& FileName,
+                          const std::map<const Base::Persistence*, std::string>& files);
+
 private:
+    bool copyFile(zipios::ZipFile& source, std::istream& raw, const FileEntry& entry);
+
     zipios::ZipOutputStream ZipStream;
+    std::string ReuseArchive;
+    std::map<const Base::Persistence*, std::string> ReuseFiles;
 };
 
 /** The StringWriter class 
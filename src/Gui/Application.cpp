@@ -648,6 +648,7 @@ void Application::slotNewDocument(const App::Document& Doc)
 
     // connect the signals to the application for the new document
     pDoc->signalNewObject.connect(boost::bind(&Gui::Application::slotNewObject, this, _1));
+    pDoc->signalNewObjects.connect(boost::bind(&Gui::Application::slotNewObjects, this, _1));
     pDoc->signalDeletedObject.connect(boost::bind(&Gui::Application::slotDeletedObject, this, _1));
     pDoc->signalChangedObject.connect(boost::bind(&Gui::Application::slotChangedObject, this, _1, _2));
     pDoc->signalRelabelObject.connect(boost::bind(&Gui::Application::slotRelabelObject, this, _1));
@@ -730,6 +731,12 @@ void Application::slotNewObject(const ViewProvider& vp)
     this->signalNewObject(vp);
 }
 
+void Application::slotNewObjects(const std::vector<ViewProviderDocumentObject*>& vps)
+{
+    for (std::vector<ViewProviderDocumentObject*>::const_iterator it = vps.begin(); it != vps.end(); ++it)
+        this->signalNewObject(**it);
+}
+
 void Application::slotDeletedObject(const ViewProvider& vp)
 {
     this->signalDeletedObject(vp);
@@ -43,6 +43,7 @@ class MDIView;
 class MainWindow;
 class MenuItem;
 class ViewProvider;
+class ViewProviderDocumentObject;
 
 /** The Applcation main class
  * This is the central class of the GUI 
@@ -127,6 +128,7 @@ protected:
     void slotRenameDocument(const App::Document&);
     void slotActiveDocument(const App::Document&);
     void slotNewObject(const ViewProvider&);
+    void slotNewObjects(const std::vector<ViewProviderDocumentObject*>&);
     void slotDeletedObject(const ViewProvider&);
     void slotChangedObject(const ViewProvider&, const App::Property& Prop);
     void slotRelabelObject(const ViewProvider&);
@@ -83,9 +83,12 @@ struct DocumentP
     std::list<Gui::BaseView*> passiveViews;
     std::map<const App::DocumentObject*,ViewProviderDocumentObject*> _ViewProviderMap;
     std::map<std::string,ViewProvider*> _ViewProviderMapAnnotation;
+    /// objects whose changes are handled at the end of a bulk creation
+    std::map<const App::DocumentObject*, const App::Property*> _bulkChangedObjects;
 
     typedef boost::signals::connection Connection;
     Connection connectNewObject;
+    Connection connectNewObjects;
     Connection connectDelObject;
     Connection connectCngObject;
     Connection connectRenObject;
@@ -123,6 +126,8 @@ Document::Document(App::Document* pcDocument,Application * app)
     // Setup the connections
     d->connectNewObject = pcDocument->signalNewObject.connect
         (boost::bind(&Gui::Document::slotNewObject, this, _1));
+    d->connectNewObjects = pcDocument->signalNewObjects.connect
+        (boost::bind(&Gui::Document::slotNewObjects, this, _1));
     d->connectDelObject = pcDocument->signalDeletedObject.connect
         (boost::bind(&Gui::Document::slotDeletedObject, this, _1));
     d->connectCngObject = pcDocument->signalChangedObject.connect
@@ -168,6 +173,7 @@ Document::~Document()
     // disconnect everything to avoid to be double-deleted
     // in case an exception is raised somewhere
     d->connectNewObject.disconnect();
+    d->connectNewObjects.disconnect();
     d->connectDelObject.disconnect();
     d->connectCngObject.disconnect();
     d->connectRenObject.disconnect();
@@ -390,11 +396,55 @@ void Document::setPos(const char* name, const Base::Matrix4D& rclMtrx)
 void Document::slotNewObject(const App::DocumentObject& Obj)
 {
     //Base::Console().Log("Document::slotNewObject() called\n");
+    // already handled by slotNewObjects()
+    if (d->_ViewProviderMap.find(&Obj) != d->_ViewProviderMap.end())
+        return;
+
+    ViewProviderDocumentObject* pcProvider = createViewProvider(Obj);
+    if (pcProvider) {
+        // adding to the tree
+        signalNewObject(*pcProvider);
+    }
+}
+
+void Document::slotNewObjects(const std::vector<App::DocumentObject*>& objs)
+{
+    std::vector<ViewProviderDocumentObject*> views;
+    views.reserve(objs.size());
+    for (std::vector<App::DocumentObject*>::const_iterator it = objs.begin(); it != objs.end(); ++it) {
+        ViewProviderDocumentObject* pcProvider = createViewProvider(**it);
+        if (pcProvider)
+            views.push_back(pcProvider);
+    }
+
+    // the grouping could not be done while the view providers of the children were missing
+    for (std::vector<ViewProviderDocumentObject*>::iterator it = views.begin(); it != views.end(); ++it)
+        updateChildren(*it);
+
+    // adding to the tree at once
+    if (!views.empty())
+        signalNewObjects(views);
+
+    // the changes of the existing objects during the bulk creation
+    std::map<const App::DocumentObject*, const App::Property*> changed;
+    changed.swap(d->_bulkChangedObjects);
+    for (std::map<const App::DocumentObject*, const App::Property*>::iterator it = changed.begin(); it != changed.end(); ++it) {
+        ViewProvider* viewProvider = getViewProvider(it->first);
+        if (viewProvider) {
+            updateChildren(viewProvider);
+            if (viewProvider->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+                signalChangedObject(static_cast<ViewProviderDocumentObject&>(*viewProvider), *it->second);
+        }
+    }
+}
+
+ViewProviderDocumentObject* Document::createViewProvider(const App::DocumentObject& Obj)
+{
     std::string cName = Obj.getViewProviderName();
     if (cName.empty()) {
         // handle document object with no view provider specified
         Base::Console().Log("%s has no view provider specified\n", Obj.getTypeId().getName());
-        return;
+        return 0;
     }
   
     setModified(true);
@@ -430,12 +480,12 @@ void Document::slotNewObject(const App::DocumentObject& Obj)
             if (activeView)
                 activeView->getViewer()->addViewProvider(pcProvider);
         }
-    
-        // adding to the tree
-        signalNewObject(*pcProvider);
+
+        return pcProvider;
     }
     else {
         Base::Console().Warning("Gui::Document::slotNewObject() no view provider for the object %s found\n",cName.c_str());
+        return 0;
     }
 }
 
@@ -468,6 +518,7 @@ void Document::slotDeletedObject(const App::DocumentObject& Obj)
         delete viewProvider;
         d->_ViewProviderMap.erase(&Obj);
     }
+    d->_bulkChangedObjects.erase(&Obj);
 }
 
 void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Property& Prop)
@@ -491,42 +542,52 @@ void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Prop
             Base::Console().Error("Cannot update representation for '%s'.\n", Obj.getNameInDocument());
         }
 
-        // check for children 
-        if (viewProvider->getChildRoot()) {
-            std::vector<App::DocumentObject*> children = viewProvider->claimChildren3D();
-            SoGroup* childGroup =  viewProvider->getChildRoot();
+        // while objects are created in bulk the children may have no view provider yet
+        if (d->_pcDocument->isBulkCreation()) {
+            d->_bulkChangedObjects[&Obj] = &Prop;
+        }
+        else {
+            updateChildren(viewProvider);
+            if (viewProvider->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+                signalChangedObject(static_cast<ViewProviderDocumentObject&>(*viewProvider), Prop);
+        }
+    }
 
-            // size not the same -> build up the list new
-            if(childGroup->getNumChildren() != static_cast<int>(children.size())){
+    // a property of an object has changed
+    setModified(true);
+}
 
-                childGroup->removeAllChildren();
-            
-                for(std::vector<App::DocumentObject*>::iterator it=children.begin();it!=children.end();++it){
-                    ViewProvider* ChildViewProvider = getViewProvider(*it);
-                    if(ChildViewProvider) {
-                        SoSeparator* childRootNode =  ChildViewProvider->getRoot();
-                        childGroup->addChild(childRootNode);
-
-                        // cycling to all views of the document to remove the viewprovider from the viewer itself
-                        for (std::list<Gui::BaseView*>::iterator vIt = d->baseViews.begin();vIt != d->baseViews.end();++vIt) {
-                            View3DInventor *activeView = dynamic_cast<View3DInventor *>(*vIt);
-                            if (activeView && viewProvider) {
-                                if (d->_editViewProvider == ChildViewProvider)
-                                    resetEdit();
-                                activeView->getViewer()->removeViewProvider(ChildViewProvider);
-                            }
+void Document::updateChildren(ViewProvider* viewProvider)
+{
+    // check for children 
+    if (viewProvider->getChildRoot()) {
+        std::vector<App::DocumentObject*> children = viewProvider->claimChildren3D();
+        SoGroup* childGroup =  viewProvider->getChildRoot();
+
+        // size not the same -> build up the list new
+        if(childGroup->getNumChildren() != static_cast<int>(children.size())){
+
+            childGroup->removeAllChildren();
+        
+            for(std::vector<App::DocumentObject*>::iterator it=children.begin();it!=children.end();++it){
+                ViewProvider* ChildViewProvider = getViewProvider(*it);
+                if(ChildViewProvider) {
+                    SoSeparator* childRootNode =  ChildViewProvider->getRoot();
+                    childGroup->addChild(childRootNode);
+
+                    // cycling to all views of the document to remove the viewprovider from the viewer itself
+                    for (std::list<Gui::BaseView*>::iterator vIt = d->baseViews.begin();vIt != d->baseViews.end();++vIt) {
+                        View3DInventor *activeView = dynamic_cast<View3DInventor *>(*vIt);
+                        if (activeView && viewProvider) {
+                            if (d->_editViewProvider == ChildViewProvider)
+                                resetEdit();
+                            activeView->getViewer()->removeViewProvider(ChildViewProvider);
                         }
                     }
                 }
             }
         }
-
-        if (viewProvider->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
-            signalChangedObject(static_cast<ViewProviderDocumentObject&>(*viewProvider), Prop);
     }
-
-    // a property of an object has changed
-    setModified(true);
 }
 
 void Document::slotRelabelObject(const App::DocumentObject& Obj)
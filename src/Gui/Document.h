@@ -71,6 +71,8 @@ protected:
     //@{
     /// This slot is connected to the App::Document::signalNewObject(...)
     void slotNewObject(const App::DocumentObject&);
+    /// This slot is connected to the App::Document::signalNewObjects(...)
+    void slotNewObjects(const std::vector<App::DocumentObject*>&);
     void slotDeletedObject(const App::DocumentObject&);
     void slotChangedObject(const App::DocumentObject&, const App::Property&);
     void slotRelabelObject(const App::DocumentObject&);
@@ -86,6 +88,9 @@ public:
     //@{
     /// signal on new Object
     mutable boost::signal<void (const Gui::ViewProviderDocumentObject&)> signalNewObject;
+    /** signal on the objects of a bulk creation, it is given instead of
+        signalNewObject for each of them */
+    mutable boost::signal<void (const std::vector<Gui::ViewProviderDocumentObject*>&)> signalNewObjects;
     /// signal on deleted Object
     mutable boost::signal<void (const Gui::ViewProviderDocumentObject&)> signalDeletedObject;
     /** signal on changed Object, the 2nd argument is the changed property
@@ -239,6 +244,9 @@ protected:
     Gui::DocumentPy *_pcDocPy;
 
 private:
+    ViewProviderDocumentObject* createViewProvider(const App::DocumentObject&);
+    void updateChildren(ViewProvider*);
+
     struct DocumentP* d;
     static int _iDocCount;
 
@@ -375,6 +375,7 @@ DocumentModel::~DocumentModel()
 void DocumentModel::slotNewDocument(const Gui::Document& Doc)
 {
     Doc.signalNewObject.connect(boost::bind(&DocumentModel::slotNewObject, this, _1));
+    Doc.signalNewObjects.connect(boost::bind(&DocumentModel::slotNewObjects, this, _1));
     Doc.signalDeletedObject.connect(boost::bind(&DocumentModel::slotDeleteObject, this, _1));
     Doc.signalChangedObject.connect(boost::bind(&DocumentModel::slotChangeObject, this, _1, _2));
     Doc.signalRelabelObject.connect(boost::bind(&DocumentModel::slotRenameObject, this, _1));
@@ -449,6 +450,24 @@ void DocumentModel::slotNewObject(const Gui::ViewProviderDocumentObject& obj)
     }
 }
 
+void DocumentModel::slotNewObjects(const std::vector<Gui::ViewProviderDocumentObject*>& objs)
+{
+    if (objs.empty())
+        return;
+    App::Document* doc = objs.front()->getObject()->getDocument();
+    Gui::Document* gdc = Application::Instance->getDocument(doc);
+    int row = d->rootItem->findChild(*gdc);
+    if (row > -1) {
+        DocumentIndex* index = static_cast<DocumentIndex*>(d->rootItem->child(row));
+        QModelIndex parent = createIndex(index->row(),0,index);
+        int count_obj = index->childCount();
+        beginInsertRows(parent, count_obj, count_obj + static_cast<int>(objs.size()) - 1);
+        for (std::vector<Gui::ViewProviderDocumentObject*>::const_iterator it = objs.begin(); it != objs.end(); ++it)
+            index->appendChild(new ViewProviderIndex(**it, index));
+        endInsertRows();
+    }
+}
+
 void DocumentModel::slotDeleteObject(const Gui::ViewProviderDocumentObject& obj)
 {
     App::Document* doc = obj.getObject()->getDocument();
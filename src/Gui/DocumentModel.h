@@ -60,6 +60,7 @@ private:
     void slotInEdit(const Gui::ViewProviderDocumentObject& v);
     void slotResetEdit(const Gui::ViewProviderDocumentObject& v);
     void slotNewObject(const Gui::ViewProviderDocumentObject& obj);
+    void slotNewObjects(const std::vector<Gui::ViewProviderDocumentObject*>& objs);
     void slotDeleteObject(const Gui::ViewProviderDocumentObject& obj);
     void slotChangeObject(const Gui::ViewProviderDocumentObject& obj, const App::Property& Prop);
     void slotRenameObject(const Gui::ViewProviderDocumentObject& obj);
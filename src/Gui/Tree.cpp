@@ -35,6 +35,7 @@
 # include <QContextMenuEvent>
 # include <QMenu>
 # include <QPixmap>
+# include <QShowEvent>
 # include <QTimer>
 # include <QToolTip>
 # include <QHeaderView>
@@ -92,6 +93,7 @@ TreeWidget::TreeWidget(QWidget* parent)
     Application::Instance->signalRenameDocument.connect(boost::bind(&TreeWidget::slotRenameDocument, this, _1));
     Application::Instance->signalActiveDocument.connect(boost::bind(&TreeWidget::slotActiveDocument, this, _1));
     Application::Instance->signalRelabelDocument.connect(boost::bind(&TreeWidget::slotRelabelDocument, this, _1));
+    connectChangedViewObj = Application::Instance->signalChangedObject.connect(boost::bind(&TreeWidget::slotChangedViewObject, this, _1, _2));
 
     QStringList labels;
     labels << tr("Labels & Attributes");
@@ -111,7 +113,11 @@ TreeWidget::TreeWidget(QWidget* parent)
     this->setMouseTracking(true); // needed for itemEntered() to work
 #endif
 
+    // the status of the items is updated on changes of the objects only, several
+    // changes in a row are collected and handled at once when the timer fires
     this->statusTimer = new QTimer(this);
+    this->statusTimer->setSingleShot(true);
+    this->statusTimer->setInterval(100);
 
     connect(this->statusTimer, SIGNAL(timeout()), 
             this, SLOT(onTestStatus()));
@@ -124,13 +130,12 @@ TreeWidget::TreeWidget(QWidget* parent)
     connect(this, SIGNAL(itemSelectionChanged()),
             this, SLOT(onItemSelectionChanged()));
 
-    this->statusTimer->setSingleShot(true);
-    this->statusTimer->start(300);
     documentPixmap = new QPixmap(Gui::BitmapFactory().pixmap("Document"));
 }
 
 TreeWidget::~TreeWidget()
 {
+    connectChangedViewObj.disconnect();
 }
 
 void TreeWidget::contextMenuEvent (QContextMenuEvent * e)
@@ -639,17 +644,44 @@ void TreeWidget::slotActiveDocument(const Gui::Document& Doc)
 }
 
 
+void TreeWidget::scheduleStatusUpdate()
+{
+    if (!this->statusTimer->isActive())
+        this->statusTimer->start();
+}
+
 void TreeWidget::onTestStatus(void)
 {
+    // a hidden tree keeps the changed items until it is shown again
     if (isVisible()) {
         std::map<const Gui::Document*,DocumentItem*>::iterator pos;
         for (pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
             pos->second->testStatus();
         }
     }
+}
 
-    this->statusTimer->setSingleShot(true);
-    this->statusTimer->start(300);
+void TreeWidget::showEvent(QShowEvent *event)
+{
+    QTreeWidget::showEvent(event);
+    scheduleStatusUpdate();
+}
+
+void TreeWidget::slotChangedViewObject(const Gui::ViewProvider& vp, const App::Property& prop)
+{
+    if (vp.getTypeId().isDerivedFrom(ViewProviderDocumentObject::getClassTypeId())) {
+        const ViewProviderDocumentObject& vpd = static_cast<const ViewProviderDocumentObject&>(vp);
+        if (&prop != &vpd.Visibility)
+            return;
+        App::DocumentObject* obj = vpd.getObject();
+        const char* name = obj ? obj->getNameInDocument() : 0;
+        if (!name)
+            return;
+        Gui::Document* doc = Application::Instance->getDocument(obj->getDocument());
+        std::map<const Gui::Document*,DocumentItem*>::iterator it = DocumentMap.find(doc);
+        if (it != DocumentMap.end())
+            it->second->setObjectStatusChanged(name);
+    }
 }
 
 void TreeWidget::onItemEntered(QTreeWidgetItem * item)
@@ -836,6 +868,7 @@ DocumentItem::DocumentItem(const Gui::Document* doc, QTreeWidgetItem * parent)
 {
     // Setup connections
     connectNewObject = doc->signalNewObject.connect(boost::bind(&DocumentItem::slotNewObject, this, _1));
+    connectNewObjects = doc->signalNewObjects.connect(boost::bind(&DocumentItem::slotNewObjects, this, _1));
     connectDelObject = doc->signalDeletedObject.connect(boost::bind(&DocumentItem::slotDeleteObject, this, _1));
     connectChgObject = doc->signalChangedObject.connect(boost::bind(&DocumentItem::slotChangeObject, this, _1));
     connectRenObject = doc->signalRelabelObject.connect(boost::bind(&DocumentItem::slotRenameObject, this, _1));
@@ -844,6 +877,7 @@ DocumentItem::DocumentItem(const Gui::Document* doc, QTreeWidgetItem * parent)
     connectResObject = doc->signalResetEdit.connect(boost::bind(&DocumentItem::slotResetEdit, this, _1));
     connectHltObject = doc->signalHighlightObject.connect(boost::bind(&DocumentItem::slotHighlightObject, this, _1,_2,_3));
     connectExpObject = doc->signalExpandObject.connect(boost::bind(&DocumentItem::slotExpandObject, this, _1,_2));
+    connectStaObject = doc->getDocument()->signalChangedObjectStatus.connect(boost::bind(&DocumentItem::slotChangeObjectStatus, this, _1));
 
     setFlags(Qt::ItemIsEnabled/*|Qt::ItemIsEditable*/);
 }
@@ -851,6 +885,7 @@ DocumentItem::DocumentItem(const Gui::Document* doc, QTreeWidgetItem * parent)
 DocumentItem::~DocumentItem()
 {
     connectNewObject.disconnect();
+    connectNewObjects.disconnect();
     connectDelObject.disconnect();
     connectChgObject.disconnect();
     connectRenObject.disconnect();
@@ -859,6 +894,7 @@ DocumentItem::~DocumentItem()
     connectResObject.disconnect();
     connectHltObject.disconnect();
     connectExpObject.disconnect();
+    connectStaObject.disconnect();
 }
 
 void DocumentItem::slotInEdit(const Gui::ViewProviderDocumentObject& v)
@@ -890,11 +926,38 @@ void DocumentItem::slotNewObject(const Gui::ViewProviderDocumentObject& obj)
         item->setIcon(0, obj.getIcon());
         item->setText(0, QString::fromUtf8(displayName.c_str()));
         ObjectMap[objectName] = item;
+        setObjectStatusChanged(objectName.c_str());
     } else {
         Base::Console().Warning("DocumentItem::slotNewObject: Cannot add view provider twice.\n");
     }
 }
 
+void DocumentItem::slotNewObjects(const std::vector<Gui::ViewProviderDocumentObject*>& objs)
+{
+    QList<QTreeWidgetItem*> items;
+    std::vector<Gui::ViewProviderDocumentObject*> added;
+    for (std::vector<Gui::ViewProviderDocumentObject*>::const_iterator it = objs.begin(); it != objs.end(); ++it) {
+        App::DocumentObject* obj = (*it)->getObject();
+        std::string objectName = obj->getNameInDocument();
+        if (ObjectMap.find(objectName) == ObjectMap.end()) {
+            DocumentObjectItem* item = new DocumentObjectItem(*it, 0);
+            item->setIcon(0, (*it)->getIcon());
+            item->setText(0, QString::fromUtf8(obj->Label.getValue()));
+            ObjectMap[objectName] = item;
+            items << item;
+            added.push_back(*it);
+        } else {
+            Base::Console().Warning("DocumentItem::slotNewObjects: Cannot add view provider twice.\n");
+        }
+    }
+
+    this->addChildren(items);
+
+    // now that all items exist they can be moved to their parents
+    for (std::vector<Gui::ViewProviderDocumentObject*>::iterator it = added.begin(); it != added.end(); ++it)
+        slotChangeObject(**it);
+}
+
 void DocumentItem::slotDeleteObject(const Gui::ViewProviderDocumentObject& view)
 {
     App::DocumentObject* obj = view.getObject();
@@ -930,6 +993,7 @@ void DocumentItem::slotDeleteObject(const Gui::ViewProviderDocumentObject& view)
         }
 
         parent->takeChild(parent->indexOfChild(it->second));
+        ChangedItems.erase(it->second);
         delete it->second;
         ObjectMap.erase(it);
     }
@@ -987,6 +1051,7 @@ void DocumentItem::slotChangeObject(const Gui::ViewProviderDocumentObject& view)
         // set the text label
         std::string displayName = obj->Label.getValue();
         it->second->setText(0, QString::fromUtf8(displayName.c_str()));
+        setObjectStatusChanged(objectName.c_str());
     }
     else {
         Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot change unknown object.\n");
@@ -1086,10 +1151,30 @@ const Gui::Document* DocumentItem::document() const
 //    }
 //}
 
+void DocumentItem::slotChangeObjectStatus(const App::DocumentObject& obj)
+{
+    const char* name = obj.getNameInDocument();
+    if (name)
+        setObjectStatusChanged(name);
+}
+
+void DocumentItem::setObjectStatusChanged(const char* name)
+{
+    std::map<std::string,DocumentObjectItem*>::iterator it = ObjectMap.find(name);
+    if (it != ObjectMap.end()) {
+        ChangedItems.insert(it->second);
+        TreeWidget* tree = static_cast<TreeWidget*>(treeWidget());
+        if (tree)
+            tree->scheduleStatusUpdate();
+    }
+}
+
 void DocumentItem::testStatus(void)
 {
-    for (std::map<std::string,DocumentObjectItem*>::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
-        pos->second->testStatus();
+    std::set<DocumentObjectItem*> items;
+    items.swap(ChangedItems);
+    for (std::set<DocumentObjectItem*>::iterator pos = items.begin();pos!=items.end();++pos) {
+        (*pos)->testStatus();
     }
 }
 
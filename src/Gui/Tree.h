@@ -35,6 +35,7 @@
 
 namespace Gui {
 
+class ViewProvider;
 class ViewProviderDocumentObject;
 class DocumentObjectItem;
 class DocumentItem;
@@ -72,6 +73,8 @@ public:
     static const int ObjectType;
 
     void markItem(const App::DocumentObject* Obj,bool mark);
+    /// updates the status of the changed items the next time the event loop is idle
+    void scheduleStatusUpdate();
 
 protected:
     /// Observer message from the Selection
@@ -93,6 +96,7 @@ protected:
     bool event(QEvent *e);
     void keyPressEvent(QKeyEvent *event);
     void mouseDoubleClickEvent(QMouseEvent * event);
+    void showEvent(QShowEvent *event);
 
 protected Q_SLOTS:
     void onCreateGroup();
@@ -114,6 +118,7 @@ private:
     void slotRenameDocument(const Gui::Document&);
     void slotActiveDocument(const Gui::Document&);
     void slotRelabelDocument(const Gui::Document&);
+    void slotChangedViewObject(const Gui::ViewProvider&, const App::Property&);
 
     void changeEvent(QEvent *e);
 
@@ -128,6 +133,7 @@ private:
     static QPixmap* documentPixmap;
     std::map<const Gui::Document*,DocumentItem*> DocumentMap;
     bool fromOutside;
+    boost::BOOST_SIGNALS_NAMESPACE::connection connectChangedViewObj;
 };
 
 /** The link between the tree and a document.
@@ -147,7 +153,10 @@ public:
     void clearSelection(void);
     void updateSelection(void);
     void selectItems(void);
+    /// updates the status icons of all items that were marked as changed
     void testStatus(void);
+    /// marks the item of the object \a name to update its status
+    void setObjectStatusChanged(const char* name);
     void setData(int column, int role, const QVariant & value);
 
 protected:
@@ -155,6 +164,9 @@ protected:
      * If this view provider is already added nothing happens.
      */
     void slotNewObject(const Gui::ViewProviderDocumentObject&);
+    /** Adds the view providers of a bulk creation to the document item at once.
+     */
+    void slotNewObjects(const std::vector<Gui::ViewProviderDocumentObject*>&);
     /** Removes a view provider from the document item.
      * If this view provider is not added nothing happens.
      */
@@ -166,14 +178,17 @@ protected:
     void slotResetEdit       (const Gui::ViewProviderDocumentObject&);
     void slotHighlightObject (const Gui::ViewProviderDocumentObject&,const Gui::HighlightMode&,bool);
     void slotExpandObject    (const Gui::ViewProviderDocumentObject&,const Gui::TreeItemMode&);
+    void slotChangeObjectStatus(const App::DocumentObject&);
     std::vector<DocumentObjectItem*> getAllParents(DocumentObjectItem*) const;
 
 private:
     const Gui::Document* pDocument;
     std::map<std::string,DocumentObjectItem*> ObjectMap;
+    std::set<DocumentObjectItem*> ChangedItems;
 
     typedef boost::BOOST_SIGNALS_NAMESPACE::connection Connection;
     Connection connectNewObject;
+    Connection connectNewObjects;
     Connection connectDelObject;
     Connection connectChgObject;
     Connection connectRenObject;
@@ -182,6 +197,7 @@ private:
     Connection connectResObject;
     Connection connectHltObject;
     Connection connectExpObject;
+    Connection connectStaObject;
 };
 
 /** The link between the tree and a document object.
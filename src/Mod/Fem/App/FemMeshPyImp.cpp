@@ -463,7 +463,15 @@ PyObject* FemMeshPy::read(PyObject *args)
     PyMem_Free(Name);
 
     try {
-        getFemMeshPtr()->read(EncodedName.c_str());
+        Base::Reference<FemMesh> mesh(getFemMeshPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->read(EncodedName.c_str());
+    }
+    catch (const Base::Exception& e) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
+        return 0;
     }
     catch (const std::exception& e) {
         PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
@@ -481,7 +489,15 @@ PyObject* FemMeshPy::write(PyObject *args)
     PyMem_Free(Name);
 
     try {
-        getFemMeshPtr()->write(EncodedName.c_str());
+        Base::Reference<FemMesh> mesh(getFemMeshPtr());
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        mesh->write(EncodedName.c_str());
+    }
+    catch (const Base::Exception& e) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
+        return 0;
     }
     catch (const std::exception& e) {
         PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
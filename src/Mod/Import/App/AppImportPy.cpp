@@ -28,6 +28,7 @@
 #ifndef _PreComp_
 # include <Python.h>
 # include <climits>
+# include <memory>
 # include <Standard_Version.hxx>
 # include <Handle_TDocStd_Document.hxx>
 # include <Handle_XCAFApp_Application.hxx>
@@ -87,6 +88,7 @@ static PyObject * importer(PyObject *self, PyObject *args)
         Handle(XCAFApp_Application) hApp = XCAFApp_Application::GetApplication();
         Handle(TDocStd_Document) hDoc;
         hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
+        Import::ImportStage::clear();
 
         if (file.hasExtension("stp") || file.hasExtension("step")) {
             try {
@@ -94,11 +96,19 @@ static PyObject * importer(PyObject *self, PyObject *args)
                 aReader.SetColorMode(true);
                 aReader.SetNameMode(true);
                 aReader.SetLayerMode(true);
-                if (aReader.ReadFile((Standard_CString)(name8bit.c_str())) != IFSelect_RetDone) {
+                IFSelect_ReturnStatus status;
+                {
+                    Import::ImportStage stage("parse");
+                    status = aReader.ReadFile((Standard_CString)(name8bit.c_str()));
+                }
+                if (status != IFSelect_RetDone) {
                     PyErr_SetString(Base::BaseExceptionFreeCADError, "cannot read STEP file");
                     return 0;
                 }
 
+                // the roots are transferred sequentially because the transfer
+                // process of a work session is not reentrant
+                Import::ImportStage stage("transfer");
                 Handle_Message_ProgressIndicator pi = new Part::ProgressIndicator(100);
                 aReader.Reader().WS()->MapReader()->SetProgress(pi);
                 pi->NewScope(100, "Reading STEP file...");
@@ -128,11 +138,17 @@ static PyObject * importer(PyObject *self, PyObject *args)
                 aReader.SetColorMode(true);
                 aReader.SetNameMode(true);
                 aReader.SetLayerMode(true);
-                if (aReader.ReadFile((Standard_CString)(name8bit.c_str())) != IFSelect_RetDone) {
+                IFSelect_ReturnStatus status;
+                {
+                    Import::ImportStage stage("parse");
+                    status = aReader.ReadFile((Standard_CString)(name8bit.c_str()));
+                }
+                if (status != IFSelect_RetDone) {
                     PyErr_SetString(Base::BaseExceptionFreeCADError, "cannot read IGES file");
                     return 0;
                 }
 
+                Import::ImportStage stage("transfer");
                 Handle_Message_ProgressIndicator pi = new Part::ProgressIndicator(100);
                 aReader.WS()->MapReader()->SetProgress(pi);
                 pi->NewScope(100, "Reading IGES file...");
@@ -154,13 +170,16 @@ static PyObject * importer(PyObject *self, PyObject *args)
             return 0;
         }
 
+        {
+            Import::ImportStage stage("create");
 #if 1
-        Import::ImportOCAF ocaf(hDoc, pcDoc, file.fileNamePure());
-        ocaf.loadShapes();
+            Import::ImportOCAF ocaf(hDoc, pcDoc, file.fileNamePure());
+            ocaf.loadShapes();
 #else
-        Import::ImportXCAF xcaf(hDoc, pcDoc, file.fileNamePure());
-        xcaf.loadShapes();
+            Import::ImportXCAF xcaf(hDoc, pcDoc, file.fileNamePure());
+            xcaf.loadShapes();
 #endif
+        }
         pcDoc->recompute();
 
     }
@@ -194,7 +213,9 @@ static PyObject * exporter(PyObject *self, PyObject *args)
         Handle(TDocStd_Document) hDoc;
         hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
         Import::ExportOCAF ocaf(hDoc);
+        Import::ImportStage::clear();
 
+        std::auto_ptr<Import::ImportStage> collect(new Import::ImportStage("collect"));
         Py::Sequence list(object);
         for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
             PyObject* item = (*it).ptr();
@@ -228,11 +249,16 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             }
         }
 
+        collect.reset();
+
         Base::FileInfo file(Utf8Name.c_str());
         if (file.hasExtension("stp") || file.hasExtension("step")) {
             //Interface_Static::SetCVal("write.step.schema", "AP214IS");
             STEPCAFControl_Writer writer;
-            writer.Transfer(hDoc, STEPControl_AsIs);
+            {
+                Import::ImportStage stage("transfer");
+                writer.Transfer(hDoc, STEPControl_AsIs);
+            }
 
             // edit STEP header
 #if OCC_VERSION_HEX >= 0x060500
@@ -248,6 +274,7 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             makeHeader.SetOrganizationValue (1, new TCollection_HAsciiString(hGrp->GetASCII("Company").c_str()));
             makeHeader.SetOriginatingSystem(new TCollection_HAsciiString(App::GetApplication().getExecutableName()));
             makeHeader.SetDescriptionValue(1, new TCollection_HAsciiString("FreeCAD Model"));
+            Import::ImportStage stage("write");
             IFSelect_ReturnStatus ret = writer.Write(name8bit.c_str());
             if (ret == IFSelect_RetError || ret == IFSelect_RetFail || ret == IFSelect_RetStop) {
                 PyErr_Format(PyExc_IOError, "Cannot open file '%s'", Utf8Name.c_str());
@@ -262,7 +289,11 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             header.SetCompanyName(new TCollection_HAsciiString(Interface_Static::CVal("write.iges.header.company")));
             header.SetSendName(new TCollection_HAsciiString(Interface_Static::CVal("write.iges.header.product")));
             writer.Model()->SetGlobalSection(header);
-            writer.Transfer(hDoc);
+            {
+                Import::ImportStage stage("transfer");
+                writer.Transfer(hDoc);
+            }
+            Import::ImportStage stage("write");
             Standard_Boolean ret = writer.Write(name8bit.c_str());
             if (!ret) {
                 PyErr_Format(PyExc_IOError, "Cannot open file '%s'", Utf8Name.c_str());
@@ -280,6 +311,24 @@ static PyObject * exporter(PyObject *self, PyObject *args)
     Py_Return;
 }
 
+static PyObject * stageTimes(PyObject *self, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        Py::List list;
+        const std::vector<std::pair<std::string, float> >& times = Import::ImportStage::times();
+        for (std::vector<std::pair<std::string, float> >::const_iterator it = times.begin(); it != times.end(); ++it) {
+            Py::Tuple item(2);
+            item.setItem(0, Py::String(it->first));
+            item.setItem(1, Py::Float(it->second));
+            list.append(item);
+        }
+        return Py::new_reference_to(list);
+    } PY_CATCH
+}
+
 /* registration table  */
 struct PyMethodDef Import_Import_methods[] = {
     {"open"     ,open  ,METH_VARARGS,
@@ -288,5 +337,7 @@ struct PyMethodDef Import_Import_methods[] = {
      "insert(string,string) -- Insert the file into the given document."},
     {"export"     ,exporter  ,METH_VARARGS,
      "export(list,string) -- Export a list of objects into a single file."},
+    {"stageTimes" ,stageTimes ,METH_VARARGS,
+     "stageTimes() -- The names and times in seconds of the stages of the last import or export."},
     {NULL, NULL}                   /* end of table marker */
 };
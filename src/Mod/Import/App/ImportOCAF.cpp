@@ -80,6 +80,34 @@ using namespace Import;
 
 #define OCAF_KEEP_PLACEMENT
 
+namespace {
+std::vector<std::pair<std::string, float> > stageTimes;
+}
+
+ImportStage::ImportStage(const char* name)
+    : name(name), profile("import", name)
+{
+}
+
+ImportStage::~ImportStage()
+{
+    float seconds = Base::TimeInfo::diffTimeF(start);
+    stageTimes.push_back(std::make_pair(name, seconds));
+    Base::Console().Log("Import: %s took %.3f s\n", name.c_str(), seconds);
+}
+
+void ImportStage::clear()
+{
+    stageTimes.clear();
+}
+
+const std::vector<std::pair<std::string, float> >& ImportStage::times()
+{
+    return stageTimes;
+}
+
+// ----------------------------------------------------------------------------
+
 ImportOCAF::ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name)
     : pDoc(h), doc(d), default_name(name)
 {
@@ -94,7 +122,25 @@ ImportOCAF::~ImportOCAF()
 void ImportOCAF::loadShapes()
 {
     myRefShapes.clear();
-    loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false);
+    myColorMap.clear();
+    myShapeColors.clear();
+    // announce the imported parts all at once
+    doc->beginBulkCreation();
+    try {
+        loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false);
+        tessellate(getShapes());
+    }
+    catch (...) {
+        myColorMap.clear();
+        doc->endBulkCreation();
+        throw;
+    }
+    doc->endBulkCreation();
+
+    // the view providers exist only after the bulk creation
+    for (std::map<Part::Feature*, std::vector<App::Color> >::iterator it = myColorMap.begin(); it != myColorMap.end(); ++it)
+        applyColors(it->first, it->second);
+    myColorMap.clear();
 }
 
 void ImportOCAF::loadShapes(const TDF_Label& label, const TopLoc_Location& loc, const std::string& defaultname, const std::string& assembly, bool isRef)
@@ -215,6 +261,36 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         part->Shape.setValue(aShape);
     part->Label.setValue(name);
 
+    // all instances of a referenced shape share its geometry and colors
+    std::vector<App::Color> colors;
+    const TopoDS_TShape* tshape = aShape.TShape().operator->();
+    std::map<const TopoDS_TShape*, ShapeColors>::iterator it = myShapeColors.find(tshape);
+    if (it != myShapeColors.end() && it->second.shape.IsEqual(aShape)) {
+        colors = it->second.colors;
+    }
+    else {
+        colors = getColors(aShape);
+        ShapeColors& entry = myShapeColors[tshape];
+        entry.shape = aShape;
+        entry.colors = colors;
+    }
+
+    if (!colors.empty())
+        myColorMap[part] = colors;
+}
+
+std::vector<TopoDS_Shape> ImportOCAF::getShapes() const
+{
+    std::vector<TopoDS_Shape> shapes;
+    shapes.reserve(myShapeColors.size());
+    for (std::map<const TopoDS_TShape*, ShapeColors>::const_iterator it = myShapeColors.begin(); it != myShapeColors.end(); ++it)
+        shapes.push_back(it->second.shape);
+    return shapes;
+}
+
+std::vector<App::Color> ImportOCAF::getColors(const TopoDS_Shape& aShape) const
+{
+    std::vector<App::Color> colors;
     Quantity_Color aColor;
     App::Color color(0.8f,0.8f,0.8f);
     if (aColorTool->GetColor(aShape, XCAFDoc_ColorGen, aColor) ||
@@ -223,18 +299,7 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         color.r = (float)aColor.Red();
         color.g = (float)aColor.Green();
         color.b = (float)aColor.Blue();
-        std::vector<App::Color> colors;
         colors.push_back(color);
-        applyColors(part, colors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPart::getClassTypeId())) {
-            color.r = aColor.Red();
-            color.g = aColor.Green();
-            color.b = aColor.Blue();
-            static_cast<PartGui::ViewProviderPart*>(vp)->ShapeColor.setValue(color);
-        }
-#endif
     }
 
     TopTools_IndexedMapOfShape faces;
@@ -261,15 +326,9 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         xp.Next();
     }
 
-    if (found_face_color) {
-        applyColors(part, faceColors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPartExt::getClassTypeId())) {
-            static_cast<PartGui::ViewProviderPartExt*>(vp)->DiffuseColor.setValues(faceColors);
-        }
-#endif
-    }
+    if (found_face_color)
+        return faceColors;
+    return colors;
 }
 
 // ----------------------------------------------------------------------------
@@ -298,6 +357,15 @@ void ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& c
     // http://www.opencascade.org/org/forum/thread_18813/?forum=3
     TopLoc_Location aLoc = shape.Location();
     TopoDS_Shape baseShape = shape.Located(TopLoc_Location());
+
+    // instances of an already written shape with the same colors are only placed
+    const TopoDS_TShape* tshape = baseShape.TShape().operator->();
+    std::map<const TopoDS_TShape*, ShapeLabel>::iterator it = myShapeLabels.find(tshape);
+    if (it != myShapeLabels.end() && it->second.orientation == baseShape.Orientation() &&
+        it->second.colors == colors) {
+        aShapeTool->AddComponent(rootLabel, it->second.label, aLoc);
+        return;
+    }
 #else
     TopoDS_Shape baseShape = shape;
 #endif
@@ -310,6 +378,12 @@ void ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& c
 
 #if defined(OCAF_KEEP_PLACEMENT)
     aShapeTool->AddComponent(rootLabel, shapeLabel, aLoc);
+    if (it == myShapeLabels.end()) {
+        ShapeLabel& entry = myShapeLabels[tshape];
+        entry.label = shapeLabel;
+        entry.orientation = baseShape.Orientation();
+        entry.colors = colors;
+    }
 #endif
 
     // Add color information
@@ -35,6 +35,8 @@
 #include <map>
 #include <vector>
 #include <App/Material.h>
+#include <Base/Profiler.h>
+#include <Base/TimeInfo.h>
 
 class TDF_Label;
 class TopLoc_Location;
@@ -49,18 +51,46 @@ class Feature;
 
 namespace Import {
 
+/**
+ * ImportStage measures a stage of an import or export, like parsing the file or
+ * creating the document objects, from its construction until its destruction.
+ * The time is written to the log, kept for times() and recorded by the profiler
+ * while this is enabled.
+ */
+class ImportExport ImportStage
+{
+public:
+    ImportStage(const char* name);
+    ~ImportStage();
+
+    /// removes the times of the stages measured so far
+    static void clear();
+    /// the name and time in seconds of each stage since the last clear()
+    static const std::vector<std::pair<std::string, float> >& times();
+
+private:
+    std::string name;
+    Base::TimeInfo start;
+    Base::ProfileScope profile;
+};
+
 class ImportExport ImportOCAF
 {
 public:
     ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name);
     virtual ~ImportOCAF();
     void loadShapes();
+    /// the shapes of the created features without their instances
+    std::vector<TopoDS_Shape> getShapes() const;
 
 private:
     void loadShapes(const TDF_Label& label, const TopLoc_Location&, const std::string& partname, const std::string& assembly, bool isRef);
     void createShape(const TDF_Label& label, const TopLoc_Location&, const std::string&);
     void createShape(const TopoDS_Shape& label, const TopLoc_Location&, const std::string&);
+    std::vector<App::Color> getColors(const TopoDS_Shape&) const;
     virtual void applyColors(Part::Feature*, const std::vector<App::Color>&){}
+    // called with the created shapes before their features are announced
+    virtual void tessellate(const std::vector<TopoDS_Shape>&){}
 
 private:
     Handle_TDocStd_Document pDoc;
@@ -69,6 +99,13 @@ private:
     Handle_XCAFDoc_ColorTool aColorTool;
     std::string default_name;
     std::set<int> myRefShapes;
+    std::map<Part::Feature*, std::vector<App::Color> > myColorMap;
+    // the colors of each created shape which are looked up only once for all its instances
+    struct ShapeColors {
+        TopoDS_Shape shape;
+        std::vector<App::Color> colors;
+    };
+    std::map<const TopoDS_TShape*, ShapeColors> myShapeColors;
     static const int HashUpper = INT_MAX;
 };
 
@@ -83,6 +120,14 @@ private:
     Handle_XCAFDoc_ShapeTool aShapeTool;
     Handle_XCAFDoc_ColorTool aColorTool;
     TDF_Label rootLabel;
+
+    // the label of each written shape to place further instances of it
+    struct ShapeLabel {
+        TDF_Label label;
+        TopAbs_Orientation orientation;
+        std::vector<App::Color> colors;
+    };
+    std::map<const TopoDS_TShape*, ShapeLabel> myShapeLabels;
 };
 
 
@@ -28,6 +28,7 @@
 #ifndef _PreComp_
 # include <Python.h>
 # include <climits>
+# include <memory>
 # include <QString>
 # include <Standard_Version.hxx>
 # include <BRep_Builder.hxx>
@@ -100,6 +101,12 @@ private:
             static_cast<PartGui::ViewProviderPartExt*>(vp)->DiffuseColor.setValues(colors);
         }
     }
+    void tessellate(const std::vector<TopoDS_Shape>& shapes)
+    {
+        // the view providers only build their visuals from the existing meshes
+        Import::ImportStage stage("tessellate");
+        PartGui::ViewProviderPartExt::tessellate(shapes);
+    }
 };
 
 /* module functions */
@@ -129,6 +136,7 @@ static PyObject * importer(PyObject *self, PyObject *args)
         Handle(XCAFApp_Application) hApp = XCAFApp_Application::GetApplication();
         Handle(TDocStd_Document) hDoc;
         hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
+        Import::ImportStage::clear();
 
         if (file.hasExtension("stp") || file.hasExtension("step")) {
             try {
@@ -136,11 +144,17 @@ static PyObject * importer(PyObject *self, PyObject *args)
                 aReader.SetColorMode(true);
                 aReader.SetNameMode(true);
                 aReader.SetLayerMode(true);
-                if (aReader.ReadFile((const char*)name8bit.c_str()) != IFSelect_RetDone) {
+                IFSelect_ReturnStatus status;
+                {
+                    Import::ImportStage stage("parse");
+                    status = aReader.ReadFile((const char*)name8bit.c_str());
+                }
+                if (status != IFSelect_RetDone) {
                     PyErr_SetString(Base::BaseExceptionFreeCADError, "cannot read STEP file");
                     return 0;
                 }
 
+                Import::ImportStage stage("transfer");
                 Handle_Message_ProgressIndicator pi = new Part::ProgressIndicator(100);
                 aReader.Reader().WS()->MapReader()->SetProgress(pi);
                 pi->NewScope(100, "Reading STEP file...");
@@ -170,11 +184,17 @@ static PyObject * importer(PyObject *self, PyObject *args)
                 aReader.SetColorMode(true);
                 aReader.SetNameMode(true);
                 aReader.SetLayerMode(true);
-                if (aReader.ReadFile((const char*)name8bit.c_str()) != IFSelect_RetDone) {
+                IFSelect_ReturnStatus status;
+                {
+                    Import::ImportStage stage("parse");
+                    status = aReader.ReadFile((const char*)name8bit.c_str());
+                }
+                if (status != IFSelect_RetDone) {
                     PyErr_SetString(Base::BaseExceptionFreeCADError, "cannot read IGES file");
                     return 0;
                 }
 
+                Import::ImportStage stage("transfer");
                 Handle_Message_ProgressIndicator pi = new Part::ProgressIndicator(100);
                 aReader.WS()->MapReader()->SetProgress(pi);
                 pi->NewScope(100, "Reading IGES file...");
@@ -196,8 +216,12 @@ static PyObject * importer(PyObject *self, PyObject *args)
             return 0;
         }
 
-        ImportOCAFExt ocaf(hDoc, pcDoc, file.fileNamePure());
-        ocaf.loadShapes();
+        {
+            // includes the tessellation of the new shapes
+            Import::ImportStage stage("create");
+            ImportOCAFExt ocaf(hDoc, pcDoc, file.fileNamePure());
+            ocaf.loadShapes();
+        }
         pcDoc->recompute();
     }
     catch (Standard_Failure) {
@@ -230,7 +254,9 @@ static PyObject * exporter(PyObject *self, PyObject *args)
         Handle(TDocStd_Document) hDoc;
         hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
         Import::ExportOCAF ocaf(hDoc);
+        Import::ImportStage::clear();
 
+        std::auto_ptr<Import::ImportStage> collect(new Import::ImportStage("collect"));
         Py::Sequence list(object);
         for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
             PyObject* item = (*it).ptr();
@@ -253,11 +279,16 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             }
         }
 
+        collect.reset();
+
         Base::FileInfo file(Utf8Name.c_str());
         if (file.hasExtension("stp") || file.hasExtension("step")) {
             //Interface_Static::SetCVal("write.step.schema", "AP214IS");
             STEPCAFControl_Writer writer;
-            writer.Transfer(hDoc, STEPControl_AsIs);
+            {
+                Import::ImportStage stage("transfer");
+                writer.Transfer(hDoc, STEPControl_AsIs);
+            }
 
             // edit STEP header
 #if OCC_VERSION_HEX >= 0x060500
@@ -273,6 +304,7 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             makeHeader.SetOrganizationValue (1, new TCollection_HAsciiString(hGrp->GetASCII("Company").c_str()));
             makeHeader.SetOriginatingSystem(new TCollection_HAsciiString(App::GetApplication().getExecutableName()));
             makeHeader.SetDescriptionValue(1, new TCollection_HAsciiString("FreeCAD Model"));
+            Import::ImportStage stage("write");
             IFSelect_ReturnStatus ret = writer.Write((const char*)name8bit.c_str());
             if (ret == IFSelect_RetError || ret == IFSelect_RetFail || ret == IFSelect_RetStop) {
                 PyErr_Format(PyExc_IOError, "Cannot open file '%s'", Utf8Name.c_str());
@@ -287,7 +319,11 @@ static PyObject * exporter(PyObject *self, PyObject *args)
             header.SetCompanyName(new TCollection_HAsciiString(Interface_Static::CVal("write.iges.header.company")));
             header.SetSendName(new TCollection_HAsciiString(Interface_Static::CVal("write.iges.header.product")));
             writer.Model()->SetGlobalSection(header);
-            writer.Transfer(hDoc);
+            {
+                Import::ImportStage stage("transfer");
+                writer.Transfer(hDoc);
+            }
+            Import::ImportStage stage("write");
             Standard_Boolean ret = writer.Write((const char*)name8bit.c_str());
             if (!ret) {
                 PyErr_Format(PyExc_IOError, "Cannot open file '%s'", Utf8Name.c_str());
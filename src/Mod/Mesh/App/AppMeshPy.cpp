@@ -27,6 +27,7 @@
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
@@ -41,6 +42,7 @@
 #include "Core/Evaluation.h"
 #include "Core/Iterator.h"
 #include "Core/Approximation.h"
+#include "Core/MappedKernel.h"
 
 #include "MeshPy.h"
 #include "Mesh.h"
@@ -497,6 +499,92 @@ polynomialFit(PyObject *self, PyObject *args)
     } PY_CATCH;
 }
 
+static PyObject *
+createMapped(PyObject *self, PyObject *args)
+{
+    PyObject *input;
+    char* Name;
+    PyObject *compact=Py_True;
+    if (!PyArg_ParseTuple(args, "Oet|O!",&input,"utf-8",&Name,&PyBool_Type,&compact))
+        return NULL;
+    std::string EncodedName = std::string(Name);
+    PyMem_Free(Name);
+
+    PY_TRY {
+        bool ok;
+        if (PyObject_TypeCheck(input, &(MeshPy::Type))) {
+            const MeshObject* mesh = static_cast<MeshPy*>(input)->getMeshObjectPtr();
+            ok = MappedMeshKernel::Create(EncodedName, mesh->getKernel(), PyObject_IsTrue(compact) ? true : false);
+        }
+        else if (PyString_Check(input) || PyUnicode_Check(input)) {
+            Base::FileInfo fi((std::string)Py::String(input).encoding("utf-8"));
+            Base::ifstream str(fi, std::ios::in | std::ios::binary);
+            if (!str)
+                throw Base::FileException("Cannot open file", fi);
+            ok = MappedMeshKernel::CreateFromBinarySTL(EncodedName, str, PyObject_IsTrue(compact) ? true : false);
+        }
+        else {
+            PyErr_SetString(PyExc_TypeError, "Mesh or file name of a binary STL file expected");
+            return NULL;
+        }
+
+        if (!ok) {
+            PyErr_SetString(Base::BaseExceptionFreeCADError, "Creation of mapped mesh failed");
+            return NULL;
+        }
+    } PY_CATCH;
+
+    Py_Return;
+}
+
+static PyObject *
+readMapped(PyObject *self, PyObject *args)
+{
+    char* Name;
+    char* STLName=0;
+    if (!PyArg_ParseTuple(args, "et|et","utf-8",&Name,"utf-8",&STLName))
+        return NULL;
+    std::string EncodedName = std::string(Name);
+    PyMem_Free(Name);
+    std::string EncodedSTLName;
+    if (STLName) {
+        EncodedSTLName = STLName;
+        PyMem_Free(STLName);
+    }
+
+    PY_TRY {
+        MappedMeshKernel kernel;
+        if (!kernel.Open(EncodedName)) {
+            PyErr_SetString(Base::BaseExceptionFreeCADError, "Not a mapped mesh file");
+            return NULL;
+        }
+
+        if (!EncodedSTLName.empty()) {
+            Base::FileInfo fi(EncodedSTLName);
+            Base::ofstream str(fi, std::ios::out | std::ios::binary);
+            if (!str || !kernel.SaveBinarySTL(str))
+                throw Base::FileException("Cannot write file", fi);
+        }
+
+        Py::Dict dict;
+        dict.setItem(Py::String("CountPoints"), Py::Int((long)kernel.CountPoints()));
+        dict.setItem(Py::String("CountFacets"), Py::Int((long)kernel.CountFacets()));
+        dict.setItem(Py::String("CompactIndices"), Py::Boolean(kernel.HasCompactIndices()));
+        const Base::BoundBox3f& bbox = kernel.GetBoundBox();
+        Py::Tuple box(6);
+        box.setItem(0, Py::Float(bbox.MinX));
+        box.setItem(1, Py::Float(bbox.MinY));
+        box.setItem(2, Py::Float(bbox.MinZ));
+        box.setItem(3, Py::Float(bbox.MaxX));
+        box.setItem(4, Py::Float(bbox.MaxY));
+        box.setItem(5, Py::Float(bbox.MaxZ));
+        dict.setItem(Py::String("BoundBox"), box);
+        dict.setItem(Py::String("Area"), Py::Float(kernel.GetSurface()));
+        dict.setItem(Py::String("Volume"), Py::Float(kernel.GetVolume()));
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
 
 PyDoc_STRVAR(open_doc,
 "open(string) -- Create a new document and a Mesh::Import feature to load the file into the document.");
@@ -519,6 +607,20 @@ PyDoc_STRVAR(polynomialFit_doc,
 "polynomialFit(seq(Base.Vector)) -- Calculates a polynomial fit.\n"
 );
 
+PyDoc_STRVAR(createMapped_doc,
+"createMapped(mesh|string, string, [compact=True]) -- Writes a mesh or a binary STL file to\n"
+"a file which can be memory mapped with readMapped().\n"
+"The facets of an STL file are converted without loading them into a mesh.\n"
+"If compact is True the point indices are stored with 32 bits if possible.\n"
+);
+
+PyDoc_STRVAR(readMapped_doc,
+"readMapped(string, [string]) -- Maps a file written by createMapped() and returns a dict with\n"
+"the number of points and facets, the bounding box, area and volume.\n"
+"The mesh is not loaded into memory. If a second file name is given the facets are\n"
+"written to it as binary STL.\n"
+);
+
 /* List of functions defined in the module */
 
 struct PyMethodDef Mesh_Import_methods[] = { 
@@ -536,5 +638,7 @@ struct PyMethodDef Mesh_Import_methods[] = {
     {"createTorus",createTorus, Py_NEWARGS,   "Create a tessellated torus"},
     {"calculateEigenTransform",calculateEigenTransform, METH_VARARGS,   calculateEigenTransform_doc},
     {"polynomialFit",polynomialFit, METH_VARARGS,   polynomialFit_doc},
+    {"createMapped",createMapped, METH_VARARGS,   createMapped_doc},
+    {"readMapped",readMapped, METH_VARARGS,   readMapped_doc},
     {NULL, NULL}  /* sentinel */
 };
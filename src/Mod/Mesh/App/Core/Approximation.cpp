@@ -794,6 +794,105 @@ void SurfaceFit::GetCoefficients(double& a,double& b,double& c,double& d,double&
 
 // -----------------------------------------------------------------------------
 
+IncrementalPlaneFit::IncrementalPlaneFit()
+{
+    Clear();
+}
+
+void IncrementalPlaneFit::Clear()
+{
+    for (int i=0; i<3; i++)
+        _dSum[i] = 0.0;
+    for (int i=0; i<6; i++)
+        _dSumSq[i] = 0.0;
+    _ulCount = 0;
+    _bIsFitted = false;
+    _bValid = false;
+}
+
+void IncrementalPlaneFit::AddPoint(const Base::Vector3f& rcPoint)
+{
+    if (_ulCount == 0)
+        _vOrigin = rcPoint;
+
+    double x = rcPoint.x - _vOrigin.x;
+    double y = rcPoint.y - _vOrigin.y;
+    double z = rcPoint.z - _vOrigin.z;
+    _dSum[0] += x; _dSum[1] += y; _dSum[2] += z;
+    _dSumSq[0] += x * x; _dSumSq[1] += x * y; _dSumSq[2] += x * z;
+    _dSumSq[3] += y * y; _dSumSq[4] += y * z; _dSumSq[5] += z * z;
+    _ulCount++;
+    _bIsFitted = false;
+}
+
+bool IncrementalPlaneFit::Fit()
+{
+    _bIsFitted = true;
+    _bValid = false;
+    if (_ulCount < 3)
+        return false;
+
+    double n = (double)_ulCount;
+    double mx = _dSum[0], my = _dSum[1], mz = _dSum[2];
+    double sxx = _dSumSq[0] - mx*mx/n;
+    double sxy = _dSumSq[1] - mx*my/n;
+    double sxz = _dSumSq[2] - mx*mz/n;
+    double syy = _dSumSq[3] - my*my/n;
+    double syz = _dSumSq[4] - my*mz/n;
+    double szz = _dSumSq[5] - mz*mz/n;
+
+    // Covariance matrix
+    Wm4::Matrix3<double> akMat(sxx,sxy,sxz,sxy,syy,syz,sxz,syz,szz);
+    Wm4::Matrix3<double> rkRot, rkDiag;
+    try {
+        akMat.EigenDecomposition(rkRot, rkDiag);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+
+    // points describe a line or even are identical
+    if (rkDiag(1,1) <= 0)
+        return false;
+
+    Wm4::Vector3<double> W = rkRot.GetColumn(0);
+    for (int i=0; i<3; i++) {
+        if (boost::math::isnan(W[i]))
+            return false;
+    }
+
+    _vNormal.Set((float)W.X(), (float)W.Y(), (float)W.Z());
+    _vBase.Set((float)(_vOrigin.x + mx/n), (float)(_vOrigin.y + my/n), (float)(_vOrigin.z + mz/n));
+    _bValid = true;
+    return true;
+}
+
+Base::Vector3f IncrementalPlaneFit::GetBase() const
+{
+    if (_bValid)
+        return _vBase;
+    else
+        return Base::Vector3f();
+}
+
+Base::Vector3f IncrementalPlaneFit::GetNormal() const
+{
+    if (_bValid)
+        return _vNormal;
+    else
+        return Base::Vector3f();
+}
+
+float IncrementalPlaneFit::GetDistanceToPlane(const Base::Vector3f &rcPoint) const
+{
+    float fResult = FLOAT_MAX;
+    if (_bValid)
+        fResult = (rcPoint - _vBase) * _vNormal;
+    return fResult;
+}
+
+// -------------------------------------------------------------------------------
+
 PolynomialFit::PolynomialFit()
 {
     for (int i=0; i<9; i++)
@@ -245,6 +245,57 @@ protected:
 
 // -------------------------------------------------------------------------------
 
+/**
+ * Approximation of a plane into a growing set of points. Unlike PlaneFit the points are
+ * not stored but only the running first and second moments are kept. So, adding a point
+ * and refitting the plane is independent of the number of points already added.
+ */
+class MeshExport IncrementalPlaneFit
+{
+public:
+    /**
+     * Construction
+     */
+    IncrementalPlaneFit();
+    /**
+     * Removes all points.
+     */
+    void Clear();
+    /**
+     * Adds a point and invalidates the last fit.
+     */
+    void AddPoint(const Base::Vector3f& rcPoint);
+    unsigned long CountPoints() const { return _ulCount; }
+    /**
+     * Fit a plane into the points added so far. We must have at least three non-collinear
+     * points to succeed. If the fit fails false is returned.
+     */
+    bool Fit();
+    /**
+     * Returns true if the plane has been fitted since the last point was added.
+     */
+    bool Done() const { return _bIsFitted; }
+    Base::Vector3f GetBase() const;
+    Base::Vector3f GetNormal() const;
+    /** 
+     * Returns the distance from the point \a rcPoint to the fitted plane. If Fit() has not been
+     * called FLOAT_MAX is returned.
+     */ 
+    float GetDistanceToPlane(const Base::Vector3f &rcPoint) const;
+
+private:
+    Base::Vector3f _vOrigin; /**< The first point, used to keep the sums small. */
+    double _dSum[3];         /**< Sum of the coordinates relative to the origin. */
+    double _dSumSq[6];       /**< Sum of the products xx, xy, xz, yy, yz, zz. */
+    unsigned long _ulCount;
+    bool _bIsFitted;
+    bool _bValid;
+    Base::Vector3f _vBase;
+    Base::Vector3f _vNormal;
+};
+
+// -------------------------------------------------------------------------------
+
 /**
  * Approximation of a quadratic surface into a given set of points. The implicit form of the surface
  * is defined by F(x,y,z) = a * x^2 + b * y^2 + c * z^2 + 
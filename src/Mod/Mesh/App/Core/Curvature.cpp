@@ -28,10 +28,13 @@
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QtConcurrentMap>
+#include <QtConcurrentRun>
+#include <QThread>
 #include <boost/bind.hpp>
 
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 
 #include "Curvature.h"
 #include "Algorithm.h"
@@ -44,6 +47,234 @@
 
 using namespace MeshCore;
 
+namespace MeshCore {
+/**
+ * Helper class to compute the curvature at the vertices of a mesh. The vertex to facet
+ * adjacency is stored in compressed form (offset + index arrays) and is only read by the
+ * worker threads. Each thread writes to the disjoint range of vertices it is assigned to.
+ */
+class VertexCurvature
+{
+public:
+    typedef void (VertexCurvature::*BlockFunction)(unsigned long, unsigned long, std::vector<CurvatureInfo>*);
+
+    VertexCurvature(const MeshKernel& kernel)
+      : points(kernel.GetPoints()), facets(kernel.GetFacets())
+    {
+        unsigned long numPoints = points.size();
+        offsets.resize(numPoints + 1, 0);
+        for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            for (int i=0; i<3; i++)
+                offsets[it->_aulPoints[i] + 1]++;
+        }
+        for (unsigned long i=0; i<numPoints; i++)
+            offsets[i + 1] += offsets[i];
+
+        std::vector<unsigned long> fill(offsets.begin(), offsets.end() - 1);
+        adjacency.resize(offsets.back());
+        unsigned long index = 0;
+        for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it, ++index) {
+            for (int i=0; i<3; i++)
+                adjacency[fill[it->_aulPoints[i]]++] = index;
+        }
+
+        coords.reserve(numPoints);
+        for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it)
+            coords.push_back(Wm4::Vector3<double>(it->x, it->y, it->z));
+        normals.resize(numPoints, Wm4::Vector3<double>::ZERO);
+    }
+
+    void RunBlocks(const std::vector<std::pair<unsigned long, unsigned long> >& blocks,
+                   BlockFunction func, std::vector<CurvatureInfo>* curv)
+    {
+        if (blocks.size() == 1) {
+            (this->*func)(blocks.front().first, blocks.front().second, curv);
+            return;
+        }
+
+        std::vector< QFuture<void> > futures;
+        futures.reserve(blocks.size());
+        for (std::vector<std::pair<unsigned long, unsigned long> >::const_iterator it = blocks.begin(); it != blocks.end(); ++it) {
+            futures.push_back(QtConcurrent::run(boost::bind(func, this, it->first, it->second, curv)));
+        }
+        for (std::vector< QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it) {
+            it->waitForFinished();
+        }
+    }
+
+    void ComputeNormals(unsigned long begin, unsigned long end, std::vector<CurvatureInfo>*)
+    {
+        for (unsigned long i=begin; i<end; i++) {
+            Wm4::Vector3<double> normal = Wm4::Vector3<double>::ZERO;
+            for (unsigned long j=offsets[i]; j<offsets[i+1]; j++) {
+                const MeshFacet& face = facets[adjacency[j]];
+                // the length provides a weighted sum
+                Wm4::Vector3<double> edge1 = coords[face._aulPoints[1]] - coords[face._aulPoints[0]];
+                Wm4::Vector3<double> edge2 = coords[face._aulPoints[2]] - coords[face._aulPoints[0]];
+                normal += edge1.Cross(edge2);
+            }
+            normal.Normalize();
+            normals[i] = normal;
+        }
+    }
+
+    /**
+     * Estimates the matrix of normal derivatives at each vertex and computes the eigenvalues
+     * and eigenvectors of the shape operator. This gives the same result as Wm4::MeshCurvature.
+     */
+    void ComputeShapeOperator(unsigned long begin, unsigned long end, std::vector<CurvatureInfo>* curv)
+    {
+        for (unsigned long i=begin; i<end; i++) {
+            const Wm4::Vector3<double>& normal = normals[i];
+            Wm4::Matrix3<double> wwTrn, dwTrn;
+            for (unsigned long j=offsets[i]; j<offsets[i+1]; j++) {
+                const MeshFacet& face = facets[adjacency[j]];
+                for (int k=0; k<3; k++) {
+                    if (face._aulPoints[k] != i)
+                        continue;
+                    for (int l=1; l<3; l++) {
+                        // Compute edge from V0 to Vl, project to tangent plane of vertex,
+                        // and compute difference of adjacent normals.
+                        unsigned long other = face._aulPoints[(k+l)%3];
+                        Wm4::Vector3<double> e = coords[other] - coords[i];
+                        Wm4::Vector3<double> w = e - (e.Dot(normal)) * normal;
+                        Wm4::Vector3<double> d = normals[other] - normal;
+                        for (int row=0; row<3; row++) {
+                            for (int col=0; col<3; col++) {
+                                wwTrn[row][col] += w[row] * w[col];
+                                dwTrn[row][col] += d[row] * w[col];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Add in N*N^T to W*W^T for numerical stability
+            for (int row=0; row<3; row++) {
+                for (int col=0; col<3; col++) {
+                    wwTrn[row][col] = 0.5 * wwTrn[row][col] + normal[row] * normal[col];
+                    dwTrn[row][col] *= 0.5;
+                }
+            }
+
+            Wm4::Matrix3<double> dNormal = dwTrn * wwTrn.Inverse();
+
+            // compute U and V given N
+            Wm4::Vector3<double> u, v;
+            Wm4::Vector3<double>::GenerateComplementBasis(u, v, normal);
+
+            // Compute S = J^T * dN/dX * J and make it symmetric
+            double s01 = u.Dot(dNormal * v);
+            double s10 = v.Dot(dNormal * u);
+            double sAvr = 0.5 * (s01 + s10);
+            Wm4::Matrix2<double> s(u.Dot(dNormal * u), sAvr, sAvr, v.Dot(dNormal * v));
+
+            // compute the eigenvalues of S (min and max curvatures)
+            double trace = s[0][0] + s[1][1];
+            double det = s[0][0] * s[1][1] - s[0][1] * s[1][0];
+            double rootDiscr = sqrt(fabs(trace * trace - 4.0 * det));
+            double minCurv = 0.5 * (trace - rootDiscr);
+            double maxCurv = 0.5 * (trace + rootDiscr);
+
+            CurvatureInfo& ci = (*curv)[i];
+            ci.fMinCurvature = (float)minCurv;
+            ci.fMaxCurvature = (float)maxCurv;
+            ci.cMinCurvDir = EigenDirection(s, minCurv, u, v);
+            ci.cMaxCurvDir = EigenDirection(s, maxCurv, u, v);
+        }
+    }
+
+    /**
+     * Computes the mean curvature with the cotangent Laplacian and the Gaussian curvature
+     * with the angle defect over the mixed Voronoi area of each vertex (Meyer et al.).
+     * The principal directions are not estimated and set to null vectors.
+     */
+    void ComputeDiscrete(unsigned long begin, unsigned long end, std::vector<CurvatureInfo>* curv)
+    {
+        for (unsigned long i=begin; i<end; i++) {
+            const Wm4::Vector3<double>& p = coords[i];
+            Wm4::Vector3<double> laplace = Wm4::Vector3<double>::ZERO;
+            double area = 0.0;
+            double angleSum = 0.0;
+            bool border = false;
+            for (unsigned long j=offsets[i]; j<offsets[i+1]; j++) {
+                const MeshFacet& face = facets[adjacency[j]];
+                int k = (face._aulPoints[0] == i ? 0 : (face._aulPoints[1] == i ? 1 : 2));
+                if (face._aulNeighbours[k] == ULONG_MAX || face._aulNeighbours[(k+2)%3] == ULONG_MAX)
+                    border = true;
+
+                const Wm4::Vector3<double>& a = coords[face._aulPoints[(k+1)%3]];
+                const Wm4::Vector3<double>& b = coords[face._aulPoints[(k+2)%3]];
+                Wm4::Vector3<double> pa = a - p, pb = b - p, ab = b - a;
+                double doubleArea = pa.Cross(pb).Length();
+                if (doubleArea <= 0.0)
+                    continue;
+
+                // cotangents of the angles at a and b
+                double cotA = (-pa).Dot(ab) / doubleArea;
+                double cotB = pb.Dot(ab) / doubleArea;
+                laplace += cotB * pa + cotA * pb;
+
+                double dotP = pa.Dot(pb);
+                angleSum += atan2(doubleArea, dotP);
+
+                // mixed area
+                if (dotP < 0.0)
+                    area += 0.25 * doubleArea;
+                else if (cotA < 0.0 || cotB < 0.0)
+                    area += 0.125 * doubleArea;
+                else
+                    area += 0.125 * (pa.SquaredLength() * cotB + pb.SquaredLength() * cotA);
+            }
+
+            CurvatureInfo& ci = (*curv)[i];
+            ci.cMinCurvDir.Set(0.0f, 0.0f, 0.0f);
+            ci.cMaxCurvDir.Set(0.0f, 0.0f, 0.0f);
+            if (area <= 0.0) {
+                ci.fMinCurvature = 0.0f;
+                ci.fMaxCurvature = 0.0f;
+                continue;
+            }
+
+            // the Laplacian points inwards for convex regions, i.e. opposite to the normal
+            double meanCurv = -0.25 * laplace.Dot(normals[i]) / area;
+            double gaussCurv = ((border ? Wm4::Math<double>::PI : Wm4::Math<double>::TWO_PI) - angleSum) / area;
+            double discr = sqrt(std::max<double>(meanCurv * meanCurv - gaussCurv, 0.0));
+            ci.fMinCurvature = (float)(meanCurv - discr);
+            ci.fMaxCurvature = (float)(meanCurv + discr);
+        }
+    }
+
+private:
+    static Base::Vector3f EigenDirection(const Wm4::Matrix2<double>& s, double curv,
+                                         const Wm4::Vector3<double>& u, const Wm4::Vector3<double>& v)
+    {
+        Wm4::Vector2<double> w0(s[0][1], curv - s[0][0]);
+        Wm4::Vector2<double> w1(curv - s[1][1], s[1][0]);
+        Wm4::Vector3<double> dir;
+        if (w0.SquaredLength() >= w1.SquaredLength()) {
+            w0.Normalize();
+            dir = w0.X() * u + w0.Y() * v;
+        }
+        else {
+            w1.Normalize();
+            dir = w1.X() * u + w1.Y() * v;
+        }
+        return Base::Vector3f((float)dir.X(), (float)dir.Y(), (float)dir.Z());
+    }
+
+private:
+    const MeshPointArray& points;
+    const MeshFacetArray& facets;
+    std::vector<unsigned long> offsets;
+    std::vector<unsigned long> adjacency;
+    std::vector< Wm4::Vector3<double> > coords;
+    std::vector< Wm4::Vector3<double> > normals;
+};
+}
+
+// --------------------------------------------------------
+
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
   : myKernel(kernel), myMinPoints(20), myRadius(0.5f)
 {
@@ -86,49 +317,41 @@ void MeshCurvature::ComputePerFace(bool parallel)
 
 void MeshCurvature::ComputePerVertex()
 {
-    myCurvature.clear();
+    ComputePerVertex(true, ShapeOperator);
+}
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
-    }
-
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
-        }
-    }
+void MeshCurvature::ComputePerVertex(bool parallel, VertexMethod method)
+{
+    myCurvature.clear();
 
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
         return;
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
+    VertexCurvature vertex(myKernel);
+    myCurvature.resize(myKernel.CountPoints());
 
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+    unsigned long numPoints = myKernel.CountPoints();
+    unsigned long numBlocks = 1;
+    if (parallel) {
+        // Use a few blocks per thread to balance the work load but keep the
+        // number of tasks small compared to the number of vertices
+        unsigned long numThreads = std::max<int>(1, QThread::idealThreadCount());
+        numBlocks = std::min<unsigned long>(4 * numThreads, numPoints / 1024 + 1);
+    }
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
+    std::vector<std::pair<unsigned long, unsigned long> > blocks;
+    blocks.reserve(numBlocks);
+    for (unsigned long i=0; i<numBlocks; i++) {
+        blocks.push_back(std::make_pair(i * numPoints / numBlocks, (i + 1) * numPoints / numBlocks));
     }
+
+    // the normals are needed by the neighbours, so they must be complete before the second pass
+    vertex.RunBlocks(blocks, &VertexCurvature::ComputeNormals, 0);
+    if (method == Discrete)
+        vertex.RunBlocks(blocks, &VertexCurvature::ComputeDiscrete, &myCurvature);
+    else
+        vertex.RunBlocks(blocks, &VertexCurvature::ComputeShapeOperator, &myCurvature);
 }
 
 // --------------------------------------------------------
@@ -54,12 +54,25 @@ private:
 class MeshExport MeshCurvature
 {
 public:
+    /** Method used to estimate the curvature at the vertices. */
+    enum VertexMethod {
+        /// least-squares estimate of the shape operator from the normal derivatives
+        ShapeOperator,
+        /// cotangent Laplacian and angle defect, cheaper but without principal directions
+        Discrete
+    };
+
     MeshCurvature(const MeshKernel& kernel);
     MeshCurvature(const MeshKernel& kernel, const std::vector<unsigned long>& segm);
     float GetRadius() const { return myRadius; }
     void SetRadius(float r) { myRadius = r; }
     void ComputePerFace(bool parallel);
     void ComputePerVertex();
+    /** Computes the curvature at each vertex of the mesh. If \a parallel is true the
+     * vertices are split into contiguous blocks which are handled by the worker threads
+     * of the global thread pool. All threads share the same read-only adjacency.
+     */
+    void ComputePerVertex(bool parallel, VertexMethod method = ShapeOperator);
     const std::vector<CurvatureInfo>& GetCurvature() const { return myCurvature; }
 
 private:
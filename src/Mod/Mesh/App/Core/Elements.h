@@ -44,6 +44,47 @@ namespace MeshCore {
 class MeshHelpEdge;
 class MeshPoint;
 
+#if defined(MESH_COMPACT_INDICES)
+/**
+ * Stores a point or facet index with 32 bits. It converts implicitly from and to unsigned long
+ * so that the algorithms don't need to care about the storage size. The largest value of the
+ * storage type represents ULONG_MAX which marks a missing neighbour or point.
+ * This halves the size of MeshFacet on platforms where unsigned long has 64 bits but limits
+ * the number of points and facets to 2^32-1.
+ */
+class MeshCompactIndex
+{
+public:
+  MeshCompactIndex (void) { }
+  MeshCompactIndex (unsigned long ulIndex)
+  : _uiIndex(ulIndex == ULONG_MAX ? UINT_MAX : (unsigned int)ulIndex) { }
+  operator unsigned long () const
+  { return _uiIndex == UINT_MAX ? ULONG_MAX : (unsigned long)_uiIndex; }
+
+  MeshCompactIndex& operator ++ ()
+  { ++_uiIndex; return *this; }
+  MeshCompactIndex& operator -- ()
+  { --_uiIndex; return *this; }
+  MeshCompactIndex operator ++ (int)
+  { MeshCompactIndex tmp(*this); ++_uiIndex; return tmp; }
+  MeshCompactIndex operator -- (int)
+  { MeshCompactIndex tmp(*this); --_uiIndex; return tmp; }
+  MeshCompactIndex& operator += (unsigned long ulOffset)
+  { *this = MeshCompactIndex(static_cast<unsigned long>(*this) + ulOffset); return *this; }
+  MeshCompactIndex& operator -= (unsigned long ulOffset)
+  { *this = MeshCompactIndex(static_cast<unsigned long>(*this) - ulOffset); return *this; }
+
+private:
+  unsigned int _uiIndex;
+};
+
+/** The type used to store point and facet indices inside the mesh elements. */
+typedef MeshCompactIndex ElementIndex;
+#else
+/** The type used to store point and facet indices inside the mesh elements. */
+typedef unsigned long ElementIndex;
+#endif
+
 /**
  * Helper class providing an operator for comparison 
  * of two edges. The class holds the point indices of the
@@ -135,7 +176,7 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member */
-  unsigned long _ulProp; /**< Free usable property */
+  ElementIndex  _ulProp; /**< Free usable property */
 };
 
 /**
@@ -292,9 +333,9 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member. */
-  unsigned long _ulProp; /**< Free usable property. */
-  unsigned long _aulPoints[3];     /**< Indices of corner points. */
-  unsigned long _aulNeighbours[3]; /**< Indices of neighbour facets. */
+  ElementIndex  _ulProp; /**< Free usable property. */
+  ElementIndex  _aulPoints[3];     /**< Indices of corner points. */
+  ElementIndex  _aulNeighbours[3]; /**< Indices of neighbour facets. */
 };
 
 /**
@@ -749,8 +790,8 @@ inline MeshFacet::MeshFacet (void)
 : _ucFlag(0),
   _ulProp(0)
 {
-    memset(_aulNeighbours, 0xff, sizeof(ULONG_MAX) * 3);
-    memset(_aulPoints, 0xff, sizeof(ULONG_MAX) * 3);
+    memset(_aulNeighbours, 0xff, sizeof(_aulNeighbours));
+    memset(_aulPoints, 0xff, sizeof(_aulPoints));
 }
 
 inline MeshFacet::MeshFacet(const MeshFacet &rclF)
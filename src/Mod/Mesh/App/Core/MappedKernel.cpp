@@ -0,0 +1,391 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <cstring>
+# include <iostream>
+#endif
+
+#include <QFile>
+
+#include "MappedKernel.h"
+#include "MeshKernel.h"
+#include "Iterator.h"
+#include "MeshIO.h"
+#include <Base/FileInfo.h>
+#include <Base/Sequencer.h>
+#include <Base/Stream.h>
+
+using namespace MeshCore;
+
+namespace MeshCore {
+// The header of a mapped mesh file, it's padded to 64 bytes
+struct MappedMeshHeader
+{
+    char magic[8];
+    boost::uint32_t version;
+    boost::uint32_t indexSize;
+    boost::uint64_t numPoints;
+    boost::uint64_t numFacets;
+    float bbox[6];
+    boost::uint32_t reserved[2];
+};
+
+static const char MappedMeshMagic[8] = {'F','C','M','E','S','H','O','C'};
+
+// the facet array starts at an 8-byte boundary
+static boost::uint64_t facetOffset(boost::uint64_t numPoints)
+{
+    boost::uint64_t offset = sizeof(MappedMeshHeader) + 3 * sizeof(float) * numPoints;
+    return (offset + 7) & ~boost::uint64_t(7);
+}
+
+static void writeHeader(std::ostream& out, boost::uint64_t numPoints, boost::uint64_t numFacets,
+                        boost::uint32_t indexSize, const Base::BoundBox3f& box)
+{
+    MappedMeshHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MappedMeshMagic, sizeof(header.magic));
+    header.version = 1;
+    header.indexSize = indexSize;
+    header.numPoints = numPoints;
+    header.numFacets = numFacets;
+    header.bbox[0] = box.MinX; header.bbox[1] = box.MinY; header.bbox[2] = box.MinZ;
+    header.bbox[3] = box.MaxX; header.bbox[4] = box.MaxY; header.bbox[5] = box.MaxZ;
+    out.write((const char*)&header, sizeof(header));
+}
+
+static void writeIndices(std::ostream& out, boost::uint32_t indexSize,
+                         unsigned long p0, unsigned long p1, unsigned long p2)
+{
+    if (indexSize == 4) {
+        boost::uint32_t idx[3] = {(boost::uint32_t)p0, (boost::uint32_t)p1, (boost::uint32_t)p2};
+        out.write((const char*)idx, sizeof(idx));
+    }
+    else {
+        boost::uint64_t idx[3] = {p0, p1, p2};
+        out.write((const char*)idx, sizeof(idx));
+    }
+}
+
+static void writePadding(std::ostream& out, boost::uint64_t numPoints)
+{
+    boost::uint64_t size = facetOffset(numPoints) - sizeof(MappedMeshHeader) - 3 * sizeof(float) * numPoints;
+    char zero[8] = {0};
+    out.write(zero, (std::streamsize)size);
+}
+}
+
+const unsigned long MappedMeshKernel::ChunkSize = 65536;
+
+MappedMeshKernel::MappedMeshKernel()
+  : file(0), data(0), points(0), facets(0), numPoints(0), numFacets(0), indexSize(4)
+{
+}
+
+MappedMeshKernel::~MappedMeshKernel()
+{
+    Close();
+}
+
+bool MappedMeshKernel::Create(const std::string& file, const MeshKernel& kernel, bool compact)
+{
+    Base::FileInfo fi(file);
+    Base::ofstream str(fi, std::ios::out | std::ios::binary);
+    if (!str)
+        return false;
+
+    const MeshPointArray& rPoints = kernel.GetPoints();
+    const MeshFacetArray& rFacets = kernel.GetFacets();
+    boost::uint32_t indexSize = (compact && rPoints.size() < 0xffffffffUL) ? 4 : 8;
+    writeHeader(str, rPoints.size(), rFacets.size(), indexSize, kernel.GetBoundBox());
+
+    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
+        float p[3] = {it->x, it->y, it->z};
+        str.write((const char*)p, sizeof(p));
+    }
+    writePadding(str, rPoints.size());
+
+    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
+        writeIndices(str, indexSize, it->_aulPoints[0], it->_aulPoints[1], it->_aulPoints[2]);
+    }
+
+    bool ok = str.good();
+    str.close();
+    if (!ok)
+        fi.deleteFile();
+    return ok;
+}
+
+bool MappedMeshKernel::CreateFromBinarySTL(const std::string& file, std::istream& stl, bool compact)
+{
+    Base::FileInfo fi(file);
+    bool ok;
+    {
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        if (!str)
+            return false;
+        ok = WriteFromBinarySTL(str, stl, compact);
+    }
+
+    // don't leave a truncated file behind
+    if (!ok)
+        fi.deleteFile();
+    return ok;
+}
+
+bool MappedMeshKernel::WriteFromBinarySTL(std::ostream& str, std::istream& stl, bool compact)
+{
+    char szInfo[80];
+    boost::uint32_t ulCt;
+    stl.read(szInfo, sizeof(szInfo));
+    stl.read((char*)&ulCt, sizeof(ulCt));
+    if (!stl)
+        return false;
+
+    boost::uint64_t numFacets = ulCt;
+    boost::uint64_t numPoints = 3 * numFacets;
+    boost::uint32_t indexSize = (compact && numPoints < 0xffffffffUL) ? 4 : 8;
+
+    // write a dummy header first and the real one when the bounding box is known
+    Base::BoundBox3f box;
+    writeHeader(str, numPoints, numFacets, indexSize, box);
+
+    try {
+        Base::SequencerLauncher seq("Converting STL...", ulCt / ChunkSize + 1);
+        float buf[12];
+        boost::uint16_t usAtt;
+        for (boost::uint32_t i = 0; i < ulCt; i++) {
+            // skip the normal and read the points
+            stl.read((char*)buf, sizeof(buf));
+            stl.read((char*)&usAtt, sizeof(usAtt));
+            if (!stl)
+                return false;
+            for (int j = 1; j < 4; j++)
+                box.Add(Base::Vector3f(buf[3*j], buf[3*j+1], buf[3*j+2]));
+            str.write((const char*)(buf + 3), 9 * sizeof(float));
+            if ((i + 1) % ChunkSize == 0)
+                seq.next(true); // allow to cancel
+        }
+    }
+    catch (const Base::AbortException&) {
+        return false;
+    }
+    writePadding(str, numPoints);
+
+    for (boost::uint64_t i = 0; i < numFacets; i++) {
+        writeIndices(str, indexSize, (unsigned long)(3*i), (unsigned long)(3*i+1), (unsigned long)(3*i+2));
+    }
+
+    str.seekp(0, std::ios::beg);
+    writeHeader(str, numPoints, numFacets, indexSize, box);
+    return str.good();
+}
+
+bool MappedMeshKernel::Open(const std::string& fn)
+{
+    Close();
+
+    file = new QFile(QString::fromUtf8(fn.c_str()));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < (qint64)sizeof(MappedMeshHeader)) {
+        Close();
+        return false;
+    }
+
+    data = file->map(0, file->size());
+    if (!data) {
+        Close();
+        return false;
+    }
+
+    MappedMeshHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, MappedMeshMagic, sizeof(header.magic)) != 0 || header.version != 1 ||
+        (header.indexSize != 4 && header.indexSize != 8)) {
+        Close();
+        return false;
+    }
+
+    // check the counts against the file size first so that the computed size cannot overflow
+    boost::uint64_t fileSize = (boost::uint64_t)file->size();
+    if (header.numPoints > fileSize / (3 * sizeof(float)) ||
+        header.numFacets > fileSize / (3 * header.indexSize) ||
+        header.numPoints > (boost::uint64_t)ULONG_MAX ||
+        header.numFacets > (boost::uint64_t)ULONG_MAX) {
+        Close();
+        return false;
+    }
+
+    boost::uint64_t size = facetOffset(header.numPoints) + 3 * header.indexSize * header.numFacets;
+    if (fileSize < size) {
+        Close();
+        return false;
+    }
+
+    numPoints = (unsigned long)header.numPoints;
+    numFacets = (unsigned long)header.numFacets;
+    indexSize = header.indexSize;
+    boundBox = Base::BoundBox3f(header.bbox[0], header.bbox[1], header.bbox[2],
+                                header.bbox[3], header.bbox[4], header.bbox[5]);
+    points = reinterpret_cast<const float*>(data + sizeof(MappedMeshHeader));
+    facets = data + facetOffset(header.numPoints);
+
+    // GetPoint() doesn't check its argument, so reject files with invalid point indices
+    if (!CheckFacets()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedMeshKernel::CheckFacets() const
+{
+    unsigned long p0, p1, p2;
+    for (unsigned long i = 0; i < numFacets; i++) {
+        GetFacetPoints(i, p0, p1, p2);
+        if (p0 >= numPoints || p1 >= numPoints || p2 >= numPoints)
+            return false;
+    }
+    return true;
+}
+
+void MappedMeshKernel::Close()
+{
+    if (file) {
+        if (data)
+            file->unmap(data);
+        file->close();
+        delete file;
+    }
+
+    file = 0;
+    data = 0;
+    points = 0;
+    facets = 0;
+    numPoints = 0;
+    numFacets = 0;
+    boundBox = Base::BoundBox3f();
+}
+
+bool MappedMeshKernel::IsOpen() const
+{
+    return data != 0;
+}
+
+void MappedMeshKernel::GetFacets(unsigned long start, unsigned long count, std::vector<MeshGeomFacet>& result) const
+{
+    result.clear();
+    if (start >= numFacets)
+        return;
+    unsigned long end = std::min<unsigned long>(numFacets, start + count);
+    result.reserve(end - start);
+    for (unsigned long i = start; i < end; i++)
+        result.push_back(GetFacet(i));
+}
+
+float MappedMeshKernel::GetSurface() const
+{
+    double fSurface = 0.0;
+    for (MappedFacetIterator it(*this); it.More(); it.Next())
+        fSurface += it->Area();
+
+    return (float)fSurface;
+}
+
+float MappedMeshKernel::GetVolume() const
+{
+    double fVolume = 0.0;
+    Base::Vector3f p1,p2,p3;
+    for (MappedFacetIterator it(*this); it.More(); it.Next()) {
+        p1 = it->_aclPoints[0];
+        p2 = it->_aclPoints[1];
+        p3 = it->_aclPoints[2];
+
+        fVolume += (-p3.x*p2.y*p1.z + p2.x*p3.y*p1.z + p3.x*p1.y*p2.z - p1.x*p3.y*p2.z - p2.x*p1.y*p3.z + p1.x*p2.y*p3.z);
+    }
+
+    fVolume /= 6.0;
+    return (float)fabs(fVolume);
+}
+
+bool MappedMeshKernel::SaveBinarySTL(std::ostream& out) const
+{
+    if (!out || out.bad() == true)
+        return false;
+
+    char szInfo[81];
+    strcpy(szInfo, MeshOutput::GetSTLHeaderData().c_str());
+    out.write(szInfo, std::strlen(szInfo));
+    boost::uint32_t uCtFts = (boost::uint32_t)numFacets;
+    out.write((const char*)&uCtFts, sizeof(uCtFts));
+
+    Base::SequencerLauncher seq("saving...", numFacets / ChunkSize + 1);
+    boost::uint16_t usAtt = 0;
+    for (MappedFacetIterator it(*this); it.More(); it.Next()) {
+        Base::Vector3f normal = it->GetNormal();
+        float buf[12] = {normal.x, normal.y, normal.z};
+        for (int i = 0; i < 3; i++) {
+            buf[3*i+3] = it->_aclPoints[i].x;
+            buf[3*i+4] = it->_aclPoints[i].y;
+            buf[3*i+5] = it->_aclPoints[i].z;
+        }
+        out.write((const char*)buf, sizeof(buf));
+        out.write((const char*)&usAtt, sizeof(usAtt));
+        if ((it.Position() + 1) % ChunkSize == 0)
+            seq.next(true); // allow to cancel
+    }
+
+    return out.good();
+}
+
+void MappedMeshKernel::CutWithPlane(const Base::Vector3f& base, const Base::Vector3f& normal,
+                                    std::list<std::pair<Base::Vector3f, Base::Vector3f> >& lines) const
+{
+    Base::Vector3f p1, p2;
+    for (MappedFacetIterator it(*this); it.More(); it.Next()) {
+        if (it->IntersectWithPlane(base, normal, p1, p2))
+            lines.push_back(std::make_pair(p1, p2));
+    }
+}
+
+// --------------------------------------------------------
+
+MappedFacetIterator::MappedFacetIterator(const MappedMeshKernel& kernel)
+  : kernel(kernel), start(0), position(0)
+{
+    Set(0);
+}
+
+void MappedFacetIterator::Set(unsigned long pos)
+{
+    position = pos;
+    if (pos >= start && pos - start < buffer.size())
+        return;
+    if (pos >= kernel.CountFacets())
+        return;
+    start = pos - pos % MappedMeshKernel::ChunkSize;
+    kernel.GetFacets(start, MappedMeshKernel::ChunkSize, buffer);
+}
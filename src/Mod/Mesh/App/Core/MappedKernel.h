@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESHCORE_MAPPEDKERNEL_H
+#define MESHCORE_MAPPEDKERNEL_H
+
+#include <iosfwd>
+#include <list>
+#include <string>
+#include <vector>
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+#include <boost/cstdint.hpp>
+#include "Elements.h"
+
+class QFile;
+
+namespace MeshCore {
+
+class MeshKernel;
+
+/**
+ * The MappedMeshKernel class gives read-only access to a mesh that is stored in a file on
+ * disk. It is meant for meshes that are too big to be loaded into a MeshKernel. The point
+ * and facet arrays of the file are memory mapped, so only the pages that are accessed are
+ * loaded by the operating system. The facet indices are stored with 32 bits if possible.
+ *
+ * The file starts with a header of 64 bytes, followed by the point coordinates as floats
+ * and the point indices of the facets. No neighbourhood information is kept.
+ * @author FreeCAD Developers
+ */
+class MeshExport MappedMeshKernel
+{
+public:
+    /// Number of facets that are handled at once by the chunked algorithms
+    static const unsigned long ChunkSize;
+
+    MappedMeshKernel();
+    ~MappedMeshKernel();
+
+    /** Writes \a kernel to \a file in the format expected by Open(). If \a compact is
+     * true and there are less than 2^32 points the indices are stored with 32 bits.
+     */
+    static bool Create(const std::string& file, const MeshKernel& kernel, bool compact = true);
+    /** Converts the binary STL data of \a stl to \a file without building a MeshKernel.
+     * The points are not merged, so each facet references three points of its own.
+     */
+    static bool CreateFromBinarySTL(const std::string& file, std::istream& stl, bool compact = true);
+
+    /** Maps the given file. Returns false if the file doesn't exist or has a wrong format.
+     * All point indices of the facets are checked once, so a file with a corrupt facet
+     * array is rejected.
+     */
+    bool Open(const std::string& file);
+    void Close();
+    bool IsOpen() const;
+
+    unsigned long CountPoints() const { return numPoints; }
+    unsigned long CountFacets() const { return numFacets; }
+    /** Returns true if the facet indices are stored with 32 bits. */
+    bool HasCompactIndices() const { return indexSize == 4; }
+    const Base::BoundBox3f& GetBoundBox() const { return boundBox; }
+
+    inline Base::Vector3f GetPoint(unsigned long index) const;
+    inline void GetFacetPoints(unsigned long index, unsigned long& p0, unsigned long& p1, unsigned long& p2) const;
+    inline MeshGeomFacet GetFacet(unsigned long index) const;
+    /** Reads up to \a count facets starting at \a start. */
+    void GetFacets(unsigned long start, unsigned long count, std::vector<MeshGeomFacet>& facets) const;
+
+    /** Returns the area of all facets. */
+    float GetSurface() const;
+    /** Returns the enclosed volume. As there is no topology it cannot be checked whether
+     * the mesh is a solid, the caller must make sure of it.
+     */
+    float GetVolume() const;
+    /** Writes all facets as binary STL. */
+    bool SaveBinarySTL(std::ostream& out) const;
+    /** Intersects all facets with the given plane. The intersection is returned as a list of
+     * line segments which can be joined with MeshAlgorithm::ConnectLines().
+     */
+    void CutWithPlane(const Base::Vector3f& base, const Base::Vector3f& normal,
+                      std::list<std::pair<Base::Vector3f, Base::Vector3f> >& lines) const;
+
+private:
+    static bool WriteFromBinarySTL(std::ostream& out, std::istream& stl, bool compact);
+    bool CheckFacets() const;
+    MappedMeshKernel(const MappedMeshKernel&);
+    MappedMeshKernel& operator=(const MappedMeshKernel&);
+
+private:
+    QFile* file;
+    unsigned char* data;
+    const float* points;
+    const unsigned char* facets;
+    unsigned long numPoints;
+    unsigned long numFacets;
+    unsigned long indexSize;
+    Base::BoundBox3f boundBox;
+};
+
+/**
+ * The MappedFacetIterator class iterates over the facets of a MappedMeshKernel. The facets
+ * are read in chunks of MappedMeshKernel::ChunkSize into a small buffer.
+ */
+class MeshExport MappedFacetIterator
+{
+public:
+    MappedFacetIterator(const MappedMeshKernel& kernel);
+
+    void Init() { Set(0); }
+    bool More() const { return position < kernel.CountFacets(); }
+    void Next() { Set(position + 1); }
+    unsigned long Position() const { return position; }
+    const MeshGeomFacet& operator*() const { return buffer[position - start]; }
+    const MeshGeomFacet* operator->() const { return &buffer[position - start]; }
+
+private:
+    void Set(unsigned long pos);
+
+private:
+    const MappedMeshKernel& kernel;
+    std::vector<MeshGeomFacet> buffer;
+    unsigned long start;
+    unsigned long position;
+};
+
+inline Base::Vector3f MappedMeshKernel::GetPoint(unsigned long index) const
+{
+    const float* p = points + 3 * index;
+    return Base::Vector3f(p[0], p[1], p[2]);
+}
+
+inline void MappedMeshKernel::GetFacetPoints(unsigned long index, unsigned long& p0,
+                                             unsigned long& p1, unsigned long& p2) const
+{
+    if (indexSize == 4) {
+        const boost::uint32_t* f = reinterpret_cast<const boost::uint32_t*>(facets) + 3 * index;
+        p0 = f[0]; p1 = f[1]; p2 = f[2];
+    }
+    else {
+        const boost::uint64_t* f = reinterpret_cast<const boost::uint64_t*>(facets) + 3 * index;
+        p0 = (unsigned long)f[0]; p1 = (unsigned long)f[1]; p2 = (unsigned long)f[2];
+    }
+}
+
+inline MeshGeomFacet MappedMeshKernel::GetFacet(unsigned long index) const
+{
+    unsigned long p0, p1, p2;
+    GetFacetPoints(index, p0, p1, p2);
+    return MeshGeomFacet(GetPoint(p0), GetPoint(p1), GetPoint(p2));
+}
+
+} // namespace MeshCore
+
+#endif // MESHCORE_MAPPEDKERNEL_H
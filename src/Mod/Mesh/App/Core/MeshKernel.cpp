@@ -796,6 +796,24 @@ void MeshKernel::Write (std::ostream &rclOut) const
     str << _clBoundBox.MinZ << _clBoundBox.MaxZ;
 }
 
+namespace {
+// The records of the old format have the layout of the mesh elements with 'unsigned long'
+// indices. They are read explicitly so that the file layout doesn't depend on the storage
+// size of MeshCore::ElementIndex.
+struct OldMeshPoint {
+    float x, y, z;
+    unsigned char flag;
+    unsigned long prop;
+};
+
+struct OldMeshFacet {
+    unsigned char flag;
+    unsigned long prop;
+    unsigned long points[3];
+    unsigned long neighbours[3];
+};
+}
+
 void MeshKernel::Read (std::istream &rclIn)
 {
     if (!rclIn || rclIn.bad())
@@ -882,17 +900,34 @@ void MeshKernel::Read (std::istream &rclIn)
         }
     }
     else {
-        // The old format
+        // The old format is a memory dump of the point and facet arrays
         unsigned long uCtPts=magic, uCtFts=version;
 
         // the stored mesh kernel might be empty
         if ( uCtPts > 0 ) {
+          std::vector<OldMeshPoint> points(uCtPts);
+          rclIn.read((char*)&(points[0]), uCtPts*sizeof(OldMeshPoint));
           _aclPointArray.resize(uCtPts);
-          rclIn.read((char*)&(_aclPointArray[0]), uCtPts*sizeof(MeshPoint));
+          for (unsigned long i=0; i<uCtPts; i++) {
+            MeshPoint& rclP = _aclPointArray[i];
+            rclP.Set(points[i].x, points[i].y, points[i].z);
+            rclP._ucFlag = points[i].flag;
+            rclP._ulProp = points[i].prop;
+          }
         }
         if ( uCtFts > 0 ) {
+          std::vector<OldMeshFacet> facets(uCtFts);
+          rclIn.read((char*)&(facets[0]), uCtFts*sizeof(OldMeshFacet));
           _aclFacetArray.resize(uCtFts);
-          rclIn.read((char*)&(_aclFacetArray[0]), uCtFts*sizeof(MeshFacet));
+          for (unsigned long i=0; i<uCtFts; i++) {
+            MeshFacet& rclF = _aclFacetArray[i];
+            rclF._ucFlag = facets[i].flag;
+            rclF._ulProp = facets[i].prop;
+            for (int j=0; j<3; j++) {
+              rclF._aulPoints[j] = facets[i].points[j];
+              rclF._aulNeighbours[j] = facets[i].neighbours[j];
+            }
+          }
         }
         rclIn.read((char*)&_clBoundBox, sizeof(Base::BoundBox3f));
     }
@@ -25,6 +25,11 @@
 #include <algorithm>
 #endif
 
+#include <QFuture>
+#include <QtConcurrentRun>
+#include <QThread>
+#include <boost/bind.hpp>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
@@ -59,7 +64,7 @@ MeshSegment MeshSurfaceSegment::FindSegment(unsigned long index) const
 // --------------------------------------------------------
 
 MeshDistancePlanarSegment::MeshDistancePlanarSegment(const MeshKernel& mesh, unsigned long minFacets, float tol)
-  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new PlaneFit)
+  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new IncrementalPlaneFit)
 {
 }
 
@@ -187,52 +192,261 @@ bool MeshSurfaceVisitor::Visit (const MeshFacet & face, const MeshFacet &,
 
 // --------------------------------------------------------
 
+namespace MeshCore {
+/**
+ * Connected component labelling of the facets that pass the test of a stateless segment.
+ * The facet array is split into contiguous blocks which are handled by the worker threads.
+ * In a first pass all facets are tested, in a second pass each thread only unites facets
+ * inside its own block, the edges that cross two blocks are collected and united afterwards.
+ * The root of a component is always its facet with the lowest index.
+ */
+class SegmentLabeling
+{
+public:
+    typedef std::pair<unsigned long, unsigned long> Edge;
+
+    SegmentLabeling(const MeshFacetArray& facets, const MeshSurfaceSegment& segm)
+      : facets(facets), segm(segm), numBlocks(1), accept(facets.size()), parent(facets.size())
+    {
+    }
+
+    void Run()
+    {
+        unsigned long numFacets = facets.size();
+        unsigned long numThreads = std::max<int>(1, QThread::idealThreadCount());
+        numBlocks = std::min<unsigned long>(4 * numThreads, numFacets / 4096 + 1);
+
+        // all facets must be tested before any edge between two facets is checked
+        crossing.assign(numBlocks, std::vector<Edge>());
+        RunBlocks(&SegmentLabeling::TestBlock);
+        RunBlocks(&SegmentLabeling::LabelBlock);
+
+        // resolve the edges between the blocks
+        for (std::vector< std::vector<Edge> >::iterator it = crossing.begin(); it != crossing.end(); ++it) {
+            for (std::vector<Edge>::iterator jt = it->begin(); jt != it->end(); ++jt)
+                Unite(jt->first, jt->second);
+        }
+        crossing.clear();
+
+        // flatten the trees so that each facet directly points to its root, this works
+        // in a single pass because a parent always has a lower index than its child
+        for (unsigned long i=0; i<numFacets; i++)
+            parent[i] = parent[parent[i]];
+    }
+
+    bool IsAccepted(unsigned long index) const
+    {
+        return accept[index] != 0;
+    }
+
+    unsigned long GetRoot(unsigned long index) const
+    {
+        return parent[index];
+    }
+
+private:
+    typedef void (SegmentLabeling::*BlockFunction)(unsigned long);
+
+    void RunBlocks(BlockFunction func)
+    {
+        if (numBlocks == 1) {
+            (this->*func)(0);
+            return;
+        }
+
+        std::vector< QFuture<void> > futures;
+        futures.reserve(numBlocks);
+        for (unsigned long i=0; i<numBlocks; i++)
+            futures.push_back(QtConcurrent::run(boost::bind(func, this, i)));
+        for (std::vector< QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it)
+            it->waitForFinished();
+    }
+
+    unsigned long BlockBegin(unsigned long block) const
+    {
+        return block * facets.size() / numBlocks;
+    }
+
+    void TestBlock(unsigned long block)
+    {
+        unsigned long end = BlockBegin(block + 1);
+        for (unsigned long i=BlockBegin(block); i<end; i++) {
+            const MeshFacet& face = facets[i];
+            parent[i] = i;
+            accept[i] = (!face.IsFlag(MeshFacet::VISIT) && segm.TestFacet(face)) ? 1 : 0;
+        }
+    }
+
+    void LabelBlock(unsigned long block)
+    {
+        unsigned long begin = BlockBegin(block);
+        unsigned long end = BlockBegin(block + 1);
+        std::vector<Edge>& cross = crossing[block];
+        unsigned long numFacets = facets.size();
+        for (unsigned long i=begin; i<end; i++) {
+            if (!accept[i])
+                continue;
+            const MeshFacet& face = facets[i];
+            for (int j=0; j<3; j++) {
+                unsigned long n = face._aulNeighbours[j];
+                if (n >= numFacets || !accept[n])
+                    continue;
+                if (n >= begin && n < end)
+                    Unite(i, n);
+                else if (i < n)
+                    cross.push_back(Edge(i, n));
+            }
+        }
+    }
+
+    unsigned long Find(unsigned long index)
+    {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    }
+
+    void Unite(unsigned long a, unsigned long b)
+    {
+        a = Find(a);
+        b = Find(b);
+        if (a < b)
+            parent[b] = a;
+        else if (b < a)
+            parent[a] = b;
+    }
+
+private:
+    const MeshFacetArray& facets;
+    const MeshSurfaceSegment& segm;
+    unsigned long numBlocks;
+    std::vector<char> accept;
+    std::vector<unsigned long> parent;
+    std::vector< std::vector<Edge> > crossing;
+};
+}
+
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegment*>& segm)
 {
     // reset VISIT flags
-    unsigned long startFacet;
     MeshCore::MeshAlgorithm cAlgo(myKernel);
     cAlgo.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
 
+    std::vector<unsigned long> resetVisited;
+    for (std::vector<MeshSurfaceSegment*>::iterator it = segm.begin(); it != segm.end(); ++it) {
+        cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
+        resetVisited.clear();
+
+        if (myParallel && (*it)->IsStateless())
+            FindStatelessSegments(*it, resetVisited);
+        else
+            FindSegments(*it, resetVisited);
+    }
+}
+
+void MeshSegmentAlgorithm::FindSegments(MeshSurfaceSegment* segm, std::vector<unsigned long>& resetVisited)
+{
+    unsigned long startFacet;
     const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
     MeshCore::MeshFacetArray::_TConstIterator iCur = rFAry.begin();
     MeshCore::MeshFacetArray::_TConstIterator iBeg = rFAry.begin();
     MeshCore::MeshFacetArray::_TConstIterator iEnd = rFAry.end();
 
     // start from the first not visited facet
-    cAlgo.CountFacetFlag(MeshCore::MeshFacet::VISIT);
-    std::vector<unsigned long> resetVisited;
-
-    for (std::vector<MeshSurfaceSegment*>::iterator it = segm.begin(); it != segm.end(); ++it) {
-        cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
-        resetVisited.clear();
+    iCur = std::find_if(iBeg, iEnd, std::bind2nd(MeshCore::MeshIsNotFlag<MeshCore::MeshFacet>(),
+        MeshCore::MeshFacet::VISIT));
+    startFacet = iCur < iEnd ? iCur - iBeg : ULONG_MAX;
+    while (startFacet != ULONG_MAX) {
+        // collect all facets of the same geometry
+        std::vector<unsigned long> indices;
+        indices.push_back(startFacet);
+        segm->Initialize(startFacet);
+        MeshSurfaceVisitor pv(*segm, indices);
+        myKernel.VisitNeighbourFacets(pv, startFacet);
+
+        // add or discard the segment
+        if (indices.size() == 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            segm->AddSegment(indices);
+        }
 
-        iCur = std::find_if(iBeg, iEnd, std::bind2nd(MeshCore::MeshIsNotFlag<MeshCore::MeshFacet>(),
+        // search for the next start facet
+        iCur = std::find_if(iCur, iEnd, std::bind2nd(MeshCore::MeshIsNotFlag<MeshCore::MeshFacet>(),
             MeshCore::MeshFacet::VISIT));
-        startFacet = iCur - iBeg;
-        while (startFacet != ULONG_MAX) {
-            // collect all facets of the same geometry
-            std::vector<unsigned long> indices;
-            indices.push_back(startFacet);
-            (*it)->Initialize(startFacet);
-            MeshSurfaceVisitor pv(**it, indices);
-            myKernel.VisitNeighbourFacets(pv, startFacet);
+        if (iCur < iEnd)
+            startFacet = iCur - iBeg;
+        else
+            startFacet = ULONG_MAX;
+    }
+}
+
+void MeshSegmentAlgorithm::FindStatelessSegments(MeshSurfaceSegment* segm, std::vector<unsigned long>& resetVisited)
+{
+    // As the test of a facet doesn't depend on the segment the regions are the connected
+    // components of the accepted facets, which can be computed in parallel. A start facet
+    // that fails the test merges all components adjacent to it, like the region growing
+    // in FindSegments() does.
+    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
+    unsigned long numFacets = rFAry.size();
+    SegmentLabeling labels(rFAry, *segm);
+    labels.Run();
+
+    // list the facets of each component in ascending order
+    std::vector<unsigned long> offsets(numFacets + 1, 0);
+    for (unsigned long i=0; i<numFacets; i++) {
+        if (labels.IsAccepted(i))
+            offsets[labels.GetRoot(i) + 1]++;
+    }
+    for (unsigned long i=0; i<numFacets; i++)
+        offsets[i + 1] += offsets[i];
+    std::vector<unsigned long> members(offsets.back());
+    std::vector<unsigned long> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned long i=0; i<numFacets; i++) {
+        if (labels.IsAccepted(i))
+            members[fill[labels.GetRoot(i)]++] = i;
+    }
+
+    std::vector<unsigned long> indices;
+    for (unsigned long startFacet=0; startFacet<numFacets; startFacet++) {
+        const MeshFacet& face = rFAry[startFacet];
+        if (face.IsFlag(MeshCore::MeshFacet::VISIT))
+            continue;
 
-            // add or discard the segment
-            if (indices.size() == 1) {
-                resetVisited.push_back(startFacet);
+        indices.clear();
+        std::vector<unsigned long> roots;
+        if (labels.IsAccepted(startFacet)) {
+            roots.push_back(labels.GetRoot(startFacet));
+        }
+        else {
+            indices.push_back(startFacet);
+            face.SetFlag(MeshCore::MeshFacet::VISIT);
+            for (int i=0; i<3; i++) {
+                unsigned long n = face._aulNeighbours[i];
+                if (n < numFacets && labels.IsAccepted(n) && !rFAry[n].IsFlag(MeshCore::MeshFacet::VISIT)) {
+                    unsigned long root = labels.GetRoot(n);
+                    if (std::find(roots.begin(), roots.end(), root) == roots.end())
+                        roots.push_back(root);
+                }
             }
-            else {
-                (*it)->AddSegment(indices);
+        }
+
+        for (std::vector<unsigned long>::iterator it = roots.begin(); it != roots.end(); ++it) {
+            for (unsigned long j=offsets[*it]; j<offsets[*it+1]; j++) {
+                indices.push_back(members[j]);
+                rFAry[members[j]].SetFlag(MeshCore::MeshFacet::VISIT);
             }
+        }
 
-            // search for the next start facet
-            iCur = std::find_if(iCur, iEnd, std::bind2nd(MeshCore::MeshIsNotFlag<MeshCore::MeshFacet>(),
-                MeshCore::MeshFacet::VISIT));
-            if (iCur < iEnd)
-                startFacet = iCur - iBeg;
-            else
-                startFacet = ULONG_MAX;
+        // add or discard the segment
+        if (indices.size() == 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            segm->AddSegment(indices);
         }
     }
 }
@@ -30,7 +30,7 @@
 
 namespace MeshCore {
 
-class PlaneFit;
+class IncrementalPlaneFit;
 class MeshFacet;
 typedef std::vector<unsigned long> MeshSegment;
 
@@ -41,6 +41,11 @@ public:
         : minFacets(minFacets) {}
     virtual ~MeshSurfaceSegment() {}
     virtual bool TestFacet (const MeshFacet &rclFacet) const = 0;
+    /** Returns true if the result of TestFacet() does not depend on the facets that have
+     * been added to the segment so far. In this case the facets can be tested in parallel
+     * and the regions can be grown independently of each other.
+     */
+    virtual bool IsStateless() const { return false; }
     virtual const char* GetType() const = 0;
     virtual void Initialize(unsigned long);
     virtual void AddFacet(const MeshFacet& rclFacet);
@@ -79,7 +84,7 @@ public:
 protected:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
-    PlaneFit* fitter;
+    IncrementalPlaneFit* fitter;
 };
 
 // --------------------------------------------------------
@@ -89,6 +94,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    virtual bool IsStateless() const { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -168,11 +174,18 @@ protected:
 class MeshExport MeshSegmentAlgorithm
 {
 public:
-    MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
+    MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel), myParallel(true) {}
     void FindSegments(std::vector<MeshSurfaceSegment*>&);
+    /// Stateless segments are labelled in parallel unless this is disabled
+    void SetParallel(bool on) { myParallel = on; }
+
+private:
+    void FindSegments(MeshSurfaceSegment*, std::vector<unsigned long>& resetVisited);
+    void FindStatelessSegments(MeshSurfaceSegment*, std::vector<unsigned long>& resetVisited);
 
 private:
     const MeshKernel& myKernel;
+    bool myParallel;
 };
 
 } // MeshCore
@@ -23,147 +23,286 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
+#include <QFuture>
+#include <QtConcurrentRun>
+#include <QThread>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+
 #include "Smoothing.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
 #include "Elements.h"
 #include "Iterator.h"
 #include "Approximation.h"
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
 
 
 using namespace MeshCore;
 
-
-AbstractSmoothing::AbstractSmoothing(MeshKernel& m) : kernel(m)
+namespace MeshCore {
+/**
+ * Topology and point coordinates shared by the worker threads of the smoothing algorithms.
+ * The point neighbourhoods are stored in compressed form (offset + index arrays) and are
+ * only read by the threads. The coordinates are kept in separate float arrays which are
+ * double-buffered: an iteration reads from the current buffer and writes into the other
+ * one, so the result does not depend on the order in which the points are handled.
+ */
+class SmoothingData
 {
-}
+public:
+    enum Selection {
+        AllPoints,      ///< smooth all points
+        SelectedPoints  ///< smooth only the given points
+    };
+
+    typedef boost::function<void (unsigned long, unsigned long)> BlockFunction;
+
+    SmoothingData(const MeshKernel& kernel, Selection sel,
+                  const std::vector<unsigned long>& indices = std::vector<unsigned long>())
+      : selection(sel), current(0)
+    {
+        const MeshPointArray& points = kernel.GetPoints();
+        const MeshFacetArray& facets = kernel.GetFacets();
+        unsigned long numPoints = points.size();
+
+        // each facet adds its two other corners to the neighbourhood of a point
+        std::vector<unsigned long> count(numPoints + 1, 0);
+        for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            for (int i=0; i<3; i++)
+                count[it->_aulPoints[i] + 1] += 2;
+        }
+        for (unsigned long i=0; i<numPoints; i++)
+            count[i + 1] += count[i];
+        std::vector<unsigned long> all(count.back());
+        std::vector<unsigned long> fill(count.begin(), count.end() - 1);
+        for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            for (int i=0; i<3; i++) {
+                unsigned long p = it->_aulPoints[i];
+                all[fill[p]++] = it->_aulPoints[(i+1)%3];
+                all[fill[p]++] = it->_aulPoints[(i+2)%3];
+            }
+        }
 
-AbstractSmoothing::~AbstractSmoothing()
-{
-}
+        // remove duplicates, a point is at the border if the number of its neighbour
+        // points differs from the number of its facets
+        offsets.resize(numPoints + 1, 0);
+        neighbours.reserve(all.size() / 2);
+        border.resize(numPoints, 0);
+        for (unsigned long i=0; i<numPoints; i++) {
+            std::vector<unsigned long>::iterator beg = all.begin() + count[i];
+            std::vector<unsigned long>::iterator end = all.begin() + count[i+1];
+            std::sort(beg, end);
+            end = std::unique(beg, end);
+            neighbours.insert(neighbours.end(), beg, end);
+            offsets[i + 1] = neighbours.size();
+            unsigned long numFacets = (count[i+1] - count[i]) / 2;
+            if (offsets[i + 1] - offsets[i] != numFacets)
+                border[i] = 1;
+        }
 
-void AbstractSmoothing::initialize(Component comp, Continuity cont)
-{
-    this->component = comp;
-    this->continuity = cont;
-}
+        if (selection == SelectedPoints) {
+            for (std::vector<unsigned long>::const_iterator it = indices.begin(); it != indices.end(); ++it) {
+                if (*it < numPoints)
+                    work.push_back(*it);
+            }
+            std::sort(work.begin(), work.end());
+            work.erase(std::unique(work.begin(), work.end()), work.end());
+        }
+        else {
+            work.resize(numPoints);
+            for (unsigned long i=0; i<numPoints; i++)
+                work[i] = i;
+        }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-  : AbstractSmoothing(m)
-{
-}
+        for (int i=0; i<2; i++) {
+            x[i].resize(numPoints);
+            y[i].resize(numPoints);
+            z[i].resize(numPoints);
+        }
+        for (unsigned long i=0; i<numPoints; i++) {
+            x[0][i] = x[1][i] = points[i].x;
+            y[0][i] = y[1][i] = points[i].y;
+            z[0][i] = z[1][i] = points[i].z;
+        }
+    }
 
-PlaneFitSmoothing::~PlaneFitSmoothing()
-{
-}
+    /** Splits the work list into blocks and runs \a func on them in parallel. Afterwards
+     * the buffers are swapped. Nothing is done for an empty work list.
+     */
+    void Run(const BlockFunction& func)
+    {
+        unsigned long numPoints = work.size();
+        if (numPoints == 0)
+            return;
+        unsigned long numThreads = std::max<int>(1, QThread::idealThreadCount());
+        unsigned long numBlocks = std::min<unsigned long>(4 * numThreads, numPoints / 1024 + 1);
+        if (numBlocks == 1) {
+            func(0, numPoints);
+        }
+        else {
+            std::vector< QFuture<void> > futures;
+            futures.reserve(numBlocks);
+            for (unsigned long i=0; i<numBlocks; i++) {
+                futures.push_back(QtConcurrent::run(boost::bind(func,
+                    i * numPoints / numBlocks, (i + 1) * numPoints / numBlocks)));
+            }
+            for (std::vector< QFuture<void> >::iterator it = futures.begin(); it != futures.end(); ++it) {
+                it->waitForFinished();
+            }
+        }
 
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
-{
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
+        current = 1 - current;
+    }
+
+    /** Moves the points of the work list by the Laplacian weighted with \a stepsize. */
+    void Umbrella(double stepsize, unsigned long begin, unsigned long end)
+    {
+        const float* sx = &x[current][0]; const float* sy = &y[current][0]; const float* sz = &z[current][0];
+        float* dx = &x[1-current][0]; float* dy = &y[1-current][0]; float* dz = &z[1-current][0];
+
+        for (unsigned long k=begin; k<end; k++) {
+            unsigned long i = work[k];
+            unsigned long n_count = offsets[i+1] - offsets[i];
+            // do nothing for border points
+            if (n_count < 3 || border[i]) {
+                dx[i] = sx[i]; dy[i] = sy[i]; dz[i] = sz[i];
                 continue;
+            }
 
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
+            double w = 1.0/double(n_count);
+            double delx=0.0,dely=0.0,delz=0.0;
+            for (unsigned long j=offsets[i]; j<offsets[i+1]; j++) {
+                unsigned long n = neighbours[j];
+                delx += w*(sx[n]-sx[i]);
+                dely += w*(sy[n]-sy[i]);
+                delz += w*(sz[n]-sz[i]);
             }
 
-            float scale = 1.0f/((float)cv.size()+1.0f);
+            dx[i] = (float)(sx[i]+stepsize*delx);
+            dy[i] = (float)(sy[i]+stepsize*dely);
+            dz[i] = (float)(sz[i]+stepsize*delz);
+        }
+    }
+
+    /** Moves the points of the work list towards the mean plane of their neighbourhood. */
+    void PlaneFit(float tolerance, unsigned long begin, unsigned long end)
+    {
+        const float* sx = &x[current][0]; const float* sy = &y[current][0]; const float* sz = &z[current][0];
+        float* dx = &x[1-current][0]; float* dy = &y[1-current][0]; float* dz = &z[1-current][0];
+
+        for (unsigned long k=begin; k<end; k++) {
+            unsigned long i = work[k];
+            dx[i] = sx[i]; dy[i] = sy[i]; dz[i] = sz[i];
+            unsigned long n_count = offsets[i+1] - offsets[i];
+            if (n_count < 3)
+                continue;
+
+            Base::Vector3f point(sx[i], sy[i], sz[i]);
+            Base::Vector3f center(point);
+            IncrementalPlaneFit pf;
+            pf.AddPoint(point);
+            for (unsigned long j=offsets[i]; j<offsets[i+1]; j++) {
+                unsigned long n = neighbours[j];
+                Base::Vector3f neighbour(sx[n], sy[n], sz[n]);
+                pf.AddPoint(neighbour);
+                center += neighbour;
+            }
+
+            float scale = 1.0f/((float)n_count+1.0f);
             center.Scale(scale,scale,scale);
 
             // get the mean plane of the current vertex with the surrounding vertices
             pf.Fit();
-            N = pf.GetNormal();
+            Base::Vector3f N = pf.GetNormal();
             N.Normalize();
 
             // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
+            Base::Vector3f L = point - center;
             if (N*L < 0.0)
                 N.Scale(-1.0, -1.0, -1.0);
 
             // maximum value to move is distance to mean plane
-            float d = std::min<float>((float)fabs(this->tolerance),(float)fabs(N*L));
+            float d = std::min<float>((float)fabs(tolerance),(float)fabs(N*L));
             N.Scale(d,d,d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
+            dx[i] = point.x - N.x; dy[i] = point.y - N.y; dz[i] = point.z - N.z;
         }
+    }
 
-        // assign values without affecting iterators
-        unsigned long count = kernel.CountPoints();
-        for (unsigned long idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
+    /** Writes the coordinates of the points of the work list back to the kernel. */
+    void Assign(MeshKernel& kernel) const
+    {
+        for (std::vector<unsigned long>::const_iterator it = work.begin(); it != work.end(); ++it) {
+            kernel.SetPoint(*it, x[current][*it], y[current][*it], z[current][*it]);
         }
     }
+
+private:
+    Selection selection;
+    std::vector<unsigned long> work;
+    std::vector<unsigned long> offsets;
+    std::vector<unsigned long> neighbours;
+    std::vector<char> border;
+    std::vector<float> x[2], y[2], z[2];
+    int current;
+};
 }
 
-void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
+
+AbstractSmoothing::AbstractSmoothing(MeshKernel& m) : kernel(m)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (std::vector<unsigned long>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-            v_it.Set(*it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
+}
 
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+AbstractSmoothing::~AbstractSmoothing()
+{
+}
 
-            float scale = 1.0f/((float)cv.size()+1.0f);
-            center.Scale(scale,scale,scale);
+void AbstractSmoothing::initialize(Component comp, Continuity cont)
+{
+    this->component = comp;
+    this->continuity = cont;
+}
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+  : AbstractSmoothing(m)
+{
+}
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0)
-                N.Scale(-1.0, -1.0, -1.0);
+PlaneFitSmoothing::~PlaneFitSmoothing()
+{
+}
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>((float)fabs(this->tolerance),(float)fabs(N*L));
-            N.Scale(d,d,d);
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    SmoothingData data(kernel, SmoothingData::AllPoints);
+    Iterate(iterations, data);
+}
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
+{
+    SmoothingData data(kernel, SmoothingData::SelectedPoints, point_indices);
+    Iterate(iterations, data);
+}
 
-        // assign values without affecting iterators
-        unsigned long count = kernel.CountPoints();
-        for (unsigned long idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
+void PlaneFitSmoothing::Iterate(unsigned int iterations, SmoothingData& data)
+{
+    try {
+        Base::SequencerLauncher seq("Smoothing...", iterations);
+        for (unsigned int i=0; i<iterations; i++) {
+            data.Run(boost::bind(&SmoothingData::PlaneFit, &data, this->tolerance, _1, _2));
+            seq.next(true);
         }
     }
+    catch (const Base::AbortException&) {
+        // keep the result of the finished iterations
+    }
+
+    data.Assign(kernel);
 }
 
 LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
@@ -175,95 +314,37 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+void LaplaceSmoothing::Umbrella(SmoothingData& data, double stepsize)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    unsigned long pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<unsigned long>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        unsigned int n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*((v_beg[*cv_it]).x-v_it->x);
-            dely += w*((v_beg[*cv_it]).y-v_it->y);
-            delz += w*((v_beg[*cv_it]).z-v_it->z);
-        }
-
-        float x = (float)(v_it->x+stepsize*delx);
-        float y = (float)(v_it->y+stepsize*dely);
-        float z = (float)(v_it->z+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
-    }
+    data.Run(boost::bind(&SmoothingData::Umbrella, &data, stepsize, _1, _2));
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
-                                const std::vector<unsigned long>& point_indices)
+void LaplaceSmoothing::Iterate(unsigned int iterations, SmoothingData& data)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<unsigned long>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
+    try {
+        Base::SequencerLauncher seq("Smoothing...", iterations);
+        for (unsigned int i=0; i<iterations; i++) {
+            Umbrella(data, lambda);
+            seq.next(true);
         }
-
-        unsigned int n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*((v_beg[*cv_it]).z-(v_beg[*pos]).z);
-        }
-
-        float x = (float)((v_beg[*pos]).x+stepsize*delx);
-        float y = (float)((v_beg[*pos]).y+stepsize*dely);
-        float z = (float)((v_beg[*pos]).z+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
     }
+    catch (const Base::AbortException&) {
+        // keep the result of the finished iterations
+    }
+
+    data.Assign(kernel);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    SmoothingData data(kernel, SmoothingData::AllPoints);
+    Iterate(iterations, data);
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    SmoothingData data(kernel, SmoothingData::SelectedPoints, point_indices);
+    Iterate(iterations, data);
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -275,30 +356,21 @@ TaubinSmoothing::~TaubinSmoothing()
 {
 }
 
-void TaubinSmoothing::Smooth(unsigned int iterations)
+void TaubinSmoothing::Iterate(unsigned int iterations, SmoothingData& data)
 {
-    MeshCore::MeshPointArray::_TConstIterator v_it;
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+    try {
+        Base::SequencerLauncher seq("Smoothing...", iterations);
+        for (unsigned int i=0; i<iterations; i++) {
+            Umbrella(data, lambda);
+            Umbrella(data, -(lambda+micro));
+            seq.next(true);
+        }
     }
-}
-
-void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
-{
-    MeshCore::MeshPointArray::_TConstIterator v_it;
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    // Theoretically Taubin does not shrink the surface
-    iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+    catch (const Base::AbortException&) {
+        // keep the result of the finished iterations
     }
+
+    data.Assign(kernel);
 }
@@ -29,8 +29,7 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
+class SmoothingData;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -56,6 +55,13 @@ public:
     virtual void Smooth(unsigned int) = 0;
     virtual void SmoothPoints(unsigned int, const std::vector<unsigned long>&) = 0;
 
+protected:
+    /** Runs the given number of iterations on \a data. The iterations are reported to a
+     * Base::SequencerLauncher and can be cancelled by the user between two iterations. In
+     * this case the result of the finished iterations is kept.
+     */
+    virtual void Iterate(unsigned int, SmoothingData&) = 0;
+
 protected:
     MeshKernel& kernel;
 
@@ -71,6 +77,9 @@ public:
     virtual ~PlaneFitSmoothing();
     void Smooth(unsigned int);
     void SmoothPoints(unsigned int, const std::vector<unsigned long>&);
+
+protected:
+    void Iterate(unsigned int, SmoothingData&);
 };
 
 class MeshExport LaplaceSmoothing : public AbstractSmoothing
@@ -83,11 +92,8 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
-                  const std::vector<unsigned long>&);
+    void Iterate(unsigned int, SmoothingData&);
+    void Umbrella(SmoothingData&, double);
 
 protected:
     double lambda;
@@ -98,10 +104,11 @@ class MeshExport TaubinSmoothing : public LaplaceSmoothing
 public:
     TaubinSmoothing(MeshKernel&);
     virtual ~TaubinSmoothing();
-    void Smooth(unsigned int);
-    void SmoothPoints(unsigned int, const std::vector<unsigned long>&);
     void SetMicro(double m) { micro = m;}
 
+protected:
+    void Iterate(unsigned int, SmoothingData&);
+
 protected:
     double micro;
 };
@@ -42,10 +42,13 @@ using namespace Mesh;
 
 PROPERTY_SOURCE(Mesh::Curvature, App::DocumentObject)
 
+const char* Curvature::MethodEnums[]= {"ShapeOperator","Discrete",NULL};
 
 Curvature::Curvature(void)
 {
     ADD_PROPERTY(Source,(0));
+    ADD_PROPERTY(Method,(long(0)));
+    Method.setEnums(MethodEnums);
     ADD_PROPERTY(CurvInfo, (CurvatureInfo()));
 }
 
@@ -53,6 +56,8 @@ short Curvature::mustExecute() const
 {
     if (Source.isTouched())
         return 1;
+    if (Method.isTouched())
+        return 1;
     if (Source.getValue() && Source.getValue()->isTouched())
         return 1;
     return 0;
@@ -68,7 +73,10 @@ App::DocumentObjectExecReturn *Curvature::execute(void)
     // get all points
     const MeshCore::MeshKernel& rMesh = pcFeat->Mesh.getValue().getKernel();
     MeshCore::MeshCurvature meshCurv(rMesh);
-    meshCurv.ComputePerVertex();
+    if (Method.getValue() == 1)
+        meshCurv.ComputePerVertex(true, MeshCore::MeshCurvature::Discrete);
+    else
+        meshCurv.ComputePerVertex(true, MeshCore::MeshCurvature::ShapeOperator);
     const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
 
     std::vector<CurvatureInfo> values;
@@ -46,6 +46,7 @@ public:
     Curvature();
 
     App::PropertyLink Source;
+    App::PropertyEnumeration Method;
     PropertyCurvatureList CurvInfo;
 
     /** @name methods overide Feature */
@@ -58,6 +59,9 @@ public:
         return "MeshGui::ViewProviderMeshCurvature"; 
     }
   //@}
+
+private:
+    static const char* MethodEnums[];
 };
 
 }
@@ -34,6 +34,7 @@
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Interpreter.h>
+#include <Base/Profiler.h>
 #include <Base/Sequencer.h>
 #include <Base/ViewProj.h>
 
@@ -308,6 +309,7 @@ void MeshObject::save(const char* file, MeshCore::MeshIO::Format f,
                       const MeshCore::Material* mat,
                       const char* objectname) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::save");
     MeshCore::MeshOutput aWriter(this->_kernel, mat);
     if (objectname)
         aWriter.SetObjectName(objectname);
@@ -317,11 +319,13 @@ void MeshObject::save(const char* file, MeshCore::MeshIO::Format f,
 
 void MeshObject::save(std::ostream& out) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::save");
     _kernel.Write(out);
 }
 
 bool MeshObject::load(const char* file, MeshCore::Material* mat)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::load");
     MeshCore::MeshKernel kernel;
     MeshCore::MeshInput aReader(kernel, mat);
     if (!aReader.LoadAny(file))
@@ -380,6 +384,7 @@ bool MeshObject::load(const char* file, MeshCore::Material* mat)
 
 void MeshObject::load(std::istream& in)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::load");
     _kernel.Read(in);
     this->_segments.clear();
 
@@ -686,6 +691,7 @@ unsigned long MeshObject::getPointDegree(const std::vector<unsigned long>& indic
 void MeshObject::fillupHoles(unsigned long length, int level,
                              MeshCore::AbstractPolygonTriangulator& cTria)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::fillupHoles");
     std::list<std::vector<unsigned long> > aFailed;
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     topalg.FillupHoles(length, level, cTria, aFailed);
@@ -705,6 +711,7 @@ void MeshObject::offset(float fSize)
 
 void MeshObject::offsetSpecial2(float fSize)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::offsetSpecial2");
     Base::Builder3D builder;  
     std::vector<Base::Vector3f> PointNormals= _kernel.CalcVertexNormals();
     std::vector<Base::Vector3f> FaceNormals;
@@ -817,6 +824,7 @@ void MeshObject::setPoint(unsigned long index, const Base::Vector3d& p)
 
 void MeshObject::smooth(int iterations, float d_max)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::smooth");
     _kernel.Smooth(iterations, d_max);
 }
 
@@ -857,6 +865,7 @@ std::vector<Base::Vector3d> MeshObject::getPointNormals() const
 void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, std::vector<MeshObject::TPolylines> &sections,
                                float fMinEps, bool bConnectPolygons) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::crossSections");
     MeshCore::MeshFacetGrid grid(_kernel);
     MeshCore::MeshAlgorithm algo(_kernel);
     for (std::vector<MeshObject::TPlane>::const_iterator it = planes.begin(); it != planes.end(); ++it) {
@@ -918,6 +927,7 @@ void MeshObject::trim(const Base::Polygon2D& polygon2d,
 
 MeshObject* MeshObject::unite(const MeshObject& mesh) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::unite");
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
     kernel1.Transform(this->_Mtrx);
@@ -931,6 +941,7 @@ MeshObject* MeshObject::unite(const MeshObject& mesh) const
 
 MeshObject* MeshObject::intersect(const MeshObject& mesh) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::intersect");
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
     kernel1.Transform(this->_Mtrx);
@@ -944,6 +955,7 @@ MeshObject* MeshObject::intersect(const MeshObject& mesh) const
 
 MeshObject* MeshObject::subtract(const MeshObject& mesh) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::subtract");
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
     kernel1.Transform(this->_Mtrx);
@@ -957,6 +969,7 @@ MeshObject* MeshObject::subtract(const MeshObject& mesh) const
 
 MeshObject* MeshObject::inner(const MeshObject& mesh) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::inner");
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
     kernel1.Transform(this->_Mtrx);
@@ -970,6 +983,7 @@ MeshObject* MeshObject::inner(const MeshObject& mesh) const
 
 MeshObject* MeshObject::outer(const MeshObject& mesh) const
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::outer");
     MeshCore::MeshKernel result;
     MeshCore::MeshKernel kernel1(this->_kernel);
     kernel1.Transform(this->_Mtrx);
@@ -983,6 +997,7 @@ MeshObject* MeshObject::outer(const MeshObject& mesh) const
 
 void MeshObject::refine()
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::refine");
     unsigned long cnt = _kernel.CountFacets();
     MeshCore::MeshFacetIterator cF(_kernel);
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
@@ -999,6 +1014,7 @@ void MeshObject::refine()
 
 void MeshObject::optimizeTopology(float fMaxAngle)
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::optimizeTopology");
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
     if (fMaxAngle > 0.0f)
         topalg.OptimizeTopology(fMaxAngle);
@@ -1123,6 +1139,7 @@ void MeshObject::flipNormals()
 
 void MeshObject::harmonizeNormals()
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::harmonizeNormals");
     MeshCore::MeshTopoAlgorithm alg(_kernel);
     alg.HarmonizeNormals();
 }
@@ -1157,6 +1174,7 @@ bool MeshObject::hasSelfIntersections() const
 
 void MeshObject::removeSelfIntersections()
 {
+    FC_PROFILE_SCOPE("mesh", "MeshObject::removeSelfIntersections");
     std::vector<std::pair<unsigned long, unsigned long> > selfIntersections;
     MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
     cMeshEval.GetIntersections(selfIntersections);
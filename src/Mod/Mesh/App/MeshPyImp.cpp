@@ -140,7 +140,11 @@ PyObject*  MeshPy::read(PyObject *args)
         return NULL;                         
 
     PY_TRY {
-        getMeshObjectPtr()->load(Name);
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->load(Name);
     } PY_CATCH;
     
     Py_Return; 
@@ -195,10 +199,19 @@ PyObject*  MeshPy::write(PyObject *args)
                 mat.binding = MeshCore::MeshIO::PER_FACE;
             else
                 mat.binding = MeshCore::MeshIO::OVERALL;
-            getMeshObjectPtr()->save(Name, format, &mat, ObjName);
+
+            Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.release();
+            mesh->save(Name, format, &mat, ObjName);
         }
         else {
-            getMeshObjectPtr()->save(Name, format, 0, ObjName);
+            Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.release();
+            mesh->save(Name, format, 0, ObjName);
         }
     } PY_CATCH;
 
@@ -241,7 +254,11 @@ PyObject*  MeshPy::offset(PyObject *args)
         return NULL;
 
     PY_TRY {
-        getMeshObjectPtr()->offsetSpecial2(Float);
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->offsetSpecial2(Float);
     } PY_CATCH;
 
     Py_Return; 
@@ -303,7 +320,14 @@ PyObject*  MeshPy::crossSections(PyObject *args)
     }
 
     std::vector<MeshObject::TPolylines> sections;
-    getMeshObjectPtr()->crossSections(csPlanes, sections, min_eps, PyObject_IsTrue(poly) ? true : false);
+    bool connectEdges = PyObject_IsTrue(poly) ? true : false;
+    PY_TRY {
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        mesh->crossSections(csPlanes, sections, min_eps, connectEdges);
+    } PY_CATCH;
 
     // convert to Python objects
     Py::List crossSections;
@@ -332,7 +356,16 @@ PyObject*  MeshPy::unite(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = 0;
+        {
+            Base::Reference<MeshObject> mesh1(getMeshObjectPtr());
+            Base::Reference<MeshObject> mesh2(pcObject->getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(pcObject);
+            threads.release();
+            mesh = mesh1->unite(*mesh2);
+        }
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -349,7 +382,16 @@ PyObject*  MeshPy::intersect(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = 0;
+        {
+            Base::Reference<MeshObject> mesh1(getMeshObjectPtr());
+            Base::Reference<MeshObject> mesh2(pcObject->getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(pcObject);
+            threads.release();
+            mesh = mesh1->intersect(*mesh2);
+        }
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -366,7 +408,16 @@ PyObject*  MeshPy::difference(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = 0;
+        {
+            Base::Reference<MeshObject> mesh1(getMeshObjectPtr());
+            Base::Reference<MeshObject> mesh2(pcObject->getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(pcObject);
+            threads.release();
+            mesh = mesh1->subtract(*mesh2);
+        }
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -383,7 +434,16 @@ PyObject*  MeshPy::inner(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = 0;
+        {
+            Base::Reference<MeshObject> mesh1(getMeshObjectPtr());
+            Base::Reference<MeshObject> mesh2(pcObject->getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(pcObject);
+            threads.release();
+            mesh = mesh1->inner(*mesh2);
+        }
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -400,7 +460,16 @@ PyObject*  MeshPy::outer(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = 0;
+        {
+            Base::Reference<MeshObject> mesh1(getMeshObjectPtr());
+            Base::Reference<MeshObject> mesh2(pcObject->getMeshObjectPtr());
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(pcObject);
+            threads.release();
+            mesh = mesh1->outer(*mesh2);
+        }
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -839,7 +908,11 @@ PyObject*  MeshPy::fixSelfIntersections(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
     try {
-        getMeshObjectPtr()->removeSelfIntersections();
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->removeSelfIntersections();
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
@@ -920,7 +993,11 @@ PyObject*  MeshPy::harmonizeNormals(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->harmonizeNormals();
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->harmonizeNormals();
     } PY_CATCH;
 
     Py_Return; 
@@ -969,7 +1046,11 @@ PyObject*  MeshPy::fillupHoles(PyObject *args)
         }
 
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->fillupHoles(len, level, *tria);
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->fillupHoles(len, level, *tria);
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
@@ -1046,7 +1127,11 @@ PyObject*  MeshPy::refine(PyObject *args)
         return NULL;
 
     PY_TRY {
-        getMeshObjectPtr()->refine();
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->refine();
     } PY_CATCH;
 
     Py_Return; 
@@ -1060,7 +1145,11 @@ PyObject*  MeshPy::optimizeTopology(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->optimizeTopology(fMaxAngle);
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->optimizeTopology(fMaxAngle);
     } PY_CATCH;
 
     Py_Return; 
@@ -1432,7 +1521,11 @@ PyObject*  MeshPy::smooth(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->smooth(iter, d_max);
+        Base::Reference<MeshObject> mesh(getMeshObjectPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        mesh->smooth(iter, d_max);
     } PY_CATCH;
 
     Py_Return; 
@@ -1528,11 +1621,13 @@ PyObject*  MeshPy::getPlanarSegments(PyObject *args)
 PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
 {
     PyObject* l;
-    if (!PyArg_ParseTuple(args, "O",&l))
+    PyObject* parallel = Py_True;
+    if (!PyArg_ParseTuple(args, "O|O!",&l,&PyBool_Type,&parallel))
         return NULL;
 
     const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
     MeshCore::MeshSegmentAlgorithm finder(kernel);
+    finder.SetParallel(PyObject_IsTrue(parallel) ? true : false);
     MeshCore::MeshCurvature meshCurv(kernel);
     meshCurv.ComputePerVertex();
 
@@ -36,6 +36,17 @@ class MeshTopoTestCases(unittest.TestCase):
 		planarMeshObject = Mesh.Mesh(self.planarMesh)
 		planarMeshObject.collapseFacets(range(18))
 
+	def testBinaryRoundTrip(self):
+		# the open edges must survive independent of the index storage size
+		planarMeshObject = Mesh.Mesh(self.planarMesh)
+		name = tempfile.gettempdir() + os.sep + "planar.bms"
+		planarMeshObject.write(name)
+		mesh = Mesh.Mesh(name)
+		os.remove(name)
+		self.failUnless(mesh.Topology == planarMeshObject.Topology)
+		for i in range(mesh.CountFacets):
+			self.failUnless(mesh.Facets[i].NeighbourIndices == planarMeshObject.Facets[i].NeighbourIndices)
+
 
 class MeshGeoTestCases(unittest.TestCase):
 	def setUp(self):
@@ -71,6 +82,35 @@ class MeshGeoTestCases(unittest.TestCase):
 		res=f1.intersect(f2)
 		self.failUnless(len(res) == 0)
 
+class CurvatureCases(unittest.TestCase):
+	def setUp(self):
+		self.doc = FreeCAD.newDocument("CurvatureTest")
+		self.mesh = self.doc.addObject("Mesh::Feature","Sphere")
+		self.mesh.Mesh = Mesh.createSphere(2.0,50)
+		self.curv = self.doc.addObject("Mesh::Curvature","Curvature")
+		self.curv.Source = self.mesh
+
+	def checkSphere(self, tolerance):
+		self.doc.recompute()
+		values = self.curv.CurvInfo
+		self.failUnless(len(values) == self.mesh.Mesh.CountPoints)
+		# the vertices at the poles are irregular, so only check the average
+		maxCurv = sum([i[0] for i in values]) / len(values)
+		minCurv = sum([i[1] for i in values]) / len(values)
+		self.failUnless(math.fabs(maxCurv - 0.5) < tolerance, "Max. curvature %f differs from 0.5" % maxCurv)
+		self.failUnless(math.fabs(minCurv - 0.5) < tolerance, "Min. curvature %f differs from 0.5" % minCurv)
+
+	def testShapeOperator(self):
+		self.curv.Method = "ShapeOperator"
+		self.checkSphere(0.05)
+
+	def testDiscrete(self):
+		self.curv.Method = "Discrete"
+		self.checkSphere(0.1)
+
+	def tearDown(self):
+		FreeCAD.closeDocument("CurvatureTest")
+
 class PivyTestCases(unittest.TestCase):
 	def setUp(self):
 		# set up a planar face with 2 triangles
@@ -220,3 +260,140 @@ class PolynomialFitCases(unittest.TestCase):
 
     def tearDown(self):
         pass
+
+
+class SegmentationCases(unittest.TestCase):
+    def setUp(self):
+        # use enough facets to split the labelling into several blocks
+        self.mesh = Mesh.createTorus(8.0, 2.0, 100)
+
+    def testParallelSegments(self):
+        self.failUnless(self.mesh.CountFacets > 4096)
+        outer = (0.5, 0.1, 0.05, 0.05, 10)
+        inner = (0.5, -0.17, 0.05, 0.05, 10)
+        seq = self.mesh.getSegmentsByCurvature([outer, inner], False)
+        par = self.mesh.getSegmentsByCurvature([outer, inner])
+        self.failUnless([sorted(i) for i in seq] == [sorted(i) for i in par])
+
+    def tearDown(self):
+        pass
+
+
+class SmoothingCases(unittest.TestCase):
+    def setUp(self):
+        # use enough points to split the iterations into several blocks
+        self.mesh = Mesh.createSphere(10.0, 100)
+
+    def laplace(self, points, facets, iterations, stepsize=0.6307):
+        # serial reference of the Laplace smoothing, border points are kept
+        neighbours = [set() for i in points]
+        count = [0 for i in points]
+        for f in facets:
+            for i in range(3):
+                neighbours[f[i]].add(f[(i+1)%3])
+                neighbours[f[i]].add(f[(i+2)%3])
+                count[f[i]] += 1
+        points = [FreeCAD.Vector(p) for p in points]
+        for k in range(iterations):
+            result = []
+            for i in range(len(points)):
+                p = points[i]
+                n = neighbours[i]
+                if len(n) < 3 or len(n) != count[i]:
+                    result.append(p)
+                    continue
+                d = FreeCAD.Vector()
+                for j in n:
+                    d = d + points[j] - p
+                result.append(p + d * (stepsize / len(n)))
+            points = result
+        return points
+
+    def testParallelSmoothing(self):
+        self.failUnless(self.mesh.CountPoints > 4096)
+        points, facets = self.mesh.Topology
+        reference = self.laplace(points, facets, 3)
+        self.mesh.smooth(3)
+        result = self.mesh.Topology[0]
+        for i in range(len(result)):
+            self.failUnless((result[i] - reference[i]).Length < 0.0001)
+
+    def testEmptyMesh(self):
+        mesh = Mesh.Mesh()
+        mesh.smooth(3)
+        self.failUnless(mesh.CountPoints == 0)
+
+    def tearDown(self):
+        pass
+
+
+class MappedMeshCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createTorus(8.0, 2.0, 50)
+        self.files = []
+
+    def tempName(self, name):
+        name = tempfile.gettempdir() + os.sep + name
+        self.files.append(name)
+        return name
+
+    def testRoundTrip(self):
+        mapped = self.tempName("mesh.fcmo")
+        stl = self.tempName("mapped.stl")
+        Mesh.createMapped(self.mesh, mapped)
+        info = Mesh.readMapped(mapped, stl)
+        self.failUnless(info["CountPoints"] == self.mesh.CountPoints)
+        self.failUnless(info["CountFacets"] == self.mesh.CountFacets)
+        self.failUnless(info["CompactIndices"])
+        self.failUnless(math.fabs(info["Area"] - self.mesh.Area) < 0.01)
+        self.failUnless(math.fabs(info["Volume"] - self.mesh.Volume) < 0.01)
+        mesh = Mesh.read(stl)
+        self.failUnless(mesh.CountFacets == self.mesh.CountFacets)
+        self.failUnless(math.fabs(mesh.Area - self.mesh.Area) < 0.01)
+
+    def testFromSTL(self):
+        stl = self.tempName("mesh.stl")
+        mapped = self.tempName("stl.fcmo")
+        self.mesh.write(stl)
+        Mesh.createMapped(stl, mapped, False)
+        info = Mesh.readMapped(mapped)
+        self.failUnless(info["CountPoints"] == 3 * self.mesh.CountFacets)
+        self.failUnless(info["CountFacets"] == self.mesh.CountFacets)
+        self.failIf(info["CompactIndices"])
+        self.failUnless(math.fabs(info["Area"] - self.mesh.Area) < 0.01)
+
+    def testTruncatedSTL(self):
+        stl = self.tempName("truncated.stl")
+        mapped = self.tempName("truncated.fcmo")
+        self.mesh.write(stl)
+        data = open(stl, "rb").read()
+        file = open(stl, "wb")
+        file.write(data[:len(data) // 2])
+        file.close()
+        self.failUnlessRaises(Exception, Mesh.createMapped, stl, mapped)
+        self.failIf(os.path.exists(mapped))
+
+    def testCorruptFile(self):
+        import struct
+        mapped = self.tempName("corrupt.fcmo")
+        Mesh.createMapped(self.mesh, mapped)
+        data = open(mapped, "rb").read()
+        # header: magic, version, index size, number of points and facets
+        version, size, points, facets = struct.unpack("<IIQQ", data[8:32])
+        offset = (64 + 12 * points + 7) & ~7
+        fmt = "<I" if size == 4 else "<Q"
+        corrupt = data[:offset] + struct.pack(fmt, points) + data[offset + size:]
+        file = open(mapped, "wb")
+        file.write(corrupt)
+        file.close()
+        self.failUnlessRaises(Exception, Mesh.readMapped, mapped)
+        # truncated facet array
+        file = open(mapped, "wb")
+        file.write(data[:len(data) - 4])
+        file.close()
+        self.failUnlessRaises(Exception, Mesh.readMapped, mapped)
+
+    def tearDown(self):
+        for i in self.files:
+            if os.path.exists(i):
+                os.remove(i)
@@ -16,6 +16,7 @@
 # include <IGESControl_Controller.hxx>
 # include <STEPControl_Controller.hxx>
 # include <OSD.hxx>
+# include <Standard.hxx>
 # include <sstream>
 #endif
 
@@ -120,6 +121,14 @@ void PartExport initPart()
     OSD::SetSignal(Standard_False);
 #endif
 
+    // Several algorithms of Part and of the modules based on it (tessellation,
+    // decoding of shape containers, refinement, multi fuse, intersection checks)
+    // run OCC code in worker threads. This makes the memory manager and the
+    // reference counting of handles thread-safe for the whole process. It's
+    // switched on once here and never reset because a worker may still be
+    // running when another algorithm finishes.
+    Standard::SetReentrant(Standard_True);
+
     PyObject* partModule = Py_InitModule3("Part", Part_methods, module_part_doc);   /* mod name, table ptr */
     Base::Console().Log("Loading Part module... done\n");
     PyObject* OCCError = 0;
@@ -0,0 +1,390 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <map>
+# include <string>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRepAlgoAPI_Fuse.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
+# include <TopTools_ListIteratorOfListOfShape.hxx>
+# include <QtConcurrentMap>
+#endif
+
+#include "BooleanBuilder.h"
+#include <Base/Profiler.h>
+
+using namespace Part;
+
+namespace Part {
+// A shape taking part in the fusion together with the images of the faces of
+// the input shapes it was made of.
+struct FuseNode {
+    TopoDS_Shape shape;
+    TopTools_DataMapOfShapeListOfShape images;
+    std::string error;
+};
+}
+
+namespace {
+
+// maps the images of the faces through the modifications of a boolean operation
+void mapImages(BRepBuilderAPI_MakeShape& mkShape,
+               const TopTools_DataMapOfShapeListOfShape& images,
+               TopTools_DataMapOfShapeListOfShape& result)
+{
+    TopTools_DataMapIteratorOfDataMapOfShapeListOfShape it;
+    for (it.Initialize(images); it.More(); it.Next()) {
+        TopTools_ListOfShape faces;
+        TopTools_ListIteratorOfListOfShape jt;
+        for (jt.Initialize(it.Value()); jt.More(); jt.Next()) {
+            const TopTools_ListOfShape& modified = mkShape.Modified(jt.Value());
+            if (!modified.IsEmpty()) {
+                TopTools_ListIteratorOfListOfShape kt;
+                for (kt.Initialize(modified); kt.More(); kt.Next())
+                    faces.Append(kt.Value());
+            }
+            else if (!mkShape.IsDeleted(jt.Value())) {
+                faces.Append(jt.Value());
+            }
+        }
+        result.Bind(it.Key(), faces);
+    }
+}
+
+// fuses the shapes of a group, with OCC up to 6.8 the group must have exactly two shapes
+struct FuseTask {
+    typedef FuseNode result_type;
+
+    FuseTask(Standard_Real tolerance, bool parallel)
+      : tolerance(tolerance), parallel(parallel)
+    {
+    }
+
+    FuseNode operator()(const std::vector<FuseNode>& nodes) const
+    {
+        FC_PROFILE_SCOPE("occ", "MultiFuseBuilder::fuse");
+        FuseNode result;
+        try {
+#if OCC_VERSION_HEX <= 0x060800
+            BRepAlgoAPI_Fuse mkFuse(nodes[0].shape, nodes[1].shape);
+#else
+            BRepAlgoAPI_Fuse mkFuse;
+            TopTools_ListOfShape shapeArguments, shapeTools;
+            shapeArguments.Append(nodes.front().shape);
+            for (std::vector<FuseNode>::const_iterator it = nodes.begin() + 1; it != nodes.end(); ++it)
+                shapeTools.Append(it->shape);
+            mkFuse.SetArguments(shapeArguments);
+            mkFuse.SetTools(shapeTools);
+            if (tolerance > 0.0)
+                mkFuse.SetFuzzyValue(tolerance);
+#if OCC_VERSION_HEX >= 0x060900
+            mkFuse.SetRunParallel(parallel ? Standard_True : Standard_False);
+#endif
+            mkFuse.Build();
+#endif
+            if (!mkFuse.IsDone()) {
+                result.error = "Fusion failed";
+                return result;
+            }
+            result.shape = mkFuse.Shape();
+            for (std::vector<FuseNode>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+                mapImages(mkFuse, it->images, result.images);
+        }
+        catch (Standard_Failure) {
+            Handle_Standard_Failure e = Standard_Failure::Caught();
+            result.error = e->GetMessageString();
+            if (result.error.empty())
+                result.error = "Fusion failed";
+        }
+        return result;
+    }
+
+    Standard_Real tolerance;
+    bool parallel;
+};
+
+// gives the node its own copy of the shape, so that it doesn't share any
+// sub-shapes with the nodes fused in another thread
+void copyNode(FuseNode& node)
+{
+    BRepBuilderAPI_Copy mkCopy(node.shape);
+    TopTools_DataMapOfShapeListOfShape images;
+    mapImages(mkCopy, node.images, images);
+    node.shape = mkCopy.Shape();
+    node.images = images;
+}
+
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t index)
+{
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+struct MinXLess {
+    MinXLess(const std::vector<Bnd_Box>& boxes) : boxes(boxes) {}
+    bool operator()(std::size_t a, std::size_t b) const
+    {
+        Standard_Real xa, ya, za, Xa, Ya, Za, xb, yb, zb, Xb, Yb, Zb;
+        boxes[a].Get(xa, ya, za, Xa, Ya, Za);
+        boxes[b].Get(xb, yb, zb, Xb, Yb, Zb);
+        return xa < xb;
+    }
+    const std::vector<Bnd_Box>& boxes;
+};
+
+}
+
+MultiFuseBuilder::MultiFuseBuilder()
+  : myTolerance(0.0), myTreeReduction(false), myRunParallel(true)
+{
+}
+
+MultiFuseBuilder::MultiFuseBuilder(const std::vector<TopoDS_Shape>& shapes)
+  : myShapes(shapes), myTolerance(0.0), myTreeReduction(false), myRunParallel(true)
+{
+}
+
+void MultiFuseBuilder::setShapes(const std::vector<TopoDS_Shape>& shapes)
+{
+    myShapes = shapes;
+}
+
+void MultiFuseBuilder::setTolerance(Standard_Real tolerance)
+{
+    myTolerance = tolerance;
+}
+
+void MultiFuseBuilder::setTreeReduction(bool on)
+{
+    myTreeReduction = on;
+}
+
+void MultiFuseBuilder::setRunParallel(bool on)
+{
+    myRunParallel = on;
+}
+
+void MultiFuseBuilder::Build()
+{
+    FC_PROFILE_SCOPE("occ", "MultiFuseBuilder::Build");
+    myImages.Clear();
+    if (myShapes.empty())
+        Standard_Failure::Raise("No shapes to fuse");
+#if OCC_VERSION_HEX <= 0x060800
+    if (myTolerance > 0.0)
+        Standard_Failure::Raise("Fuzzy Booleans are not supported in this version of OCCT");
+    const bool treeReduction = true;
+#else
+    const bool treeReduction = myTreeReduction;
+#endif
+
+    std::size_t count = myShapes.size();
+    std::vector<FuseNode> nodes(count);
+    std::vector<Bnd_Box> boxes(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const TopoDS_Shape& shape = myShapes[i];
+        if (shape.IsNull())
+            Standard_Failure::Raise("Input shape is null");
+        FuseNode& node = nodes[i];
+        if (myTolerance > 0.0) {
+            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
+            BRepBuilderAPI_Copy mkCopy(shape);
+            node.shape = mkCopy.Shape();
+            for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next())
+                node.images.Bind(xp.Current(), mkCopy.Modified(xp.Current()));
+        }
+        else {
+            node.shape = shape;
+            for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+                TopTools_ListOfShape faces;
+                faces.Append(xp.Current());
+                node.images.Bind(xp.Current(), faces);
+            }
+        }
+
+        BRepBndLib::Add(shape, boxes[i]);
+        boxes[i].SetGap(0.0);
+        if (myTolerance > 0.0)
+            boxes[i].Enlarge(myTolerance);
+    }
+
+    // group the shapes with overlapping bounding boxes, sweeping along the x axis
+    std::vector<std::size_t> parent(count);
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < count; i++) {
+        parent[i] = i;
+        if (!boxes[i].IsVoid())
+            order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), MinXLess(boxes));
+    for (std::size_t i = 0; i < order.size(); i++) {
+        Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+        boxes[order[i]].Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        for (std::size_t j = i + 1; j < order.size(); j++) {
+            Standard_Real x, y, z, X, Y, Z;
+            boxes[order[j]].Get(x, y, z, X, Y, Z);
+            if (x > xmax)
+                break;
+            if (!boxes[order[i]].IsOut(boxes[order[j]])) {
+                std::size_t a = findRoot(parent, order[i]);
+                std::size_t b = findRoot(parent, order[j]);
+                if (a != b)
+                    parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    // the groups in the order of their first shape, a root is always its group's first shape
+    std::map<std::size_t, std::vector<FuseNode> > groups;
+    for (std::size_t i = 0; i < count; i++)
+        groups[findRoot(parent, i)].push_back(nodes[i]);
+    nodes.clear();
+
+    // The input shapes may share sub-shapes, which the boolean operations must not
+    // modify concurrently. The results of the tasks only share sub-shapes with the
+    // inputs of their own task, so it's sufficient to copy the inputs once.
+    std::size_t numTasks = 0;
+    for (std::map<std::size_t, std::vector<FuseNode> >::iterator it = groups.begin(); it != groups.end(); ++it) {
+        std::size_t size = it->second.size();
+        if (size >= 2)
+            numTasks += treeReduction ? size / 2 : 1;
+    }
+    if (myRunParallel && numTasks > 1) {
+        // the fuzzy workaround above has already copied the shapes
+        if (myTolerance <= 0.0) {
+            for (std::map<std::size_t, std::vector<FuseNode> >::iterator it = groups.begin(); it != groups.end(); ++it) {
+                if (it->second.size() < 2)
+                    continue;
+                for (std::vector<FuseNode>::iterator jt = it->second.begin(); jt != it->second.end(); ++jt)
+                    copyNode(*jt);
+            }
+        }
+    }
+    FuseTask fuse(myTolerance, myRunParallel);
+    for (;;) {
+        // with the tree reduction every pass fuses pairs of shapes, otherwise whole groups
+        QList< std::vector<FuseNode> > tasks;
+        std::vector<std::size_t> owners;
+        for (std::map<std::size_t, std::vector<FuseNode> >::iterator it = groups.begin(); it != groups.end(); ++it) {
+            std::vector<FuseNode>& group = it->second;
+            if (group.size() < 2)
+                continue;
+            if (!treeReduction) {
+                tasks.append(group);
+                owners.push_back(it->first);
+                group.clear();
+                continue;
+            }
+            std::vector<FuseNode> rest;
+            for (std::size_t i = 0; i + 1 < group.size(); i += 2) {
+                std::vector<FuseNode> pair;
+                pair.push_back(group[i]);
+                pair.push_back(group[i + 1]);
+                tasks.append(pair);
+                owners.push_back(it->first);
+            }
+            if (group.size() % 2)
+                rest.push_back(group.back());
+            group.swap(rest);
+        }
+        if (tasks.isEmpty())
+            break;
+
+        QList<FuseNode> results;
+        if (myRunParallel && tasks.size() > 1) {
+            results = QtConcurrent::blockingMapped< QList<FuseNode> >(tasks, fuse);
+        }
+        else {
+            for (QList< std::vector<FuseNode> >::iterator it = tasks.begin(); it != tasks.end(); ++it)
+                results.append(fuse(*it));
+        }
+
+        for (int i = 0; i < results.size(); i++) {
+            if (!results[i].error.empty())
+                Standard_Failure::Raise(results[i].error.c_str());
+            groups[owners[i]].push_back(results[i]);
+        }
+    }
+
+    if (groups.size() == 1) {
+        myShape = groups.begin()->second.front().shape;
+    }
+    else {
+        // the separate groups don't touch each other, so they are just put into a compound
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (std::map<std::size_t, std::vector<FuseNode> >::iterator it = groups.begin(); it != groups.end(); ++it) {
+            const TopoDS_Shape& shape = it->second.front().shape;
+            if (shape.ShapeType() == TopAbs_COMPOUND) {
+                for (TopoDS_Iterator xp(shape); xp.More(); xp.Next())
+                    builder.Add(comp, xp.Value());
+            }
+            else {
+                builder.Add(comp, shape);
+            }
+        }
+        myShape = comp;
+    }
+
+    for (std::map<std::size_t, std::vector<FuseNode> >::iterator it = groups.begin(); it != groups.end(); ++it) {
+        TopTools_DataMapIteratorOfDataMapOfShapeListOfShape jt;
+        for (jt.Initialize(it->second.front().images); jt.More(); jt.Next())
+            myImages.Bind(jt.Key(), jt.Value());
+    }
+
+    Done();
+}
+
+const TopTools_ListOfShape& MultiFuseBuilder::Modified(const TopoDS_Shape& S)
+{
+    if (!myImages.IsBound(S))
+        return myEmptyList;
+    // an unchanged face is not reported as modified
+    const TopTools_ListOfShape& images = myImages.Find(S);
+    if (images.Extent() == 1 && images.First().IsSame(S))
+        return myEmptyList;
+    return images;
+}
+
+Standard_Boolean MultiFuseBuilder::IsDeleted(const TopoDS_Shape& S)
+{
+    if (!myImages.IsBound(S))
+        return Standard_False;
+    return myImages.Find(S).IsEmpty() ? Standard_True : Standard_False;
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PART_BOOLEANBUILDER_H
+#define PART_BOOLEANBUILDER_H
+
+#include <vector>
+#include <BRepBuilderAPI_MakeShape.hxx>
+#include <TopTools_DataMapOfShapeListOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+namespace Part
+{
+
+/**
+ * MultiFuseBuilder fuses an arbitrary number of shapes.
+ *
+ * Only shapes whose bounding boxes overlap, directly or through a chain of other
+ * shapes, are fused with each other. A shape apart from all others is added
+ * unchanged to the resulting compound. The independent groups are fused in
+ * parallel and, with OCC 6.9 or later, the boolean operations themselves run in
+ * parallel mode, too.
+ *
+ * A group is fused either with one general fuse of all its shapes or by a tree
+ * reduction, i.e. by fusing pairs of shapes, then pairs of the results and so
+ * on. OCC versions up to 6.8 can only fuse two shapes at once, so the tree
+ * reduction is always used there.
+ *
+ * The history is recorded for the faces of the input shapes.
+ */
+class PartExport MultiFuseBuilder : public BRepBuilderAPI_MakeShape
+{
+public:
+    MultiFuseBuilder();
+    MultiFuseBuilder(const std::vector<TopoDS_Shape>&);
+
+    /// sets the shapes to fuse
+    void setShapes(const std::vector<TopoDS_Shape>&);
+    /// sets the fuzzy value, it's not supported before OCC 6.8.1
+    void setTolerance(Standard_Real);
+    /// fuses the shapes of a group by pairs instead of with one general fuse
+    void setTreeReduction(bool);
+    /// runs the fusion of independent groups and the OCC booleans in parallel
+    void setRunParallel(bool);
+
+    void Build();
+    const TopTools_ListOfShape& Modified(const TopoDS_Shape& S);
+    Standard_Boolean IsDeleted(const TopoDS_Shape& S);
+
+private:
+    std::vector<TopoDS_Shape> myShapes;
+    Standard_Real myTolerance;
+    bool myTreeReduction;
+    bool myRunParallel;
+    TopTools_DataMapOfShapeListOfShape myImages;
+    TopTools_ListOfShape myEmptyList;
+};
+
+} //namespace Part
+
+#endif // PART_BOOLEANBUILDER_H
@@ -27,6 +27,8 @@
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopTools_ListOfShape.hxx>
 #endif
 
 
@@ -86,11 +88,24 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
 
     if (s.size() >= 2) {
         try {
+            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             std::vector<ShapeHistory> history;
             TopoDS_Shape resShape = s.front();
             for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
                 // Let's call algorithm computing a fuse operation:
+#if OCC_VERSION_HEX >= 0x060900
+                BRepAlgoAPI_Common mkCommon;
+                TopTools_ListOfShape shapeArguments,shapeTools;
+                shapeArguments.Append(resShape);
+                shapeTools.Append(*it);
+                mkCommon.SetArguments(shapeArguments);
+                mkCommon.SetTools(shapeTools);
+                mkCommon.SetRunParallel(hGrp->GetBool("RunParallel", true));
+                mkCommon.Build();
+#else
                 BRepAlgoAPI_Common mkCommon(resShape, *it);
+#endif
                 // Let's check if the fusion has been successful
                 if (!mkCommon.IsDone()) 
                     throw Base::Exception("Intersection failed");
@@ -111,8 +126,6 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
             if (resShape.IsNull())
                 throw Base::Exception("Resulting shape is invalid");
 
-            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             if (hGrp->GetBool("CheckModel", false)) {
                  BRepCheck_Analyzer aChecker(resShape);
                  if (! aChecker.IsValid() ) {
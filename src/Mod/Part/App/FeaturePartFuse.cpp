@@ -30,6 +30,7 @@
 
 
 #include "FeaturePartFuse.h"
+#include "BooleanBuilder.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -85,58 +86,28 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
 
     if (s.size() >= 2) {
         try {
+            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             std::vector<ShapeHistory> history;
-#if OCC_VERSION_HEX <= 0x060800
-            TopoDS_Shape resShape = s.front();
-            if (resShape.IsNull())
-                throw Base::Exception("Input shape is null");
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
-                if (it->IsNull())
-                    throw Base::Exception("Input shape is null");
-
-                // Let's call algorithm computing a fuse operation:
-                BRepAlgoAPI_Fuse mkFuse(resShape, *it);
-                // Let's check if the fusion has been successful
-                if (!mkFuse.IsDone()) 
-                    throw Base::Exception("Fusion failed");
-                resShape = mkFuse.Shape();
-
-                ShapeHistory hist1 = buildHistory(mkFuse, TopAbs_FACE, resShape, mkFuse.Shape1());
-                ShapeHistory hist2 = buildHistory(mkFuse, TopAbs_FACE, resShape, mkFuse.Shape2());
-                if (history.empty()) {
-                    history.push_back(hist1);
-                    history.push_back(hist2);
-                }
-                else {
-                    for (std::vector<ShapeHistory>::iterator jt = history.begin(); jt != history.end(); ++jt)
-                        *jt = joinHistory(*jt, hist1);
-                    history.push_back(hist2);
-                }
-            }
-#else
-            BRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments,shapeTools;
-            shapeArguments.Append(s.front());
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
+            for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
                 if (it->IsNull())
                     throw Base::Exception("Input shape is null");
-                shapeTools.Append(*it);
             }
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
+
+            // shapes apart from all others are not fused but put into the resulting compound
+            MultiFuseBuilder mkFuse(s);
+            mkFuse.setRunParallel(hGrp->GetBool("RunParallel", true));
+            mkFuse.setTreeReduction(hGrp->GetBool("TreeReduction", false));
             mkFuse.Build();
             if (!mkFuse.IsDone())
                 throw Base::Exception("MultiFusion failed");
             TopoDS_Shape resShape = mkFuse.Shape();
+            if (resShape.IsNull())
+                throw Base::Exception("Resulting shape is null");
             for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
                 history.push_back(buildHistory(mkFuse, TopAbs_FACE, resShape, *it));
             }
-#endif
-            if (resShape.IsNull())
-                throw Base::Exception("Resulting shape is null");
 
-            Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-                .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             if (hGrp->GetBool("CheckModel", false)) {
                 BRepCheck_Analyzer aChecker(resShape);
                 if (! aChecker.IsValid() ) {
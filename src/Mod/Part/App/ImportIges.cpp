@@ -107,28 +107,37 @@ int Part::ImportIgesParts(App::Document *pcDoc, const char* FileName)
         TopoDS_Compound comp;
         builder.MakeCompound(comp);
 
-        Standard_Integer nbShapes = aReader.NbShapes();
-        for (Standard_Integer i=1; i<=nbShapes; i++) {
-            TopoDS_Shape aShape = aReader.Shape(i);
-            if (!aShape.IsNull()) {
-                if (aShape.ShapeType() == TopAbs_SOLID ||
-                    aShape.ShapeType() == TopAbs_COMPOUND ||
-                    aShape.ShapeType() == TopAbs_SHELL) {
-                        App::DocumentObject* obj = pcDoc->addObject("Part::Feature", aName.c_str());
-                        static_cast<Part::Feature*>(obj)->Shape.setValue(aShape);
-                }
-                else {
-                    builder.Add(comp, aShape);
-                    emptyComp = Standard_False;
+        // announce the new features all at once
+        pcDoc->beginBulkCreation();
+        try {
+            Standard_Integer nbShapes = aReader.NbShapes();
+            for (Standard_Integer i=1; i<=nbShapes; i++) {
+                TopoDS_Shape aShape = aReader.Shape(i);
+                if (!aShape.IsNull()) {
+                    if (aShape.ShapeType() == TopAbs_SOLID ||
+                        aShape.ShapeType() == TopAbs_COMPOUND ||
+                        aShape.ShapeType() == TopAbs_SHELL) {
+                            App::DocumentObject* obj = pcDoc->addObject("Part::Feature", aName.c_str());
+                            static_cast<Part::Feature*>(obj)->Shape.setValue(aShape);
+                    }
+                    else {
+                        builder.Add(comp, aShape);
+                        emptyComp = Standard_False;
+                    }
                 }
             }
+            if (!emptyComp) {
+                std::string name = fi.fileNamePure();
+                Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject
+                    ("Part::Feature", name.c_str()));
+                pcFeature->Shape.setValue(comp);
+            }
         }
-        if (!emptyComp) {
-            std::string name = fi.fileNamePure();
-            Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject
-                ("Part::Feature", name.c_str()));
-            pcFeature->Shape.setValue(comp);
+        catch (...) {
+            pcDoc->endBulkCreation();
+            throw;
         }
+        pcDoc->endBulkCreation();
 #else
         // put all other free-flying shapes into a single compound
         Standard_Boolean emptyComp = Standard_True;
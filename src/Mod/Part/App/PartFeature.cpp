@@ -119,20 +119,18 @@ void Feature::onChanged(const App::Property* prop)
 {
     // if the placement has changed apply the change to the point data as well
     if (prop == &this->Placement) {
-        TopoShape& shape = const_cast<TopoShape&>(this->Shape.getShape());
-        shape.setTransform(this->Placement.getValue().toMatrix());
+        this->Shape.setTransform(this->Placement.getValue().toMatrix());
     }
     // if the point data has changed check and adjust the transformation as well
     else if (prop == &this->Shape) {
         if (this->isRecomputing()) {
-            TopoShape& shape = const_cast<TopoShape&>(this->Shape.getShape());
-            shape.setTransform(this->Placement.getValue().toMatrix());
+            this->Shape.setTransform(this->Placement.getValue().toMatrix());
         }
         else {
             Base::Placement p;
             // shape must not be null to override the placement
-            if (!this->Shape.getValue().IsNull()) {
-                p.fromMatrix(this->Shape.getShape().getTransform());
+            if (!this->Shape.isNull()) {
+                p.fromMatrix(this->Shape.getTransform());
                 if (p != this->Placement.getValue())
                     this->Placement.setValue(p);
             }
@@ -142,6 +140,18 @@ void Feature::onChanged(const App::Property* prop)
     GeoFeature::onChanged(prop);
 }
 
+void Feature::onDocumentRestored()
+{
+    // a shape saved as an instance is linked when the file of its master is read
+    std::string name = this->Shape.getInstanceOf();
+    if (!this->Shape.finishRestore()) {
+        Base::Console().Warning("Shape of '%s' refers to the missing object '%s'\n",
+            getNameInDocument(), name.c_str());
+    }
+
+    GeoFeature::onDocumentRestored();
+}
+
 TopLoc_Location Feature::getLocation() const
 {
     Base::Placement pl = this->Placement.getValue();
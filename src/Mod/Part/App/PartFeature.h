@@ -76,6 +76,7 @@ public:
 
 protected:
     void onChanged(const App::Property* prop);
+    void onDocumentRestored();
     TopLoc_Location getLocation() const;
     /**
      * Build a history of changes
@@ -33,14 +33,20 @@
 # include <BRepTools.hxx>
 # include <BRepTools_ShapeSet.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
+# include <BRep_Tool.hxx>
+# include <Poly_Triangulation.hxx>
+# include <Standard_Version.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopTools_MapOfShape.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Iterator.hxx>
 # include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
 # include <Standard_Failure.hxx>
 # include <gp_GTrsf.hxx>
 # include <gp_Trsf.hxx>
+# include <QMutex>
+# include <QMutexLocker>
 #endif
 
 
@@ -52,10 +58,13 @@
 #include <Base/FileInfo.h>
 #include <Base/Stream.h>
 #include <App/Application.h>
+#include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/ObjectIdentifier.h>
 
 #include "PropertyTopoShape.h"
+#include "PartFeature.h"
+#include "ShapeContainer.h"
 #include "TopoShapePy.h"
 #include "TopoShapeFacePy.h"
 #include "TopoShapeEdgePy.h"
@@ -70,7 +79,7 @@ using namespace Part;
 
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData);
 
-PropertyPartShape::PropertyPartShape()
+PropertyPartShape::PropertyPartShape() : _ContentHash(0)
 {
 }
 
@@ -82,6 +91,9 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
     _Shape = sh;
+    _Container.reset();
+    _ContentHash = 0;
+    _InstanceOf.clear();
     hasSetValue();
 }
 
@@ -89,27 +101,103 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh)
 {
     aboutToSetValue();
     _Shape._Shape = sh;
+    _Container.reset();
+    _ContentHash = 0;
+    _InstanceOf.clear();
     hasSetValue();
 }
 
+void PropertyPartShape::setInstance(const PropertyPartShape& master, const Base::Matrix4D& mat)
+{
+    aboutToSetValue();
+    _InstanceOf.clear();
+    _Container = master._Container;
+    _ContentHash = master._ContentHash;
+    if (_Container) {
+        _Shape = TopoShape();
+        _EncodedTransform = mat;
+    }
+    else {
+        _Shape._Shape = master._Shape._Shape;
+        _Shape.setTransform(mat);
+    }
+    hasSetValue();
+}
+
+// A restored shape is decoded on its first access, which may happen in any thread,
+// e.g. while the GIL is released. The decoding of all shapes is serialized.
+static QMutex decodeMutex;
+
+void PropertyPartShape::decode() const
+{
+    QMutexLocker lock(&decodeMutex);
+    if (_Container && _Shape._Shape.IsNull()) {
+        // all instances of the container share the decoded shape
+        _Shape._Shape = _Container->getShape();
+        _Shape.setTransform(_EncodedTransform);
+        // a container that couldn't be decoded completely is kept to write it unchanged
+        if (!_Container->hasFailed())
+            _Container.reset();
+    }
+}
+
 const TopoDS_Shape& PropertyPartShape::getValue(void)const 
 {
+    decode();
     return _Shape._Shape;
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    decode();
     return this->_Shape;
 }
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    decode();
     return &(this->_Shape);
 }
 
+bool PropertyPartShape::isNull() const
+{
+    return !_Container && _Shape._Shape.IsNull();
+}
+
+Base::Matrix4D PropertyPartShape::getTransform() const
+{
+    if (_Container)
+        return _EncodedTransform;
+    return _Shape.getTransform();
+}
+
+void PropertyPartShape::setTransform(const Base::Matrix4D& mat)
+{
+    if (_Container) {
+        _EncodedTransform = mat;
+        // the shape of a kept container is already decoded
+        if (_Shape._Shape.IsNull())
+            return;
+    }
+    _Shape.setTransform(mat);
+}
+
+uint64_t PropertyPartShape::getContentHash() const
+{
+    if (_ContentHash == 0 && !isNull())
+        _ContentHash = ShapeContainer::getContentHash(getValue());
+    return _ContentHash;
+}
+
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
     Base::BoundBox3d box;
+    if (_Container) {
+        box = _Container->getBoundBox();
+        if (box.IsValid())
+            box = box.Transformed(_EncodedTransform);
+        return box;
+    }
     if (_Shape._Shape.IsNull())
         return box;
     try {
@@ -137,20 +225,31 @@ void PropertyPartShape::getFaces(std::vector<Base::Vector3d> &aPoints,
                                  std::vector<Data::ComplexGeoData::Facet> &aTopo,
                                  float accuracy, uint16_t flags) const
 {
+    // use the saved tessellation if it's fine enough
+    if (_Container && _Container->getTessellation(accuracy, aPoints, aTopo)) {
+        for (std::vector<Base::Vector3d>::iterator it = aPoints.begin(); it != aPoints.end(); ++it)
+            *it = _EncodedTransform * (*it);
+        return;
+    }
+
+    decode();
     _Shape.getFaces(aPoints, aTopo, accuracy, flags);
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    decode();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
+    _Container.reset();
+    _ContentHash = 0;
     hasSetValue();
 }
 
 PyObject *PropertyPartShape::getPyObject(void)
 {
     Base::PyObjectBase* prop;
-    const TopoDS_Shape& sh = _Shape._Shape;
+    const TopoDS_Shape& sh = getValue();
     if (sh.IsNull()) {
         prop = new TopoShapePy(new TopoShape(sh));
     }
@@ -210,7 +309,13 @@ App::Property *PropertyPartShape::Copy(void) const
 {
     PropertyPartShape *prop = new PropertyPartShape();
     prop->_Shape = this->_Shape;
-    if (!_Shape._Shape.IsNull()) {
+    prop->_ContentHash = _ContentHash;
+    if (_Container) {
+        // the encoded data is never changed, so it can be shared
+        prop->_Container = _Container;
+        prop->_EncodedTransform = _EncodedTransform;
+    }
+    else if (!_Shape._Shape.IsNull()) {
         BRepBuilderAPI_Copy copy(_Shape._Shape);
         prop->_Shape._Shape = copy.Shape();
     }
@@ -220,13 +325,19 @@ App::Property *PropertyPartShape::Copy(void) const
 
 void PropertyPartShape::Paste(const App::Property &from)
 {
+    const PropertyPartShape& prop = dynamic_cast<const PropertyPartShape&>(from);
     aboutToSetValue();
-    _Shape = dynamic_cast<const PropertyPartShape&>(from)._Shape;
+    _Shape = prop._Shape;
+    _Container = prop._Container;
+    _EncodedTransform = prop._EncodedTransform;
+    _ContentHash = prop._ContentHash;
     hasSetValue();
 }
 
 unsigned int PropertyPartShape::getMemSize (void) const
 {
+    if (_Container)
+        return _Container->getMemSize();
     return _Shape.getMemSize();
 }
 
@@ -244,11 +355,97 @@ void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) cons
                     << App::ObjectIdentifier::Component::SimpleComponent(App::ObjectIdentifier::String("Volume")));
 }
 
+// The binary format is the default. The ASCII format can still be forced with the
+// parameter for projects that must be opened with older versions.
+static bool useBinaryBrep(const Base::Writer &writer)
+{
+    if (writer.getMode("BinaryBrep"))
+        return true;
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("BinaryBrep", true);
+}
+
+// The chunked container with the table of contents can only be read by versions
+// that know it, so it must be enabled with the parameter.
+static bool useShapeContainer(const Base::Writer &writer)
+{
+    if (!useBinaryBrep(writer))
+        return false;
+    if (writer.getMode("ShapeContainer"))
+        return true;
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("ShapeContainer", false);
+}
+
+// Versions that don't know instance references restore them as empty shapes,
+// so they are only written if enabled with the parameter.
+static bool useInstances(const Base::Writer &writer)
+{
+    if (writer.getMode("SaveInstances"))
+        return true;
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("SaveInstances", false);
+}
+
+bool PropertyPartShape::keepContainer(const Base::Writer &writer) const
+{
+    if (useShapeContainer(writer))
+        return true;
+    // A restored shape must be decoded to write it in another format. If that fails
+    // the container is written unchanged, otherwise saving would drop the missing part.
+    if (_Container)
+        decode();
+    return _Container && _Container->hasFailed();
+}
+
+static bool hasTriangulation(const TopoDS_Shape& shape)
+{
+    TopLoc_Location loc;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (!BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull())
+            return true;
+    }
+    return false;
+}
+
 void PropertyPartShape::Save (Base::Writer &writer) const
 {
     if(!writer.isForceXML()) {
+        // Instances of a shape, e.g. the many equal fasteners of an imported assembly,
+        // only refer to the object whose file holds the geometry. Their location is
+        // given by the placement of their feature.
+        // A shape that is still encoded is identified by its container, all
+        // instances of it have the same orientation.
+        App::PropertyContainer* father = this->getContainer();
+        if (!isNull() && useInstances(writer) && father && father->isDerivedFrom(Feature::getClassTypeId())
+            && &static_cast<Feature*>(father)->Shape == this) {
+            // The master is always an object saved by this writer, so a reference never
+            // points outside of the objects written by Document::exportObjects().
+            Feature* feature = static_cast<Feature*>(father);
+            const void* key = _Container ? static_cast<const void*>(_Container.get())
+                                         : static_cast<const void*>(_Shape._Shape.TShape().operator->());
+            std::string master = writer.getSharedName(key);
+            if (master.empty()) {
+                writer.setSharedName(key, feature->getNameInDocument());
+            }
+            else if (feature->getTypeId() == Feature::getClassTypeId()) {
+                App::DocumentObject* obj = feature->getDocument()->getObject(master.c_str());
+                if (obj && (_Container || static_cast<Feature*>(obj)->Shape.getValue().Orientation()
+                                          == _Shape._Shape.Orientation())) {
+                    writer.Stream() << writer.ind() << "<Part file=\"\" instance=\""
+                                    << master << "\"/>" << std::endl;
+                    return;
+                }
+            }
+        }
+
         //See SaveDocFile(), RestoreDocFile()
-        if (writer.getMode("BinaryBrep")) {
+        if (keepContainer(writer)) {
+            writer.Stream() << writer.ind() << "<Part file=\"" 
+                            << writer.addFile("PartShape.bsc", this)
+                            << "\"/>" << std::endl;
+        }
+        else if (useBinaryBrep(writer)) {
             writer.Stream() << writer.ind() << "<Part file=\"" 
                             << writer.addFile("PartShape.bin", this)
                             << "\"/>" << std::endl;
@@ -265,6 +462,19 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 {
     reader.readElement("Part");
     std::string file (reader.getAttribute("file") );
+    _InstanceOf.clear();
+    if (reader.hasAttribute("instance")) {
+        // the object names may have changed when merging documents
+        _InstanceOf = reader.getName(reader.getAttribute("instance"));
+        // all objects exist at this point but their files are not read yet, so the
+        // master links this shape once it has read its own file
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(Feature::getClassTypeId())) {
+            App::DocumentObject* obj = static_cast<Feature*>(father)->getDocument()->getObject(_InstanceOf.c_str());
+            if (obj && obj != father && obj->isDerivedFrom(Feature::getClassTypeId()))
+                static_cast<Feature*>(obj)->Shape._Instances.push_back(this);
+        }
+    }
 
     if (!file.empty()) {
         // initate a file read
@@ -274,19 +484,45 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    bool container = keepContainer(writer);
+    if (_Container) {
+        // a shape that was not accessed since restoring is written unchanged
+        if (container) {
+            _Container->write(writer.Stream(), _EncodedTransform);
+            _ContentHash = _Container->getContentHash();
+            return;
+        }
+        decode();
+    }
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape._Shape.IsNull())
         return;
+
+    if (container) {
+        // stream the shape with its tessellation directly into the project file
+        ShapeContainer::write(writer.Stream(), _Shape._Shape, &_ContentHash);
+        return;
+    }
+
     // NOTE: Cleaning the triangulation may cause problems on some algorithms like BOP
-    // Before writing to the project we clean all triangulation data to save memory
-    BRepBuilderAPI_Copy copy(_Shape._Shape);
-    const TopoDS_Shape& myShape = copy.Shape();
-    BRepTools::Clean(myShape); // remove triangulation
+    // The triangulation is not written to the project. Only if the shape has one it is
+    // dropped from a copy of the topology which shares the geometry with the original.
+    TopoDS_Shape myShape = _Shape._Shape;
+    if (hasTriangulation(myShape)) {
+#if OCC_VERSION_HEX >= 0x060700
+        BRepBuilderAPI_Copy copy(myShape, Standard_False);
+#else
+        BRepBuilderAPI_Copy copy(myShape);
+#endif
+        myShape = copy.Shape();
+        BRepTools::Clean(myShape); // remove triangulation
+    }
 
-    if (writer.getMode("BinaryBrep")) {
-        TopoShape shape;
-        shape._Shape = myShape;
+    if (useBinaryBrep(writer)) {
+        // stream the shape directly into the project file
+        TopoShape shape(myShape);
         shape.exportBinary(writer.Stream());
     }
     else {
@@ -348,7 +584,23 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 {
     Base::FileInfo brep(reader.getFileName());
-    if (brep.hasExtension("bin")) {
+    if (brep.hasExtension("bsc")) {
+        // only the table of contents is read, the shape is decoded on first access
+        boost::shared_ptr<ShapeContainer> container(new ShapeContainer());
+        bool valid = container->read(reader);
+        aboutToSetValue();
+        _Shape = TopoShape();
+        _Container.reset();
+        _ContentHash = 0;
+        _InstanceOf.clear();
+        if (valid) {
+            _Container = container;
+            _EncodedTransform = container->getTransform();
+            _ContentHash = container->getContentHash();
+        }
+        hasSetValue();
+    }
+    else if (brep.hasExtension("bin")) {
         TopoShape shape;
         shape.importBinary(reader);
         setValue(shape);
@@ -404,6 +656,25 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
             setValue(shape);
         }
     }
+
+    linkInstances();
+}
+
+void PropertyPartShape::linkInstances()
+{
+    std::vector<PropertyPartShape*> instances;
+    instances.swap(_Instances);
+    for (std::vector<PropertyPartShape*>::iterator it = instances.begin(); it != instances.end(); ++it) {
+        Feature* feature = static_cast<Feature*>((*it)->getContainer());
+        (*it)->setInstance(*this, feature->Placement.getValue().toMatrix());
+    }
+}
+
+bool PropertyPartShape::finishRestore()
+{
+    // a master without a file never links its instances
+    _Instances.clear();
+    return _InstanceOf.empty();
 }
 
 // -------------------------------------------------------------------------
@@ -28,13 +28,21 @@
 #include <TopAbs_ShapeEnum.hxx>
 #include <App/DocumentObject.h>
 #include <App/PropertyGeo.h>
+#include <boost/shared_ptr.hpp>
 #include <map>
 #include <vector>
 
 namespace Part
 {
 
+class ShapeContainer;
+
 /** The part shape property class.
+ * A shape restored from a project file is only decoded when it is accessed.
+ * Until then the bounding box, the transformation and a tessellation, if one
+ * was saved, are taken from the table of contents of the ShapeContainer.
+ * The decoding is guarded by a mutex, so the first access may happen in any
+ * thread.
  * @author Werner Mayer
  */
 class PartExport PropertyPartShape : public App::PropertyComplexGeoData
@@ -51,10 +59,22 @@ public:
     void setValue(const TopoShape&);
     /// set the part shape
     void setValue(const TopoDS_Shape&);
+    /// share the shape of \a master with the given transformation without decoding it
+    void setInstance(const PropertyPartShape& master, const Base::Matrix4D&);
     /// get the part shape
     const TopoDS_Shape& getValue(void) const;
     const TopoShape& getShape() const;
     const Data::ComplexGeoData* getComplexData() const;
+    /// checks whether the shape is null without decoding it
+    bool isNull() const;
+    /// get the transformation of the shape without decoding it
+    Base::Matrix4D getTransform() const;
+    /// set the transformation of the shape without decoding it
+    void setTransform(const Base::Matrix4D&);
+    /** A hash of the shape data without the placement. It is taken from the
+     * project file or from the last save and only computed if it isn't known.
+     */
+    uint64_t getContentHash() const;
     //@}
 
     /** @name Modification */
@@ -90,13 +110,38 @@ public:
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
+    /** The name of the object whose shape this shape was saved as an instance of.
+     * The shape is linked to the geometry of that object when its file is read.
+     * The name is cleared once the shape is linked.
+     */
+    const std::string& getInstanceOf() const {
+        return _InstanceOf;
+    }
+    /** Called by the owner when the document is restored. Forgets the instances
+     * that wait for the file of this shape and returns false if this shape is an
+     * instance that couldn't be linked.
+     */
+    bool finishRestore();
     //@}
 
     /// Get valid paths for this property; used by auto completer
     virtual void getPaths(std::vector<App::ObjectIdentifier> & paths) const;
 
 private:
-    TopoShape _Shape;
+    void decode() const;
+    bool keepContainer(const Base::Writer &writer) const;
+    void linkInstances();
+
+private:
+    mutable TopoShape _Shape;
+    std::string _InstanceOf;
+    /// the restored instances of this shape which wait for its file
+    std::vector<PropertyPartShape*> _Instances;
+    /// the restored shape as long as it is not decoded
+    mutable boost::shared_ptr<ShapeContainer> _Container;
+    Base::Matrix4D _EncodedTransform;
+    /// the content hash or 0 if unknown
+    mutable uint64_t _ContentHash;
 };
 
 struct PartExport ShapeHistory {
@@ -0,0 +1,549 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <map>
+# include <sstream>
+# include <streambuf>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRep_Tool.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepTools.hxx>
+# include <Poly_Triangulation.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopoDS.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopoDS_Face.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
+# include <QMutexLocker>
+# include <QtConcurrentMap>
+#endif
+
+#include "ShapeContainer.h"
+#include "TopoShape.h"
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/Profiler.h>
+#include <Base/Stream.h>
+
+using namespace Part;
+
+namespace {
+
+const uint32_t containerMagic = 0x43534346; // "FCSC"
+const uint32_t containerVersion = 2;
+// the shape is a compound that is stored with one chunk per child
+const uint32_t splitCompound = 0x1;
+
+// Reads from a block of memory without copying it
+class ChunkStreambuf : public std::streambuf
+{
+public:
+    ChunkStreambuf(const char* data, std::size_t size)
+    {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode)
+    {
+        char* pos;
+        if (way == std::ios_base::beg)
+            pos = eback() + off;
+        else if (way == std::ios_base::cur)
+            pos = gptr() + off;
+        else
+            pos = egptr() + off;
+        if (pos < eback() || pos > egptr())
+            return pos_type(off_type(-1));
+        setg(eback(), pos, egptr());
+        return pos_type(off_type(pos - eback()));
+    }
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+// Decodes the BRep data of a chunk
+struct DecodeChunk
+{
+    typedef TopoDS_Shape result_type;
+
+    DecodeChunk(const std::string* data) : data(data) {}
+    TopoDS_Shape operator()(const ShapeContainer::Chunk& chunk) const
+    {
+        ChunkStreambuf buf(data->data() + chunk.offset, chunk.brepSize);
+        std::istream str(&buf);
+        try {
+            TopoShape shape;
+            shape.importBinary(str);
+            return shape._Shape;
+        }
+        catch (const Base::Exception&) {
+        }
+        catch (Standard_Failure) {
+        }
+        return TopoDS_Shape();
+    }
+
+    const std::string* data;
+};
+
+// The tessellation of a chunk, the points are merged
+struct ChunkMesh
+{
+    ChunkMesh() : deflection(-1.0f) {}
+    std::vector<float> points;
+    std::vector<uint32_t> facets;
+    float deflection;
+};
+
+struct PointLess
+{
+    bool operator()(const Base::Vector3f& p, const Base::Vector3f& q) const
+    {
+        if (p.x != q.x)
+            return p.x < q.x;
+        if (p.y != q.y)
+            return p.y < q.y;
+        return p.z < q.z;
+    }
+};
+
+// Gets the triangulation of all faces, returns false if a face has none
+bool getTriangulation(const TopoDS_Shape& shape, ChunkMesh& mesh)
+{
+    std::map<Base::Vector3f, uint32_t, PointLess> indices;
+    float deflection = 0.0f;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(xp.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) poly = BRep_Tool::Triangulation(face, loc);
+        if (poly.IsNull())
+            return false;
+
+        gp_Trsf trsf = loc.Transformation();
+        const TColgp_Array1OfPnt& nodes = poly->Nodes();
+        std::vector<uint32_t> index(nodes.Length());
+        for (Standard_Integer i = nodes.Lower(); i <= nodes.Upper(); i++) {
+            gp_Pnt p = nodes(i).Transformed(trsf);
+            Base::Vector3f v((float)p.X(), (float)p.Y(), (float)p.Z());
+            std::pair<std::map<Base::Vector3f, uint32_t, PointLess>::iterator, bool> it =
+                indices.insert(std::make_pair(v, (uint32_t)indices.size()));
+            if (it.second) {
+                mesh.points.push_back(v.x);
+                mesh.points.push_back(v.y);
+                mesh.points.push_back(v.z);
+            }
+            index[i - nodes.Lower()] = it.first->second;
+        }
+
+        bool reversed = (face.Orientation() != TopAbs_FORWARD);
+        const Poly_Array1OfTriangle& triangles = poly->Triangles();
+        for (Standard_Integer i = triangles.Lower(); i <= triangles.Upper(); i++) {
+            Standard_Integer n1, n2, n3;
+            triangles(i).Get(n1, n2, n3);
+            if (reversed)
+                std::swap(n1, n2);
+            mesh.facets.push_back(index[n1 - nodes.Lower()]);
+            mesh.facets.push_back(index[n2 - nodes.Lower()]);
+            mesh.facets.push_back(index[n3 - nodes.Lower()]);
+        }
+        deflection = std::max<float>(deflection, (float)poly->Deflection());
+    }
+
+    mesh.deflection = deflection;
+    return true;
+}
+
+// Checks whether the shape is a compound of at least two children that don't share any sub-shape
+bool hasIndependentChildren(const TopoDS_Shape& shape)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND)
+        return false;
+    TopTools_MapOfShape tshapes;
+    int count = 0;
+    for (TopoDS_Iterator it(shape); it.More(); it.Next(), count++) {
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(it.Value(), map);
+        for (int i = 1; i <= map.Extent(); i++) {
+            // compare the shared data only, not the location
+            if (!tshapes.Add(map(i).Located(TopLoc_Location())))
+                return false;
+        }
+    }
+    return count > 1;
+}
+
+Base::BoundBox3d getShapeBox(const TopoDS_Shape& shape)
+{
+    Base::BoundBox3d box;
+    try {
+        Bnd_Box bounds;
+        BRepBndLib::Add(shape, bounds);
+        if (bounds.IsVoid())
+            return box;
+        bounds.SetGap(0.0);
+        bounds.Get(box.MinX, box.MinY, box.MinZ, box.MaxX, box.MaxY, box.MaxZ);
+    }
+    catch (Standard_Failure) {
+    }
+    return box;
+}
+
+// FNV-1a
+uint64_t hashBytes(uint64_t hash, const char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// The chunks of a shape without its location
+struct Encoding
+{
+    int32_t orientation;
+    uint32_t flags;
+    std::vector<ShapeContainer::Chunk> chunks;
+    std::vector<std::string> breps;
+    std::vector<ChunkMesh> meshes;
+    uint64_t hash;
+};
+
+void encode(const TopoDS_Shape& root, Encoding& enc, bool tessellation)
+{
+    // The triangulation goes to the tessellation of the chunks, not into the
+    // BRep data. It is dropped from a copy of the topology which shares the
+    // geometry with the original.
+#if OCC_VERSION_HEX >= 0x060700
+    BRepBuilderAPI_Copy copy(root, Standard_False);
+#else
+    BRepBuilderAPI_Copy copy(root);
+#endif
+    TopoDS_Shape clean = copy.Shape();
+    BRepTools::Clean(clean);
+
+    std::vector<TopoDS_Shape> parts, cleanParts;
+    enc.orientation = (int32_t)root.Orientation();
+    enc.flags = 0;
+    if (hasIndependentChildren(root)) {
+        enc.flags |= splitCompound;
+        // The copy keeps the order of the children. Each child is wrapped into a
+        // compound so that its location and orientation are stored, too.
+        BRep_Builder builder;
+        TopoDS_Iterator jt(clean, Standard_False, Standard_False);
+        for (TopoDS_Iterator it(root, Standard_False, Standard_False); it.More() && jt.More(); it.Next(), jt.Next()) {
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            builder.Add(comp, jt.Value());
+            parts.push_back(it.Value());
+            cleanParts.push_back(comp);
+        }
+    }
+    else {
+        parts.push_back(root);
+        cleanParts.push_back(clean);
+    }
+
+    // the hash covers everything but the location and the tessellation
+    enc.hash = 14695981039346656037ULL;
+    enc.hash = hashBytes(enc.hash, reinterpret_cast<const char*>(&enc.orientation), sizeof(enc.orientation));
+    enc.hash = hashBytes(enc.hash, reinterpret_cast<const char*>(&enc.flags), sizeof(enc.flags));
+
+    enc.chunks.resize(parts.size());
+    enc.breps.resize(parts.size());
+    enc.meshes.resize(parts.size());
+    for (std::size_t i = 0; i < parts.size(); i++) {
+        std::ostringstream str(std::ios::out | std::ios::binary);
+        TopoShape(cleanParts[i]).exportBinary(str);
+        enc.breps[i] = str.str();
+        enc.hash = hashBytes(enc.hash, enc.breps[i].data(), enc.breps[i].size());
+
+        ChunkMesh& mesh = enc.meshes[i];
+        if (tessellation && !getTriangulation(parts[i], mesh))
+            mesh = ChunkMesh();
+
+        ShapeContainer::Chunk& chunk = enc.chunks[i];
+        chunk.box = getShapeBox(parts[i]);
+        chunk.brepSize = (uint32_t)enc.breps[i].size();
+        chunk.numPoints = (uint32_t)(mesh.points.size() / 3);
+        chunk.numFacets = (uint32_t)(mesh.facets.size() / 3);
+        chunk.deflection = mesh.deflection;
+        chunk.offset = 0;
+    }
+}
+
+void writeHeader(Base::OutputStream& str, int32_t orientation, uint32_t flags,
+                 const Base::Matrix4D& transform, uint64_t hash,
+                 const std::vector<ShapeContainer::Chunk>& chunks)
+{
+    double matrix[16];
+    transform.getMatrix(matrix);
+    str << containerMagic << containerVersion << orientation;
+    for (int i = 0; i < 16; i++)
+        str << matrix[i];
+    str << flags << (uint32_t)chunks.size() << hash;
+
+    for (std::vector<ShapeContainer::Chunk>::const_iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        str << it->box.MinX << it->box.MinY << it->box.MinZ
+            << it->box.MaxX << it->box.MaxY << it->box.MaxZ;
+        str << it->brepSize << it->numPoints << it->numFacets << it->deflection;
+    }
+}
+
+}
+
+ShapeContainer::ShapeContainer()
+  : orientation(TopAbs_FORWARD), flags(0), hash(0), decoded(false), failed(false)
+{
+}
+
+ShapeContainer::~ShapeContainer()
+{
+}
+
+void ShapeContainer::write(std::ostream& out, const TopoDS_Shape& input, uint64_t* hash)
+{
+    FC_PROFILE_SCOPE("part", "ShapeContainer::write");
+    Base::Matrix4D transform;
+    TopoShape::convertToMatrix(input.Location().Transformation(), transform);
+
+    Encoding enc;
+    encode(input.Located(TopLoc_Location()), enc, true);
+    if (hash)
+        *hash = enc.hash;
+
+    Base::OutputStream str(out);
+    writeHeader(str, enc.orientation, enc.flags, transform, enc.hash, enc.chunks);
+    for (std::size_t i = 0; i < enc.chunks.size(); i++) {
+        out.write(enc.breps[i].data(), enc.breps[i].size());
+        const ChunkMesh& mesh = enc.meshes[i];
+        for (std::vector<float>::const_iterator it = mesh.points.begin(); it != mesh.points.end(); ++it)
+            str << *it;
+        for (std::vector<uint32_t>::const_iterator it = mesh.facets.begin(); it != mesh.facets.end(); ++it)
+            str << *it;
+    }
+}
+
+void ShapeContainer::write(std::ostream& out, const Base::Matrix4D& mat) const
+{
+    QMutexLocker lock(&mutex);
+    if (decoded && !failed) {
+        // the data has been released after decoding
+        TopoShape copy(this->shape);
+        copy.setTransform(mat);
+        write(out, copy._Shape);
+        return;
+    }
+
+    Base::OutputStream str(out);
+    writeHeader(str, orientation, flags, mat, hash, chunks);
+    out.write(data.data(), data.size());
+}
+
+uint64_t ShapeContainer::getContentHash(const TopoDS_Shape& shape)
+{
+    FC_PROFILE_SCOPE("part", "ShapeContainer::getContentHash");
+    Encoding enc;
+    encode(shape.Located(TopLoc_Location()), enc, false);
+    return enc.hash;
+}
+
+bool ShapeContainer::read(std::istream& in)
+{
+    FC_PROFILE_SCOPE("part", "ShapeContainer::read");
+    Base::InputStream str(in);
+    uint32_t magic = 0, version = 0, count = 0;
+    str >> magic;
+    if (!in)
+        return false; // an empty shape was saved
+    str >> version;
+    if (magic != containerMagic || version < 1 || version > containerVersion)
+        throw Base::RuntimeError("Unknown format of the shape container");
+
+    double matrix[16];
+    str >> orientation;
+    for (int i = 0; i < 16; i++)
+        str >> matrix[i];
+    transform.setMatrix(matrix);
+    str >> flags >> count;
+    hash = 0;
+    if (version > 1)
+        str >> hash;
+
+    std::size_t size = 0;
+    chunks.resize(count);
+    for (std::vector<Chunk>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        str >> it->box.MinX >> it->box.MinY >> it->box.MinZ
+            >> it->box.MaxX >> it->box.MaxY >> it->box.MaxZ;
+        str >> it->brepSize >> it->numPoints >> it->numFacets >> it->deflection;
+        it->offset = size;
+        size += it->brepSize + 3 * sizeof(float) * it->numPoints + 3 * sizeof(uint32_t) * it->numFacets;
+    }
+    if (!in)
+        throw Base::RuntimeError("Unexpected end of the shape container");
+
+    data.resize(size);
+    if (size > 0) {
+        in.read(&data[0], size);
+        if ((std::size_t)in.gcount() != size)
+            throw Base::RuntimeError("Unexpected end of the shape container");
+    }
+
+    shape.Nullify();
+    decoded = false;
+    failed = false;
+    return true;
+}
+
+Base::BoundBox3d ShapeContainer::getBoundBox() const
+{
+    Base::BoundBox3d box;
+    for (std::vector<Chunk>::const_iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        if (it->box.IsValid())
+            box.Add(it->box);
+    }
+    return box;
+}
+
+bool ShapeContainer::getTessellation(float accuracy, std::vector<Base::Vector3d>& points,
+                                     std::vector<Data::ComplexGeoData::Facet>& facets) const
+{
+    QMutexLocker lock(&mutex);
+    if (decoded && !failed)
+        return false;
+    for (std::vector<Chunk>::const_iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        if (it->deflection < 0.0f || it->deflection > accuracy)
+            return false;
+    }
+
+    points.clear();
+    facets.clear();
+    for (std::vector<Chunk>::const_iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        std::size_t mesh = it->offset + it->brepSize;
+        std::size_t length = 3 * sizeof(float) * it->numPoints + 3 * sizeof(uint32_t) * it->numFacets;
+        ChunkStreambuf buf(data.data() + mesh, length);
+        std::istream in(&buf);
+        Base::InputStream str(in);
+
+        uint32_t base = (uint32_t)points.size();
+        for (uint32_t i = 0; i < it->numPoints; i++) {
+            float x, y, z;
+            str >> x >> y >> z;
+            points.push_back(Base::Vector3d(x, y, z));
+        }
+        for (uint32_t i = 0; i < it->numFacets; i++) {
+            Data::ComplexGeoData::Facet face;
+            str >> face.I1 >> face.I2 >> face.I3;
+            face.I1 += base;
+            face.I2 += base;
+            face.I3 += base;
+            facets.push_back(face);
+        }
+    }
+
+    return true;
+}
+
+bool ShapeContainer::isDecoded() const
+{
+    QMutexLocker lock(&mutex);
+    return decoded;
+}
+
+bool ShapeContainer::hasFailed() const
+{
+    QMutexLocker lock(&mutex);
+    return failed;
+}
+
+TopoDS_Shape ShapeContainer::getShape() const
+{
+    QMutexLocker lock(&mutex);
+    if (decoded)
+        return shape;
+
+    FC_PROFILE_SCOPE("part", "ShapeContainer::decode");
+    QList<TopoDS_Shape> parts;
+    if (chunks.size() > 1) {
+        parts = QtConcurrent::blockingMapped< QList<TopoDS_Shape> >
+            (chunks.begin(), chunks.end(), DecodeChunk(&data));
+    }
+    else if (!chunks.empty()) {
+        parts.append(DecodeChunk(&data)(chunks.front()));
+    }
+
+    if (flags & splitCompound) {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (QList<TopoDS_Shape>::iterator it = parts.begin(); it != parts.end(); ++it) {
+            TopoDS_Iterator jt(*it, Standard_False, Standard_False);
+            if (it->IsNull() || !jt.More())
+                failed = true;
+            else
+                builder.Add(comp, jt.Value());
+        }
+        shape = comp;
+    }
+    else if (!parts.isEmpty() && !parts.front().IsNull()) {
+        shape = parts.front();
+    }
+    else {
+        failed = true;
+    }
+
+    if (!shape.IsNull())
+        shape.Orientation((TopAbs_Orientation)orientation);
+
+    if (failed) {
+        // the data is kept and written again, so saving doesn't lose what couldn't be decoded
+        Base::Console().Error("Failed to decode the shape container, the shape is incomplete\n");
+    }
+    else {
+        // the shape is written again from the decoded data
+        std::string().swap(data);
+    }
+    decoded = true;
+    return shape;
+}
+
+unsigned int ShapeContainer::getMemSize() const
+{
+    QMutexLocker lock(&mutex);
+    return (unsigned int)(data.size() + chunks.size() * sizeof(Chunk));
+}
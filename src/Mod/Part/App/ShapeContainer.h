@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PART_SHAPECONTAINER_H
+#define PART_SHAPECONTAINER_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <QMutex>
+#include <TopoDS_Shape.hxx>
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+#include <App/ComplexGeoData.h>
+
+namespace Part
+{
+
+/**
+ * ShapeContainer holds a shape in the chunked binary format and decodes it only
+ * when it is needed. Project files use this format (PartShape.bsc) if the
+ * parameter Mod/Part/General/ShapeContainer is set.
+ *
+ * A compound whose children don't share any sub-shapes is split into one chunk
+ * per child, any other shape makes a single chunk. The table of contents in
+ * front of the data gives the bounding box of each chunk and, if the shape was
+ * meshed when it was written, the size of its tessellation. The boxes and the
+ * tessellation are available without decoding the BRep data. The tessellation
+ * is used by PropertyPartShape::getFaces(), it lacks the normals and edges the
+ * view providers need. The chunks are decoded in parallel on the first call of
+ * getShape(). If a chunk can't be decoded the data is kept, so that write()
+ * still writes the original container.
+ *
+ * Decoding changes the held data, so all accessors to it are guarded by a
+ * mutex and a container may be shared by shapes used in different threads.
+ *
+ * All numbers are written in little endian byte order:
+ *  \code
+ *  header:   magic "FCSC", version, orientation and transformation of the shape,
+ *            flags, number of chunks, content hash
+ *  contents: per chunk the bounding box, size of the BRep data, number of
+ *            points and triangles and the deflection of the tessellation
+ *  data:     per chunk the BRep data in the BinTools format followed by the
+ *            points and triangles of the tessellation
+ *  \endcode
+ */
+class PartExport ShapeContainer
+{
+public:
+    struct Chunk {
+        Base::BoundBox3d box;
+        uint32_t brepSize;
+        uint32_t numPoints;
+        uint32_t numFacets;
+        float deflection;
+        /// the position of the BRep data in the data block
+        std::size_t offset;
+    };
+
+    ShapeContainer();
+    ~ShapeContainer();
+
+    /** Writes the shape in the chunked format.
+     * If \a hash is given it is set to the content hash of the shape.
+     */
+    static void write(std::ostream&, const TopoDS_Shape&, uint64_t* hash = 0);
+    /// writes the held shape again but with the given transformation
+    void write(std::ostream&, const Base::Matrix4D&) const;
+    /** Reads the table of contents and keeps the data for decoding it later.
+     * Returns false if the stream doesn't hold a valid container.
+     */
+    bool read(std::istream&);
+
+    /** Computes the hash of the BRep data that is written for the shape.
+     * Neither the location nor the triangulation of the shape is part of it.
+     */
+    static uint64_t getContentHash(const TopoDS_Shape&);
+
+    /// the hash of the shape when it was written, 0 for files of the first version
+    uint64_t getContentHash() const {
+        return hash;
+    }
+    /// the transformation of the shape when it was written
+    const Base::Matrix4D& getTransform() const {
+        return transform;
+    }
+    const std::vector<Chunk>& getChunks() const {
+        return chunks;
+    }
+    /// the bounding box of all chunks without the transformation of the shape
+    Base::BoundBox3d getBoundBox() const;
+    /** Gets the stored tessellation without the transformation of the shape.
+     * Returns false if a chunk has none or if it is coarser than \a accuracy.
+     */
+    bool getTessellation(float accuracy, std::vector<Base::Vector3d>& points,
+                         std::vector<Data::ComplexGeoData::Facet>& facets) const;
+
+    /// checks whether the BRep data has been decoded
+    bool isDecoded() const;
+    /// checks whether decoding the BRep data failed, the shape is incomplete then
+    bool hasFailed() const;
+    /** Decodes the shape without its transformation. The result is kept, so
+     * all callers get a shape with the same sub-shapes.
+     */
+    TopoDS_Shape getShape() const;
+    /// the size of the data that is kept in memory
+    unsigned int getMemSize() const;
+
+private:
+    ShapeContainer(const ShapeContainer&);
+    ShapeContainer& operator=(const ShapeContainer&);
+
+    int32_t orientation;
+    uint32_t flags;
+    uint64_t hash;
+    Base::Matrix4D transform;
+    std::vector<Chunk> chunks;
+    mutable std::string data;
+    mutable TopoDS_Shape shape;
+    mutable bool decoded;
+    mutable bool failed;
+    mutable QMutex mutex;
+};
+
+} //namespace Part
+
+#endif // PART_SHAPECONTAINER_H
@@ -162,9 +162,12 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/Profiler.h>
+#include <App/Application.h>
 
 
 #include "TopoShape.h"
+#include "BooleanBuilder.h"
 #include "CrossSection.h"
 #include "TopoShapeFacePy.h"
 #include "TopoShapeEdgePy.h"
@@ -571,6 +574,7 @@ for (ex.Init(this->_Shape, TopAbs_FACE); ex.More(); ex.Next())
 */
 void TopoShape::importIges(const char *FileName)
 {
+    FC_PROFILE_SCOPE("occ", "IGESControl_Reader");
     try {
         // read iges file
         IGESControl_Controller::Init();
@@ -601,6 +605,7 @@ void TopoShape::importIges(const char *FileName)
 
 void TopoShape::importStep(const char *FileName)
 {
+    FC_PROFILE_SCOPE("occ", "STEPControl_Reader");
     try {
         STEPControl_Reader aReader;
         if (aReader.ReadFile(encodeFilename(FileName).c_str()) != IFSelect_RetDone)
@@ -625,6 +630,7 @@ void TopoShape::importStep(const char *FileName)
 
 void TopoShape::importBrep(const char *FileName)
 {
+    FC_PROFILE_SCOPE("occ", "BRepTools::Read");
     try {
         // read brep-file
         BRep_Builder aBuilder;
@@ -648,6 +654,7 @@ void TopoShape::importBrep(const char *FileName)
 
 void TopoShape::importBrep(std::istream& str)
 {
+    FC_PROFILE_SCOPE("occ", "BRepTools::Read");
     try {
         // read brep-file
         BRep_Builder aBuilder;
@@ -674,12 +681,12 @@ void TopoShape::importBrep(std::istream& str)
 
 void TopoShape::importBinary(std::istream& str)
 {
-    BinTools_ShapeSet set;
-    set.Read(str);
-    Standard_Integer index;
-    BinTools::GetInteger(str, index);
-
+    FC_PROFILE_SCOPE("occ", "BinTools_ShapeSet::Read");
     try {
+        BinTools_ShapeSet set;
+        set.Read(str);
+        Standard_Integer index;
+        BinTools::GetInteger(str, index);
         this->_Shape = set.Shape(index);
     }
     catch (Standard_Failure) {
@@ -713,6 +720,7 @@ void TopoShape::write(const char *FileName) const
 
 void TopoShape::exportIges(const char *filename) const
 {
+    FC_PROFILE_SCOPE("occ", "IGESControl_Writer");
     try {
         // write iges file
         IGESControl_Controller::Init();
@@ -735,6 +743,7 @@ void TopoShape::exportIges(const char *filename) const
 
 void TopoShape::exportStep(const char *filename) const
 {
+    FC_PROFILE_SCOPE("occ", "STEPControl_Writer");
     try {
         // write step file
         STEPControl_Writer aWriter;
@@ -766,17 +775,20 @@ void TopoShape::exportStep(const char *filename) const
 
 void TopoShape::exportBrep(const char *filename) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepTools::Write");
     if (!BRepTools::Write(this->_Shape,encodeFilename(filename).c_str()))
         throw Base::Exception("Writing of BREP failed");
 }
 
 void TopoShape::exportBrep(std::ostream& out) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepTools::Write");
     BRepTools::Write(this->_Shape, out);
 }
 
-void TopoShape::exportBinary(std::ostream& out)
+void TopoShape::exportBinary(std::ostream& out) const
 {
+    FC_PROFILE_SCOPE("occ", "BinTools_ShapeSet::Write");
     BinTools_ShapeSet set;
     Standard_Integer index = set.Add(this->_Shape);
     set.Write(out);
@@ -1330,6 +1342,7 @@ bool TopoShape::isClosed() const
 
 TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepAlgoAPI_Cut");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
@@ -1340,6 +1353,7 @@ TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepAlgoAPI_Common");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
@@ -1350,6 +1364,7 @@ TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepAlgoAPI_Fuse");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
@@ -1360,51 +1375,32 @@ TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::multiFuse(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
 {
+    FC_PROFILE_SCOPE("occ", "TopoShape::multiFuse");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
-#if OCC_VERSION_HEX <= 0x060800
-    if (tolerance > 0.0)
-        Standard_Failure::Raise("Fuzzy Booleans are not supported in this version of OCCT");
-    TopoDS_Shape resShape = this->_Shape;
-    if (resShape.IsNull())
-        throw Base::Exception("Object shape is null");
-    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
-        if (it->IsNull())
-            throw Base::Exception("Input shape is null");
-        // Let's call algorithm computing a fuse operation:
-        BRepAlgoAPI_Fuse mkFuse(resShape, *it);
-        // Let's check if the fusion has been successful
-        if (!mkFuse.IsDone())
-            throw Base::Exception("Fusion failed");
-        resShape = mkFuse.Shape();
-    }
-#else
-    BRepAlgoAPI_Fuse mkFuse;
-    TopTools_ListOfShape shapeArguments,shapeTools;
-    shapeArguments.Append(this->_Shape);
+    std::vector<TopoDS_Shape> arguments;
+    arguments.reserve(shapes.size() + 1);
+    arguments.push_back(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw Base::Exception("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
-    }
-    mkFuse.SetArguments(shapeArguments);
-    mkFuse.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkFuse.SetFuzzyValue(tolerance);
+        arguments.push_back(*it);
+    }
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/Boolean");
+    MultiFuseBuilder mkFuse(arguments);
+    mkFuse.setTolerance(tolerance);
+    mkFuse.setRunParallel(hGrp->GetBool("RunParallel", true));
     mkFuse.Build();
     if (!mkFuse.IsDone())
         throw Base::Exception("MultiFusion failed");
     TopoDS_Shape resShape = mkFuse.Shape();
-#endif
     return resShape;
 }
 
 TopoDS_Shape TopoShape::oldFuse(TopoDS_Shape shape) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepAlgo_Fuse");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
@@ -1415,6 +1411,7 @@ TopoDS_Shape TopoShape::oldFuse(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::section(TopoDS_Shape shape) const
 {
+    FC_PROFILE_SCOPE("occ", "BRepAlgoAPI_Section");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
     if (shape.IsNull())
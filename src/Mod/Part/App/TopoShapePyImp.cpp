@@ -269,7 +269,16 @@ PyObject*  TopoShapePy::read(PyObject *args)
     std::string EncodedName = std::string(Name);
     PyMem_Free(Name);
 
-    getTopoShapePtr()->read(EncodedName.c_str());
+    PY_TRY {
+        TopoShape shape;
+        {
+            Base::PyAllowThreads threads;
+            threads.write(this);
+            threads.release();
+            shape.read(EncodedName.c_str());
+        }
+        getTopoShapePtr()->_Shape = shape._Shape;
+    } PY_CATCH;
     Py_Return;
 }
 
@@ -305,7 +314,12 @@ PyObject*  TopoShapePy::exportIges(PyObject *args)
 
     try {
         // write iges file
-        getTopoShapePtr()->exportIges(EncodedName.c_str());
+        // the copy shares the shape data, so the Python object is guarded meanwhile
+        TopoShape shape(getTopoShapePtr()->_Shape);
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        shape.exportIges(EncodedName.c_str());
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -325,7 +339,12 @@ PyObject*  TopoShapePy::exportStep(PyObject *args)
 
     try {
         // write step file
-        getTopoShapePtr()->exportStep(EncodedName.c_str());
+        // the copy shares the shape data, so the Python object is guarded meanwhile
+        TopoShape shape(getTopoShapePtr()->_Shape);
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        shape.exportStep(EncodedName.c_str());
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -345,7 +364,12 @@ PyObject*  TopoShapePy::exportBrep(PyObject *args)
 
     try {
         // write brep file
-        getTopoShapePtr()->exportBrep(EncodedName.c_str());
+        // the copy shares the shape data, so the Python object is guarded meanwhile
+        TopoShape shape(getTopoShapePtr()->_Shape);
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        shape.exportBrep(EncodedName.c_str());
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -674,7 +698,16 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
     TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->_Shape;
     try {
         // Let's call algorithm computing a fuse operation:
-        TopoDS_Shape fusShape = this->getTopoShapePtr()->fuse(shape);
+        // the copies share the shape data, so the Python objects are guarded meanwhile
+        TopoShape self(this->getTopoShapePtr()->_Shape);
+        TopoDS_Shape fusShape;
+        {
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(static_cast<TopoShapePy*>(pcObj));
+            threads.release();
+            fusShape = self.fuse(shape);
+        }
         return new TopoShapePy(new TopoShape(fusShape));
     }
     catch (Standard_Failure) {
@@ -753,7 +786,16 @@ PyObject*  TopoShapePy::common(PyObject *args)
     TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->_Shape;
     try {
         // Let's call algorithm computing a common operation:
-        TopoDS_Shape comShape = this->getTopoShapePtr()->common(shape);
+        // the copies share the shape data, so the Python objects are guarded meanwhile
+        TopoShape self(this->getTopoShapePtr()->_Shape);
+        TopoDS_Shape comShape;
+        {
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(static_cast<TopoShapePy*>(pcObj));
+            threads.release();
+            comShape = self.common(shape);
+        }
         return new TopoShapePy(new TopoShape(comShape));
     }
     catch (Standard_Failure) {
@@ -776,7 +818,16 @@ PyObject*  TopoShapePy::section(PyObject *args)
     TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->_Shape;
     try {
         // Let's call algorithm computing a section operation:
-        TopoDS_Shape secShape = this->getTopoShapePtr()->section(shape);
+        // the copies share the shape data, so the Python objects are guarded meanwhile
+        TopoShape self(this->getTopoShapePtr()->_Shape);
+        TopoDS_Shape secShape;
+        {
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(static_cast<TopoShapePy*>(pcObj));
+            threads.release();
+            secShape = self.section(shape);
+        }
         return new TopoShapePy(new TopoShape(secShape));
     }
     catch (Standard_Failure) {
@@ -854,7 +905,16 @@ PyObject*  TopoShapePy::cut(PyObject *args)
     TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->_Shape;
     try {
         // Let's call algorithm computing a cut operation:
-        TopoDS_Shape cutShape = this->getTopoShapePtr()->cut(shape);
+        // the copies share the shape data, so the Python objects are guarded meanwhile
+        TopoShape self(this->getTopoShapePtr()->_Shape);
+        TopoDS_Shape cutShape;
+        {
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.read(static_cast<TopoShapePy*>(pcObj));
+            threads.release();
+            cutShape = self.cut(shape);
+        }
         return new TopoShapePy(new TopoShape(cutShape));
     }
     catch (Standard_Failure) {
@@ -1135,7 +1195,14 @@ PyObject* TopoShapePy::makeFillet(PyObject *args)
                     }
                 }
             }
-            return new TopoShapePy(new TopoShape(mkFillet.Shape()));
+            TopoDS_Shape fillet;
+            {
+                Base::PyAllowThreads threads;
+                threads.read(this);
+                threads.release();
+                fillet = mkFillet.Shape();
+            }
+            return new TopoShapePy(new TopoShape(fillet));
         }
         catch (Standard_Failure) {
             Handle_Standard_Failure e = Standard_Failure::Caught();
@@ -1161,7 +1228,14 @@ PyObject* TopoShapePy::makeFillet(PyObject *args)
                     }
                 }
             }
-            return new TopoShapePy(new TopoShape(mkFillet.Shape()));
+            TopoDS_Shape fillet;
+            {
+                Base::PyAllowThreads threads;
+                threads.read(this);
+                threads.release();
+                fillet = mkFillet.Shape();
+            }
+            return new TopoShapePy(new TopoShape(fillet));
         }
         catch (Standard_Failure) {
             Handle_Standard_Failure e = Standard_Failure::Caught();
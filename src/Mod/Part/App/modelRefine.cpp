@@ -34,6 +34,7 @@
 #include <Geom_BSplineSurface.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Cylinder.hxx>
+#include <gp_Lin.hxx>
 #include <TColgp_Array2OfPnt.hxx>
 #include <TColStd_Array1OfReal.hxx>
 #include <TopoDS_Shape.hxx>
@@ -54,6 +55,8 @@
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 #include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
 #include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <BRep_Builder.hxx>
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
@@ -62,11 +65,16 @@
 #include <BRepAdaptor_Curve.hxx>
 #include <TColgp_SequenceOfPnt.hxx>
 #include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <QtConcurrentMap>
 #include <Base/Console.h>
 #include "modelRefine.h"
 
 using namespace ModelRefine;
 
+// The shells of a shape may be refined in parallel. These are initialized before
+// any thread runs, a function-local static wouldn't be initialized thread-safe.
+static const FaceVectorType emptyFaceVector;
+static const TopoDS_Face nullFace;
 
 
 void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
@@ -169,8 +177,7 @@ const FaceVectorType& FaceTypeSplitter::getTypedFaceVector(const GeomAbs_Surface
     if (this->hasType(type))
         return (*(typeMap.find(type))).second;
     //error here.
-    static FaceVectorType error;
-    return error;
+    return emptyFaceVector;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -249,28 +256,65 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
+    // Equal faces have close keys. So a face is only compared with the groups whose
+    // first face has a close key instead of with all groups.
+    std::vector<double> keys(faces.size());
+    std::vector<bool> hasKey(faces.size());
+    double maxSize(0.0);
+    for (std::size_t index(0); index < faces.size(); ++index)
+    {
+        double size(0.0);
+        hasKey[index] = object->getKey(faces[index], keys[index], size);
+        if (hasKey[index])
+            maxSize = std::max(maxSize, size);
+    }
+    double tolerance = FaceTypedBase::getKeyTolerance(maxSize);
+
     std::vector<FaceVectorType> tempVector;
     tempVector.reserve(faces.size());
-    FaceVectorType::const_iterator faceIt;
-    for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    std::multimap<double, std::size_t> keyedGroups;
+    std::vector<std::size_t> otherGroups;
+    for (std::size_t index(0); index < faces.size(); ++index)
     {
-        bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        const TopoDS_Face &face = faces[index];
+        // as before the face goes to the first group it is equal to
+        std::size_t match(tempVector.size());
+        if (hasKey[index])
+        {
+            std::multimap<double, std::size_t>::const_iterator it;
+            std::multimap<double, std::size_t>::const_iterator end = keyedGroups.upper_bound(keys[index] + tolerance);
+            for (it = keyedGroups.lower_bound(keys[index] - tolerance); it != end; ++it)
+            {
+                if (it->second < match && object->isEqual(tempVector[it->second].front(), face))
+                    match = it->second;
+            }
+        }
+        else
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            std::vector<std::size_t>::const_iterator it;
+            for (it = otherGroups.begin(); it != otherGroups.end(); ++it)
             {
-                (*tempIt).push_back(*faceIt);
-                foundMatch = true;
-                break;
+                if (object->isEqual(tempVector[*it].front(), face))
+                {
+                    match = *it;
+                    break;
+                }
             }
         }
-        if (!foundMatch)
+
+        if (match < tempVector.size())
+        {
+            tempVector[match].push_back(face);
+        }
+        else
         {
             FaceVectorType another;
-            another.reserve(faces.size());
-            another.push_back(*faceIt);
+            another.push_back(face);
             tempVector.push_back(another);
+            if (hasKey[index])
+                keyedGroups.insert(std::make_pair(keys[index], match));
+            else
+                otherGroups.push_back(match);
         }
     }
     std::vector<FaceVectorType>::iterator it;
@@ -284,6 +328,21 @@ void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *obj
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// the point the keys are measured to, chosen to be unlikely the centre of a symmetric pattern
+static const gp_Pnt keyReference(0.5772156649, 0.3678794412, 0.1411200081);
+
+bool FaceTypedBase::getKey(const TopoDS_Face &, double &, double &) const
+{
+    return false;
+}
+
+double FaceTypedBase::getKeyTolerance(double size)
+{
+    // the linear tolerance and the angular tolerance over the distance from the reference point,
+    // doubled to be on the safe side
+    return 2.0 * Precision::Confusion() * (1.0 + size);
+}
+
 GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
 {
     Handle(Geom_Surface) surface = BRep_Tool::Surface(faceIn);
@@ -375,6 +434,17 @@ bool FaceTypedPlane::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &face
             planeOne.Distance(planeTwo.Position().Location()) < Precision::Confusion());
 }
 
+bool FaceTypedPlane::getKey(const TopoDS_Face &face, double &key, double &size) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+    gp_Pln plane(planeSurface->Pln());
+    key = plane.Distance(keyReference);
+    size = plane.Location().Distance(keyReference);
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedPlane::getType() const
 {
     return GeomAbs_Plane;
@@ -454,6 +524,17 @@ bool FaceTypedCylinder::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &f
     return true;
 }
 
+bool FaceTypedCylinder::getKey(const TopoDS_Face &face, double &key, double &size) const
+{
+    Handle(Geom_CylindricalSurface) surface = Handle(Geom_CylindricalSurface)::DownCast(BRep_Tool::Surface(face));
+    if (surface.IsNull())
+        return false;
+    gp_Cylinder cylinder = surface->Cylinder();
+    key = gp_Lin(cylinder.Axis()).Distance(keyReference);
+    size = cylinder.Location().Distance(keyReference);
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 {
     return GeomAbs_Cylinder;
@@ -461,21 +542,20 @@ GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 
 // Auxiliary method
 const TopoDS_Face fixFace(const TopoDS_Face& f) {
-    static TopoDS_Face dummy;
     // Fix the face. Orientation doesn't seem to get fixed the first call.
     ShapeFix_Face faceFixer(f);
     faceFixer.SetContext(new ShapeBuild_ReShape());
     faceFixer.Perform();
     if (faceFixer.Status(ShapeExtend_FAIL))
-        return dummy;
+        return nullFace;
     faceFixer.FixMissingSeam();
     faceFixer.Perform();
     if (faceFixer.Status(ShapeExtend_FAIL))
-      return dummy;
+      return nullFace;
     faceFixer.FixOrientation();
     faceFixer.Perform();
     if (faceFixer.Status(ShapeExtend_FAIL))
-        return dummy;
+        return nullFace;
     return faceFixer.Face();
 }
 
@@ -596,11 +676,10 @@ bool wireEncirclesAxis(const TopoDS_Wire& wire, const Handle(Geom_CylindricalSur
 
 TopoDS_Face FaceTypedCylinder::buildFace(const FaceVectorType &faces) const
 {    
-    static TopoDS_Face dummy;
     std::vector<EdgeVectorType> boundaries;
     boundarySplit(faces, boundaries);
     if (boundaries.size() < 1)
-        return dummy;
+        return nullFace;
 
     //make wires
     std::vector<TopoDS_Wire> allWires;
@@ -612,11 +691,11 @@ TopoDS_Face FaceTypedCylinder::buildFace(const FaceVectorType &faces) const
         for (it = (*boundaryIt).begin(); it != (*boundaryIt).end(); ++it)
             wireMaker.Add(*it);
         if (wireMaker.Error() != BRepLib_WireDone)
-            return dummy;
+            return nullFace;
         allWires.push_back(wireMaker.Wire());
     }
     if (allWires.size() < 1)
-        return dummy;
+        return nullFace;
 
     // Sort wires by size, that is, the innermost wire comes last
     std::sort(allWires.begin(), allWires.end(), ModelRefine::WireSort());
@@ -638,29 +717,29 @@ TopoDS_Face FaceTypedCylinder::buildFace(const FaceVectorType &faces) const
         wireIt = allWires.begin();
         BRepBuilderAPI_MakeFace faceMaker(surface, *wireIt);
         if (!faceMaker.IsDone())
-            return dummy;
+            return nullFace;
 
         // Add additional boundaries (inner wires).
         for (wireIt++; wireIt != allWires.end(); ++wireIt)
         {
             faceMaker.Add(*wireIt);
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
         }
 
         return fixFace(faceMaker.Face());
     } else {
         if (encirclingWires.size() != 2)
-            return dummy;
+            return nullFace;
 
         if (innerWires.empty()) {
             // We have just two outer boundaries
             BRepBuilderAPI_MakeFace faceMaker(surface, encirclingWires.front());
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
             faceMaker.Add(encirclingWires.back());
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
 
             return fixFace(faceMaker.Face());
         } else {
@@ -668,23 +747,23 @@ TopoDS_Face FaceTypedCylinder::buildFace(const FaceVectorType &faces) const
             wireIt = innerWires.begin();
             BRepBuilderAPI_MakeFace faceMaker(surface, *wireIt, false);
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
 
             // Add additional boundaries (inner wires).
             for (wireIt++; wireIt != innerWires.end(); ++wireIt)
             {
                 faceMaker.Add(*wireIt);
                 if (!faceMaker.IsDone())
-                    return dummy;
+                    return nullFace;
             }
 
             // Add outer boundaries
             faceMaker.Add(encirclingWires.front());
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
             faceMaker.Add(encirclingWires.back());
             if (!faceMaker.IsDone())
-                return dummy;
+                return nullFace;
 
             return fixFace(faceMaker.Face());
         }
@@ -890,6 +969,17 @@ bool FaceTypedBSpline::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &fa
   return false;
 }
 
+bool FaceTypedBSpline::getKey(const TopoDS_Face &face, double &key, double &size) const
+{
+    Handle(Geom_BSplineSurface) surface = Handle(Geom_BSplineSurface)::DownCast(BRep_Tool::Surface(face));
+    if (surface.IsNull())
+        return false;
+    // equal surfaces have equal poles
+    key = surface->Pole(1, 1).Distance(keyReference);
+    size = 0.0;
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedBSpline::getType() const
 {
     return GeomAbs_BSplineSurface;
@@ -1133,6 +1223,71 @@ Part::BRepBuilderAPI_RefineModel::BRepBuilderAPI_RefineModel(const TopoDS_Shape&
     Build();
 }
 
+static bool processUniter(ModelRefine::FaceUniter* uniter)
+{
+    try {
+        return uniter->process();
+    }
+    catch (Standard_Failure) {
+        return false;
+    }
+}
+
+// Marks the shells that share a face, edge or vertex with another shell
+static std::vector<bool> findSharingShells(const std::vector<TopoDS_Shell>& shells)
+{
+    std::vector<bool> sharing(shells.size(), false);
+    TopTools_DataMapOfShapeInteger owners;
+    for (std::size_t index = 0; index < shells.size(); ++index) {
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(shells[index], map);
+        for (int i = 1; i <= map.Extent(); i++) {
+            // compare the shared data only, not the location
+            TopoDS_Shape shape = map(i).Located(TopLoc_Location());
+            if (shape.ShapeType() == TopAbs_SHELL)
+                continue;
+            if (!owners.IsBound(shape)) {
+                owners.Bind(shape, (Standard_Integer)index);
+            }
+            else if (owners(shape) != (Standard_Integer)index) {
+                sharing[index] = true;
+                sharing[owners(shape)] = true;
+            }
+        }
+    }
+    return sharing;
+}
+
+// The uniter of a shell modifies the edges and vertices of the shell. Only the
+// shells that don't share any of them with another shell are processed in
+// parallel, the others are processed one after the other.
+static std::vector<bool> processUniters(std::vector<ModelRefine::FaceUniter>& uniters,
+                                        const std::vector<TopoDS_Shell>& shells)
+{
+    std::vector<bool> sharing = findSharingShells(shells);
+    std::vector<ModelRefine::FaceUniter*> independent;
+    for (std::size_t index = 0; index < uniters.size(); ++index) {
+        if (!sharing[index])
+            independent.push_back(&uniters[index]);
+    }
+
+    std::vector<bool> results(uniters.size(), false);
+    if (independent.size() > 1) {
+        // create the shared face type objects before the threads use them
+        ModelRefine::getPlaneObject();
+        ModelRefine::getCylinderObject();
+        ModelRefine::getBSplineObject();
+        QList<bool> list = QtConcurrent::blockingMapped< QList<bool> >(independent, processUniter);
+        for (int i = 0; i < list.size(); ++i)
+            results[independent[i] - &uniters.front()] = list[i];
+    }
+    for (std::size_t index = 0; index < uniters.size(); ++index) {
+        if (sharing[index] || independent.size() <= 1)
+            results[index] = processUniter(&uniters[index]);
+    }
+    return results;
+}
+
 void Part::BRepBuilderAPI_RefineModel::Build()
 {
     if (myShape.IsNull())
@@ -1141,18 +1296,24 @@ void Part::BRepBuilderAPI_RefineModel::Build()
     if (myShape.ShapeType() == TopAbs_SOLID) {
         const TopoDS_Solid &solid = TopoDS::Solid(myShape);
         BRepBuilderAPI_MakeSolid mkSolid;
+        std::vector<ModelRefine::FaceUniter> uniters;
+        std::vector<TopoDS_Shell> shells;
         TopExp_Explorer it;
         for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
-            const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-            ModelRefine::FaceUniter uniter(currentShell);
-            if (uniter.process()) {
+            shells.push_back(TopoDS::Shell(it.Current()));
+            uniters.push_back(ModelRefine::FaceUniter(shells.back()));
+        }
+        std::vector<bool> processed = processUniters(uniters, shells);
+        for (std::size_t index = 0; index < uniters.size(); ++index) {
+            ModelRefine::FaceUniter &uniter = uniters[index];
+            if (processed[index]) {
                 if (uniter.isModified()) {
                     const TopoDS_Shell &newShell = uniter.getShell();
                     mkSolid.Add(newShell);
                     LogModifications(uniter);
                 }
                 else {
-                    mkSolid.Add(currentShell);
+                    mkSolid.Add(uniter.getShell());
                 }
             }
             else {
@@ -1178,19 +1339,35 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         TopoDS_Compound comp;
         builder.MakeCompound(comp);
 
+        // process the shells of the solids and the free shells all at once
+        std::vector<ModelRefine::FaceUniter> uniters;
+        std::vector<TopoDS_Shell> shells;
         TopExp_Explorer xp;
+        for (xp.Init(myShape, TopAbs_SOLID); xp.More(); xp.Next()) {
+            TopExp_Explorer it;
+            for (it.Init(xp.Current(), TopAbs_SHELL); it.More(); it.Next()) {
+                shells.push_back(TopoDS::Shell(it.Current()));
+                uniters.push_back(ModelRefine::FaceUniter(shells.back()));
+            }
+        }
+        for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+            shells.push_back(TopoDS::Shell(xp.Current()));
+            uniters.push_back(ModelRefine::FaceUniter(shells.back()));
+        }
+        std::vector<bool> processed = processUniters(uniters, shells);
+
         // solids
+        std::size_t index = 0;
         for (xp.Init(myShape, TopAbs_SOLID); xp.More(); xp.Next()) {
             const TopoDS_Solid &solid = TopoDS::Solid(xp.Current());
             BRepTools_ReShape reshape;
             TopExp_Explorer it;
-            for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next()) {
-                const TopoDS_Shell &currentShell = TopoDS::Shell(it.Current());
-                ModelRefine::FaceUniter uniter(currentShell);
-                if (uniter.process()) {
+            for (it.Init(solid, TopAbs_SHELL); it.More(); it.Next(), ++index) {
+                ModelRefine::FaceUniter &uniter = uniters[index];
+                if (processed[index]) {
                     if (uniter.isModified()) {
                         const TopoDS_Shell &newShell = uniter.getShell();
-                        reshape.Replace(currentShell, newShell);
+                        reshape.Replace(shells[index], newShell);
                         LogModifications(uniter);
                     }
                 }
@@ -1198,10 +1375,9 @@ void Part::BRepBuilderAPI_RefineModel::Build()
             builder.Add(comp, reshape.Apply(solid));
         }
         // free shells
-        for (xp.Init(myShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
-            const TopoDS_Shell& shell = TopoDS::Shell(xp.Current());
-            ModelRefine::FaceUniter uniter(shell);
-            if (uniter.process()) {
+        for (; index < uniters.size(); ++index) {
+            ModelRefine::FaceUniter &uniter = uniters[index];
+            if (processed[index]) {
                 builder.Add(comp, uniter.getShell());
                 LogModifications(uniter);
             }
@@ -60,6 +60,13 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        /** A value that differs by at most getKeyTolerance(size) for faces which are
+         * equal, used to find the candidates for isEqual(). \a size is the distance of
+         * the surface from the point the key is measured to. Returns false if the face
+         * has no key, then it is compared with all other faces without a key.
+         */
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &size) const;
+        static double getKeyTolerance(double size);
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
@@ -76,6 +83,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &size) const;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -88,6 +96,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &size) const;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
@@ -103,6 +112,7 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const;
         virtual GeomAbs_SurfaceType getType() const;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const;
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &size) const;
         friend FaceTypedBSpline& getBSplineObject();
     };
     FaceTypedBSpline& getBSplineObject();
@@ -28,6 +28,7 @@
 #include "SoBrepEdgeSet.h"
 #include "SoBrepPointSet.h"
 #include "SoFCShapeObject.h"
+#include "PropertyTessellationCache.h"
 #include "ViewProvider.h"
 #include "ViewProviderExt.h"
 #include "ViewProviderPython.h"
@@ -105,6 +106,7 @@ void PartGuiExport initPartGui()
     PartGui::SoBrepEdgeSet                  ::initClass();
     PartGui::SoBrepPointSet                 ::initClass();
     PartGui::SoFCControlPoints              ::initClass();
+    PartGui::PropertyTessellationCache      ::init();
     PartGui::ViewProviderPartExt            ::init();
     PartGui::ViewProviderPart               ::init();
     PartGui::ViewProviderEllipsoid          ::init();
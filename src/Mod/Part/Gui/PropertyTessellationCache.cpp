@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <iterator>
+#endif
+
+#include <CXX/Objects.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
+#include <App/Application.h>
+
+#include "PropertyTessellationCache.h"
+#include "ViewProviderExt.h"
+
+using namespace PartGui;
+
+TYPESYSTEM_SOURCE(PartGui::PropertyTessellationCache , App::Property);
+
+PropertyTessellationCache::PropertyTessellationCache()
+{
+}
+
+PropertyTessellationCache::~PropertyTessellationCache()
+{
+}
+
+void PropertyTessellationCache::setValue(const std::string& data)
+{
+    aboutToSetValue();
+    _Data = data;
+    hasSetValue();
+}
+
+void PropertyTessellationCache::clear()
+{
+    std::string().swap(_Data);
+}
+
+PyObject *PropertyTessellationCache::getPyObject(void)
+{
+    return Py::new_reference_to(Py::None());
+}
+
+void PropertyTessellationCache::setPyObject(PyObject *value)
+{
+}
+
+void PropertyTessellationCache::Save (Base::Writer &writer) const
+{
+    // The triangulation is optional because it makes the project file much bigger
+    std::string file;
+    if (!writer.isForceXML() && App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("SaveTessellation", false)) {
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(ViewProviderPartExt::getClassTypeId())
+            && static_cast<ViewProviderPartExt*>(father)->hasTessellation())
+            file = writer.addFile("Tessellation.bin", this);
+    }
+
+    writer.Stream() << writer.ind() << "<Tessellation file=\"" << file << "\"/>" << std::endl;
+}
+
+void PropertyTessellationCache::Restore(Base::XMLReader &reader)
+{
+    reader.readElement("Tessellation");
+    std::string file (reader.getAttribute("file") );
+    clear();
+
+    if (!file.empty()) {
+        // initate a file read
+        reader.addFile(file.c_str(),this);
+    }
+}
+
+void PropertyTessellationCache::SaveDocFile (Base::Writer &writer) const
+{
+    App::PropertyContainer* father = this->getContainer();
+    if (father && father->isDerivedFrom(ViewProviderPartExt::getClassTypeId()))
+        static_cast<ViewProviderPartExt*>(father)->saveTessellation(writer.Stream());
+}
+
+void PropertyTessellationCache::RestoreDocFile(Base::Reader &reader)
+{
+    // the data is only checked when the view provider uses it
+    _Data.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+}
+
+App::Property *PropertyTessellationCache::Copy(void) const
+{
+    PropertyTessellationCache *prop = new PropertyTessellationCache();
+    prop->_Data = this->_Data;
+    return prop;
+}
+
+void PropertyTessellationCache::Paste(const App::Property &from)
+{
+    aboutToSetValue();
+    _Data = dynamic_cast<const PropertyTessellationCache&>(from)._Data;
+    hasSetValue();
+}
+
+unsigned int PropertyTessellationCache::getMemSize (void) const
+{
+    return (unsigned int)_Data.size();
+}
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (c) 2015 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef PARTGUI_PROPERTYTESSELLATIONCACHE_H
+#define PARTGUI_PROPERTYTESSELLATIONCACHE_H
+
+#include <string>
+#include <App/Property.h>
+
+namespace PartGui
+{
+
+/** The tessellation cache saves the triangulation shown by a
+ * ViewProviderPartExt with the project if the parameter SaveTessellation is
+ * set. After restoring, the data is kept until the view provider builds its
+ * visual for the first time. It is used instead of meshing the shape again if
+ * it was made for the same shape and deflection.
+ */
+class PartGuiExport PropertyTessellationCache : public App::Property
+{
+    TYPESYSTEM_HEADER();
+
+public:
+    PropertyTessellationCache();
+    ~PropertyTessellationCache();
+
+    /// set the data of the cache
+    void setValue(const std::string&);
+    /// the restored data, empty if there is none
+    const std::string& getValue(void) const {
+        return _Data;
+    }
+    /// releases the data without touching the property
+    void clear();
+
+    PyObject *getPyObject(void);
+    void setPyObject(PyObject *value);
+
+    void Save (Base::Writer &writer) const;
+    void Restore(Base::XMLReader &reader);
+
+    void SaveDocFile (Base::Writer &writer) const;
+    void RestoreDocFile(Base::Reader &reader);
+
+    App::Property *Copy(void) const;
+    void Paste(const App::Property &from);
+    unsigned int getMemSize (void) const;
+
+private:
+    std::string _Data;
+};
+
+} //namespace PartGui
+
+#endif // PARTGUI_PROPERTYTESSELLATIONCACHE_H
@@ -24,7 +24,12 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <set>
 # include <sstream>
+# include <vector>
+# include <boost/bind.hpp>
 # include <Bnd_Box.hxx>
 # include <Poly_Polygon3D.hxx>
 # include <BRepBndLib.hxx>
@@ -61,6 +66,7 @@
 # include <TopExp_Explorer.hxx>
 # include <TopExp.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
 # include <Poly_PolygonOnTriangulation.hxx>
 # include <TColStd_Array1OfInteger.hxx>
 # include <TColgp_Array1OfDir.hxx>
@@ -95,12 +101,14 @@
 # include <Inventor/nodes/SoLightModel.h>
 # include <QAction>
 # include <QMenu>
+# include <QtConcurrentMap>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Console.h>
 #include <Base/Parameter.h>
 #include <Base/Exception.h>
+#include <Base/Stream.h>
 #include <Base/TimeInfo.h>
 
 #include <App/Application.h>
@@ -120,6 +128,7 @@
 
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/PrimitiveFeature.h>
+#include <Mod/Part/App/PropertyTopoShape.h>
 
 
 using namespace PartGui;
@@ -131,7 +140,6 @@ void GetNormals(const TopoDS_Face&  theFace,
              const Handle(Poly_Triangulation)& aPolyTri,
              TColgp_Array1OfDir& theNormals)
 {
-    Poly_Connect thePolyConnect(aPolyTri);
     const TColgp_Array1OfPnt&         aNodes   = aPolyTri->Nodes();
 
     if(aPolyTri->HasNormals())
@@ -161,6 +169,7 @@ void GetNormals(const TopoDS_Face&  theFace,
     }
 
     // take in face the surface location
+    Poly_Connect thePolyConnect(aPolyTri);
     const TopoDS_Face      aZeroFace = TopoDS::Face(theFace.Located(TopLoc_Location()));
     Handle(Geom_Surface)   aSurf     = BRep_Tool::Surface(aZeroFace);
     const Standard_Real    aTol      = Precision::Confusion();
@@ -215,6 +224,164 @@ void GetNormals(const TopoDS_Face&  theFace,
     }
 }
 
+namespace PartGui {
+/// the triangulation of a face and where it goes in the arrays of the visual
+struct FaceTessellation {
+    TopoDS_Face face;
+    Handle(Poly_Triangulation) mesh;
+    TopLoc_Location loc;
+    int nodeOffset;
+    int triaOffset;
+    int part;
+    bool shared;
+};
+
+class FaceTessellationFiller
+{
+public:
+    FaceTessellationFiller(SbVec3f* verts, SbVec3f* norms, int32_t* index, int32_t* parts)
+      : verts(verts), norms(norms), index(index), parts(parts)
+    {
+    }
+    /// fills in the nodes, normals and triangles of a face whose mesh is (not) shared with an earlier face
+    void fill(const FaceTessellation& face, bool shared) const
+    {
+        if (face.shared != shared)
+            return;
+        if (face.mesh.IsNull()) {
+            parts[face.part] = 0;
+            return;
+        }
+
+        // getting the transformation of the shape/face
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!face.loc.IsIdentity()) {
+            identity = false;
+            myTransf = face.loc.Transformation();
+        }
+
+        // getting size of node and triangle array of this face
+        int nbNodesInFace = face.mesh->NbNodes();
+        int nbTriInFace   = face.mesh->NbTriangles();
+        // check orientation
+        TopAbs_Orientation orient = face.face.Orientation();
+
+        const Poly_Array1OfTriangle& Triangles = face.mesh->Triangles();
+        const TColgp_Array1OfPnt& Nodes = face.mesh->Nodes();
+        TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
+        // the normals have been computed before, so this only reads the triangulation
+        GetNormals(face.face, face.mesh, Normals);
+
+        // set all nodes, including those which are only referenced by the edge polygons
+        SbVec3f* faceVerts = verts + face.nodeOffset;
+        SbVec3f* faceNorms = norms + face.nodeOffset;
+        for (int i=1;i<=nbNodesInFace;i++) {
+            gp_Pnt V(Nodes(i));
+            gp_Dir NV(Normals(i));
+            // transform the vertices and normals to the place of the face
+            if (!identity) {
+                V.Transform(myTransf);
+                NV.Transform(myTransf);
+            }
+            faceVerts[i-1].setValue((float)(V.X()),(float)(V.Y()),(float)(V.Z()));
+            faceNorms[i-1].setValue((float)(NV.X()),(float)(NV.Y()),(float)(NV.Z()));
+        }
+
+        int32_t* faceIndex = index + 4 * face.triaOffset;
+        for (int g=1;g<=nbTriInFace;g++) {
+            // Get the triangle
+            Standard_Integer N1,N2,N3;
+            Triangles(g).Get(N1,N2,N3);
+
+            // change orientation of the triangle if the face is reversed
+            if ( orient != TopAbs_FORWARD ) {
+                Standard_Integer tmp = N1;
+                N1 = N2;
+                N2 = tmp;
+            }
+
+            // set the index vector with the 3 point indexes and the end delimiter
+            faceIndex[4*(g-1)]   = face.nodeOffset+N1-1;
+            faceIndex[4*(g-1)+1] = face.nodeOffset+N2-1;
+            faceIndex[4*(g-1)+2] = face.nodeOffset+N3-1;
+            faceIndex[4*(g-1)+3] = SO_END_FACE_INDEX;
+        }
+
+        parts[face.part] = nbTriInFace; // new part
+    }
+
+private:
+    SbVec3f* verts;
+    SbVec3f* norms;
+    int32_t* index;
+    int32_t* parts;
+};
+
+/// the deflection to mesh a shape, whose location is reset, with the given deviation
+static Standard_Real getDeflection(const TopoDS_Shape& shape, double deviation)
+{
+    Bnd_Box bounds;
+    BRepBndLib::Add(shape, bounds);
+    bounds.SetGap(0.0);
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * deviation;
+    // The triangulation stored on a face is reused as long as it is fine enough.
+    // Rounding the deflection down to a quarter of a power of two keeps it stable
+    // for small changes of the bounding box, so that the unchanged faces of a
+    // modified shape are not meshed again.
+    if (deflection > 0.0)
+        deflection = std::pow(2.0, std::floor(4.0 * std::log(deflection) / std::log(2.0)) / 4.0);
+    return deflection;
+}
+
+/// checks whether every face of the shape has a triangulation fine enough for the deflection
+static bool isMeshed(const TopoDS_Shape& shape, Standard_Real deflection)
+{
+    for (TopExp_Explorer Ex(shape,TopAbs_FACE);Ex.More();Ex.Next()) {
+        TopLoc_Location loc;
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(Ex.Current()), loc);
+        if (mesh.IsNull() || mesh->Deflection() > deflection)
+            return false;
+    }
+    return true;
+}
+
+/// a shape to mesh in advance of creating its visual
+struct ShapeTessellation {
+    TopoDS_Shape shape;
+    Standard_Real deflection;
+    Standard_Real angularDeflection;
+};
+
+static const uint32_t tessellationMagic = 0x53544346; // "FCTS"
+static const uint32_t tessellationVersion = 2;
+
+static const Part::PropertyPartShape* getShapeProperty(App::DocumentObject* obj)
+{
+    App::Property* prop = obj ? obj->getPropertyByName("Shape") : 0;
+    if (prop && prop->getTypeId().isDerivedFrom(Part::PropertyPartShape::getClassTypeId()))
+        return static_cast<Part::PropertyPartShape*>(prop);
+    return 0;
+}
+
+static void meshShape(const ShapeTessellation& task)
+{
+    try {
+#if OCC_VERSION_HEX >= 0x060600
+        BRepMesh_IncrementalMesh(task.shape,task.deflection,Standard_False,
+                task.angularDeflection,Standard_False);
+#else
+        BRepMesh_IncrementalMesh(task.shape,task.deflection);
+#endif
+    }
+    catch (Standard_Failure) {
+        // the view provider tries it again when it creates the visual
+    }
+}
+}
+
 //**************************************************************************
 // Construction/Destruction
 
@@ -227,6 +394,12 @@ const char* ViewProviderPartExt::DrawStyleEnums[]= {"Solid","Dashed","Dotted","D
 ViewProviderPartExt::ViewProviderPartExt() 
 {
     VisualTouched = true;
+    parallelTessellation = true;
+    restoring = false;
+    visualHash = 0;
+    visualDeviation = 0.0;
+    visualDeflection = 0.0;
+    visualAngularDeflection = 0.0;
 
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/View");
     unsigned long lcol = hGrp->GetUnsigned("DefaultShapeLineColor",421075455UL); // dark grey (25,25,25)
@@ -257,6 +430,7 @@ ViewProviderPartExt::ViewProviderPartExt()
     Lighting.setEnums(LightingEnums);
     ADD_PROPERTY(DrawStyle,((long int)0));
     DrawStyle.setEnums(DrawStyleEnums);
+    ADD_PROPERTY_TYPE(Tessellation,(std::string()),"",App::Prop_Hidden,"The saved triangulation of the shape");
 
     coords = new SoCoordinate3();
     coords->ref();
@@ -430,8 +604,9 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     }
     else {
         // if the object was invisible and has been changed, recreate the visual
-        if (prop == &Visibility && Visibility.getValue() && VisualTouched) {
-            updateVisual(dynamic_cast<Part::Feature*>(pcObject)->Shape.getValue());
+        // while restoring it's done once all properties are known
+        if (prop == &Visibility && Visibility.getValue() && VisualTouched && !restoring) {
+            updateShapeVisual();
             // The material has to be checked again (#0001736)
             onChanged(&DiffuseColor);
         }
@@ -641,6 +816,7 @@ bool ViewProviderPartExt::loadParameter()
     float angularDeflection = hGrp->GetFloat("MeshAngularDeflection",28.65);
     bool novertexnormals = hGrp->GetBool("NoPerVertexNormals",false);
     bool qualitynormals = hGrp->GetBool("QualityNormals",false);
+    this->parallelTessellation = hGrp->GetBool("ParallelTessellation",true);
 
     if (Deviation.getValue() != deviation) {
         Deviation.setValue(deviation);
@@ -669,15 +845,66 @@ void ViewProviderPartExt::reload()
     }
 }
 
+void ViewProviderPartExt::tessellate(const std::vector<TopoDS_Shape>& shapes)
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    double deviation = hGrp->GetFloat("MeshDeviation",0.2);
+    double angularDeflection = hGrp->GetFloat("MeshAngularDeflection",28.65) / 180.0 * M_PI;
+
+    // Shapes sharing a face or an edge with an earlier shape are meshed afterwards
+    // because meshing the same face, or storing the polygons of the same edge,
+    // in two threads at once is not safe.
+    std::vector<ShapeTessellation> independent, dependent;
+    TopTools_MapOfShape done, faces, edges;
+    for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
+        if (it->IsNull())
+            continue;
+        ShapeTessellation task;
+        task.shape = it->Located(TopLoc_Location());
+        if (!done.Add(task.shape))
+            continue;
+        task.deflection = getDeflection(task.shape, deviation);
+        task.angularDeflection = angularDeflection;
+        if (task.deflection <= 0.0 || isMeshed(task.shape, task.deflection))
+            continue;
+
+        // an edge is bounded by several faces of the same shape, so only the
+        // distinct sub-shapes are compared with those of the other shapes
+        bool shared = false;
+        TopTools_IndexedMapOfShape shapeFaces, shapeEdges;
+        TopExp::MapShapes(task.shape, TopAbs_FACE, shapeFaces);
+        TopExp::MapShapes(task.shape, TopAbs_EDGE, shapeEdges);
+        for (int i=1; i <= shapeFaces.Extent(); i++) {
+            if (!faces.Add(shapeFaces(i)))
+                shared = true;
+        }
+        for (int i=1; i <= shapeEdges.Extent(); i++) {
+            if (!edges.Add(shapeEdges(i)))
+                shared = true;
+        }
+        if (shared)
+            dependent.push_back(task);
+        else
+            independent.push_back(task);
+    }
+
+    if (independent.size() > 1) {
+        QtConcurrent::blockingMap(independent, meshShape);
+    }
+    else {
+        std::for_each(independent.begin(), independent.end(), meshShape);
+    }
+    std::for_each(dependent.begin(), dependent.end(), meshShape);
+}
+
 void ViewProviderPartExt::updateData(const App::Property* prop)
 {
     if (prop->getTypeId() == Part::PropertyPartShape::getClassTypeId()) {
-        // get the shape to show
-        const TopoDS_Shape &cShape = static_cast<const Part::PropertyPartShape*>(prop)->getValue();
-
-        // calculate the visual only if visible
-        if (Visibility.getValue())
-            updateVisual(cShape);
+        // calculate the visual only if visible, the shape isn't accessed before
+        // because a restored shape is decoded on its first access
+        if (Visibility.getValue() && !restoring)
+            updateVisual(static_cast<const Part::PropertyPartShape*>(prop)->getValue());
         else
             VisualTouched = true;
 
@@ -691,6 +918,196 @@ void ViewProviderPartExt::updateData(const App::Property* prop)
     Gui::ViewProviderGeometryObject::updateData(prop);
 }
 
+void ViewProviderPartExt::startRestoring()
+{
+    // the visual is built when the saved triangulation has been restored, too
+    restoring = true;
+    Gui::ViewProviderGeometryObject::startRestoring();
+}
+
+void ViewProviderPartExt::finishRestoring()
+{
+    restoring = false;
+    if (Visibility.getValue() && VisualTouched) {
+        updateShapeVisual();
+        onChanged(&DiffuseColor);
+    }
+    Gui::ViewProviderGeometryObject::finishRestoring();
+}
+
+void ViewProviderPartExt::updateShapeVisual()
+{
+    const Part::PropertyPartShape* shape = getShapeProperty(pcObject);
+    if (!shape)
+        return;
+
+    // the triangulation saved with the project is used only once, it doesn't
+    // need the shape, so a shape restored from a container stays encoded
+    if (!Tessellation.getValue().empty()) {
+        bool restored = restoreTessellation(*shape);
+        Tessellation.clear();
+        if (restored)
+            return;
+    }
+
+    updateVisual(shape->getValue());
+}
+
+bool ViewProviderPartExt::hasTessellation() const
+{
+    if (VisualTouched)
+        return false;
+    const Part::PropertyPartShape* shape = getShapeProperty(pcObject);
+    if (!shape)
+        return false;
+    // a visual made from the saved triangulation is only known by the content hash
+    if (visualShape.IsNull())
+        return visualHash != 0 && visualHash == shape->getContentHash();
+    return shape->getValue().Located(TopLoc_Location()).IsEqual(visualShape);
+}
+
+void ViewProviderPartExt::saveTessellation(std::ostream& out) const
+{
+    const Part::PropertyPartShape* shape = getShapeProperty(pcObject);
+    if (!shape)
+        return;
+
+    int numTriangles = faceset->coordIndex.getNum() / 4;
+    Base::OutputStream str(out);
+    str << tessellationMagic << tessellationVersion << shape->getContentHash()
+        << visualDeviation << visualDeflection << visualAngularDeflection;
+    str << (uint32_t)coords->point.getNum() << (uint32_t)norm->vector.getNum()
+        << (uint32_t)numTriangles << (uint32_t)faceset->partIndex.getNum()
+        << (uint32_t)lineset->coordIndex.getNum() << (int32_t)nodeset->startIndex.getValue();
+
+    const SbVec3f* verts = coords->point.getValues(0);
+    for (int i = 0; i < coords->point.getNum(); i++)
+        str << verts[i][0] << verts[i][1] << verts[i][2];
+    const SbVec3f* norms = norm->vector.getValues(0);
+    for (int i = 0; i < norm->vector.getNum(); i++)
+        str << norms[i][0] << norms[i][1] << norms[i][2];
+    // the end marker of the triangles is not saved
+    const int32_t* index = faceset->coordIndex.getValues(0);
+    for (int i = 0; i < numTriangles; i++)
+        str << index[4*i] << index[4*i+1] << index[4*i+2];
+    const int32_t* parts = faceset->partIndex.getValues(0);
+    for (int i = 0; i < faceset->partIndex.getNum(); i++)
+        str << parts[i];
+    const int32_t* lines = lineset->coordIndex.getValues(0);
+    for (int i = 0; i < lineset->coordIndex.getNum(); i++)
+        str << lines[i];
+}
+
+bool ViewProviderPartExt::restoreTessellation(const Part::PropertyPartShape& prop)
+{
+    const std::string& data = Tessellation.getValue();
+    if (data.empty())
+        return false;
+
+    std::istringstream in(data, std::ios::in | std::ios::binary);
+    Base::InputStream str(in);
+    uint32_t magic = 0, version = 0;
+    uint64_t hash = 0;
+    double deviation = 0.0, deflection = 0.0, angularDeflection = 0.0;
+    str >> magic >> version;
+    if (magic != tessellationMagic || version != tessellationVersion)
+        return false;
+    str >> hash >> deviation >> deflection >> angularDeflection;
+
+    // The triangulation must have been made for the same shape with the same parameters.
+    // The hash covers the shape without its placement, so an equal hash means an equal
+    // bounding box and thus the same deflection for the same deviation.
+    try {
+        if (hash == 0 || hash != prop.getContentHash())
+            return false;
+        if (deviation != Deviation.getValue() ||
+            angularDeflection != AngularDeflection.getValue())
+            return false;
+    }
+    catch (Standard_Failure) {
+        return false;
+    }
+
+    uint32_t numNodes, numNorms, numTriangles, numFaces, numLines;
+    int32_t nodeStart;
+    str >> numNodes >> numNorms >> numTriangles >> numFaces >> numLines >> nodeStart;
+    std::size_t size = 2 * sizeof(uint32_t) + sizeof(uint64_t) + 3 * sizeof(double) + 6 * sizeof(uint32_t)
+        + 3 * sizeof(float) * ((std::size_t)numNodes + numNorms)
+        + sizeof(int32_t) * (3 * (std::size_t)numTriangles + numFaces + numLines);
+    if (!in || size != data.size())
+        return false;
+    // the normals belong to the nodes of the faces, which come first
+    if (numNorms > numNodes || nodeStart < 0 || (uint32_t)nodeStart > numNodes)
+        return false;
+
+    // The data is read and checked before the visual is changed, so that a damaged
+    // triangulation falls back to meshing the shape.
+    std::vector<SbVec3f> verts(numNodes), norms(numNorms);
+    std::vector<int32_t> index(4 * (std::size_t)numTriangles), parts(numFaces), lines(numLines);
+    float x, y, z;
+    for (std::vector<SbVec3f>::iterator it = verts.begin(); it != verts.end(); ++it) {
+        str >> x >> y >> z;
+        it->setValue(x, y, z);
+    }
+    for (std::vector<SbVec3f>::iterator it = norms.begin(); it != norms.end(); ++it) {
+        str >> x >> y >> z;
+        it->setValue(x, y, z);
+    }
+    // the triangles may only refer to the nodes that have a normal
+    for (uint32_t i = 0; i < numTriangles; i++) {
+        for (int j = 0; j < 3; j++) {
+            int32_t& node = index[4*i+j];
+            str >> node;
+            if (node < 0 || (uint32_t)node >= numNorms)
+                return false;
+        }
+        index[4*i+3] = SO_END_FACE_INDEX;
+    }
+    // each face gets its number of triangles
+    std::size_t partTriangles = 0;
+    for (std::vector<int32_t>::iterator it = parts.begin(); it != parts.end(); ++it) {
+        str >> *it;
+        if (*it < 0)
+            return false;
+        partTriangles += *it;
+    }
+    if (partTriangles != numTriangles)
+        return false;
+    for (std::vector<int32_t>::iterator it = lines.begin(); it != lines.end(); ++it) {
+        str >> *it;
+        if (*it != SO_END_LINE_INDEX && (*it < 0 || (uint32_t)*it >= numNodes))
+            return false;
+    }
+    if (!in)
+        return false;
+
+    coords  ->point      .setNum(numNodes);
+    norm    ->vector     .setNum(numNorms);
+    faceset ->coordIndex .setNum(numTriangles*4);
+    faceset ->partIndex  .setNum(numFaces);
+    lineset ->coordIndex .setNum(numLines);
+    std::copy(verts.begin(), verts.end(), coords  ->point       .startEditing());
+    std::copy(norms.begin(), norms.end(), norm    ->vector      .startEditing());
+    std::copy(index.begin(), index.end(), faceset ->coordIndex  .startEditing());
+    std::copy(parts.begin(), parts.end(), faceset ->partIndex   .startEditing());
+    std::copy(lines.begin(), lines.end(), lineset ->coordIndex  .startEditing());
+    nodeset->startIndex.setValue(nodeStart);
+
+    coords  ->point       .finishEditing();
+    norm    ->vector      .finishEditing();
+    faceset ->coordIndex  .finishEditing();
+    faceset ->partIndex   .finishEditing();
+    lineset ->coordIndex  .finishEditing();
+
+    visualShape.Nullify();
+    visualHash = hash;
+    visualDeviation = deviation;
+    visualDeflection = deflection;
+    visualAngularDeflection = angularDeflection;
+    VisualTouched = false;
+    return true;
+}
+
 void ViewProviderPartExt::setupContextMenu(QMenu* menu, QObject* receiver, const char* member)
 {
     Gui::ViewProviderGeometryObject::setupContextMenu(menu, receiver, member);
@@ -750,86 +1167,96 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
         faceset ->partIndex  .setNum(0);
         lineset ->coordIndex .setNum(0);
         nodeset ->startIndex .setValue(0);
+        visualShape.Nullify();
         VisualTouched = false;
         return;
     }
 
+    // We must reset the location here because the transformation data
+    // are set in the placement property. This also makes the deflection
+    // independent of the placement so that instances of a shape, which
+    // share their geometry, reuse the mesh stored on the shared faces.
+    TopLoc_Location aLoc;
+    cShape.Location(aLoc);
+
+    // a changed placement doesn't require to rebuild the visual
+    if (!VisualTouched && cShape.IsEqual(visualShape))
+        return;
+    visualShape.Nullify();
+    visualHash = 0;
+
     // time measurement and book keeping
     Base::TimeInfo start_time;
     int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
-    std::set<int> faceEdges;
 
     try {
         // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
-            Deviation.getValue();
-
-        // create or use the mesh on the data structure
+        Standard_Real deflection = getDeflection(cShape, Deviation.getValue());
+        visualDeviation = Deviation.getValue();
+        visualDeflection = deflection;
+        visualAngularDeflection = AngularDeflection.getValue();
+
+        // only mesh the shape if one of its faces has no or a too coarse triangulation
+        if (!isMeshed(cShape, deflection)) {
 #if OCC_VERSION_HEX >= 0x060600
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
-        BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
-                AngDeflectionRads,Standard_True);
+            // the faces are meshed in parallel
+            Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+            BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
+                    AngDeflectionRads,parallelTessellation ? Standard_True : Standard_False);
 #else
-        BRepMesh_IncrementalMesh(cShape,deflection);
+            BRepMesh_IncrementalMesh(cShape,deflection);
 #endif
-        // We must reset the location here because the transformation data
-        // are set in the placement property
-        TopLoc_Location aLoc;
-        cShape.Location(aLoc);
+        }
 
-        // count triangles and nodes in the mesh
+        // get an indexed map of edges
+        TopTools_IndexedMapOfShape edgeMap;
+        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
+        numEdges = edgeMap.Extent();
+        // marks the edges associated to a face
+        std::vector<bool> faceEdges(numEdges+1, false);
+
+        // count triangles and nodes in the mesh and set the offsets of the faces
+        std::vector<FaceTessellation> faces;
+        std::set<const Poly_Triangulation*> meshes;
+        bool shared = false;
         TopExp_Explorer Ex;
         for (Ex.Init(cShape,TopAbs_FACE);Ex.More();Ex.Next()) {
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(Ex.Current()), aLoc);
+            FaceTessellation face;
+            face.face = TopoDS::Face(Ex.Current());
+            face.mesh = BRep_Tool::Triangulation(face.face, face.loc);
+            face.nodeOffset = numNodes;
+            face.triaOffset = numTriangles;
+            face.part = numFaces;
+            face.shared = false;
             // Note: we must also count empty faces
-            if (!mesh.IsNull()) {
-                numTriangles += mesh->NbTriangles();
-                numNodes     += mesh->NbNodes();
-                numNorms     += mesh->NbNodes();
+            if (!face.mesh.IsNull()) {
+                numTriangles += face.mesh->NbTriangles();
+                numNodes     += face.mesh->NbNodes();
+                numNorms     += face.mesh->NbNodes();
+                // the normals of a triangulation used by several faces are computed only once
+                face.shared = !meshes.insert(face.mesh.operator->()).second;
+                shared = shared || face.shared;
             }
 
             TopExp_Explorer xp;
-            for (xp.Init(Ex.Current(),TopAbs_EDGE);xp.More();xp.Next())
-                faceEdges.insert(xp.Current().HashCode(INT_MAX));
+            for (xp.Init(face.face,TopAbs_EDGE);xp.More();xp.Next())
+                faceEdges[edgeMap.FindIndex(xp.Current())] = true;
+            faces.push_back(face);
             numFaces++;
         }
 
-        // get an indexed map of edges
-        TopTools_IndexedMapOfShape edgeMap;
-        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
-
-         // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
-        std::map<int, std::vector<int32_t> > lineSetMap;
-        std::set<int>          edgeIdxSet;
-        std::vector<int32_t>   edgeVector;
-
-        // count and index the edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            edgeIdxSet.insert(i);
-            numEdges++;
-
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-            // returns a valid object is wrong. This e.g. happens for ruled
-            // surfaces which gets created by two edges or wires.
-            // So, we have to store the hashes of the edges associated to a face.
-            // If the hash of a given edge is not in this list we know it's really
-            // a free edge.
-            int hash = aEdge.HashCode(INT_MAX);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = BRep_Tool::Polygon3D(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    int nbNodesInEdge = aPoly->NbNodes();
-                    numNodes += nbNodesInEdge;
-                }
+        // handling of the free edge that are not associated to a face
+        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+        // returns a valid object is wrong. This e.g. happens for ruled
+        // surfaces which gets created by two edges or wires.
+        // So, we have to mark the edges associated to a face.
+        // If a given edge is not marked we know it's really a free edge.
+        for (int i=1; i <= numEdges; i++) {
+            if (!faceEdges[i]) {
+                TopLoc_Location aLoc;
+                Handle(Poly_Polygon3D) aPoly = BRep_Tool::Polygon3D(TopoDS::Edge(edgeMap(i)), aLoc);
+                if (!aPoly.IsNull())
+                    numNodes += aPoly->NbNodes();
             }
         }
 
@@ -849,163 +1276,93 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
         int32_t* index = faceset ->coordIndex  .startEditing();
         int32_t* parts = faceset ->partIndex   .startEditing();
 
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
-
-        int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
-        for (Ex.Init(cShape, TopAbs_FACE); Ex.More(); Ex.Next(),ii++) {
-            TopLoc_Location aLoc;
-            const TopoDS_Face &actFace = TopoDS::Face(Ex.Current());
-            // get the mesh of the shape
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
-            if (mesh.IsNull()) continue;
-
-            // getting the transformation of the shape/face
-            gp_Trsf myTransf;
-            Standard_Boolean identity = true;
-            if (!aLoc.IsIdentity()) {
-                identity = false;
-                myTransf = aLoc.Transformation();
-            }
-
-            // getting size of node and triangle array of this face
-            int nbNodesInFace = mesh->NbNodes();
-            int nbTriInFace   = mesh->NbTriangles();
-            // check orientation
-            TopAbs_Orientation orient = actFace.Orientation();
-
-
-            // cycling through the poly mesh
-            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-            TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-            GetNormals(actFace, mesh, Normals);
-            
-            for (int g=1;g<=nbTriInFace;g++) {
-                // Get the triangle
-                Standard_Integer N1,N2,N3;
-                Triangles(g).Get(N1,N2,N3);
-
-                // change orientation of the triangle if the face is reversed
-                if ( orient != TopAbs_FORWARD ) {
-                    Standard_Integer tmp = N1;
-                    N1 = N2;
-                    N2 = tmp;
-                }
-
-                // get the 3 points of this triangle
-                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
-
-                // get the 3 normals of this triangle
-                gp_Dir NV1(Normals(N1)), NV2(Normals(N2)), NV3(Normals(N3));                
-
-                // transform the vertices and normals to the place of the face
-                if(!identity) {
-                    V1.Transform(myTransf);
-                    V2.Transform(myTransf);
-                    V3.Transform(myTransf);
-                    NV1.Transform(myTransf);
-                    NV2.Transform(myTransf);
-                    NV3.Transform(myTransf);
-                }
+        // Computing the normals evaluates the surface of a face, which may be shared
+        // with other faces, and stores them in the triangulation. This isn't thread-safe
+        // and is done here so that the filler only reads the pre-computed normals.
+        for (std::vector<FaceTessellation>::const_iterator it = faces.begin(); it != faces.end(); ++it) {
+            if (it->mesh.IsNull() || it->mesh->HasNormals())
+                continue;
+            TColgp_Array1OfDir Normals (it->mesh->Nodes().Lower(), it->mesh->Nodes().Upper());
+            GetNormals(it->face, it->mesh, Normals);
+        }
 
-                // add the normals for all points of this triangle
-                norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
-                norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
-                norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
-
-                // set the vertices
-                verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
-                verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
-                verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
-
-                // set the index vector with the 3 point indexes and the end delimiter
-                index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
-                index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
-                index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
-                index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
-            }
+        // the faces write to disjoint ranges of the arrays and can be filled in parallel
+        FaceTessellationFiller filler(verts, norms, index, parts);
+        if (parallelTessellation && numFaces > 1) {
+            QtConcurrent::blockingMap(faces, boost::bind(&FaceTessellationFiller::fill, &filler, _1, false));
+        }
+        else {
+            std::for_each(faces.begin(), faces.end(), boost::bind(&FaceTessellationFiller::fill, &filler, _1, false));
+        }
+        if (shared) {
+            std::for_each(faces.begin(), faces.end(), boost::bind(&FaceTessellationFiller::fill, &filler, _1, true));
+        }
 
-            parts[ii] = nbTriInFace; // new part
+        // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
+        std::vector< std::vector<int32_t> > lineSets(numEdges+1);
+        std::vector<bool> edgeDone(numEdges+1, false);
 
-            // handling the edges lying on this face
+        // handling the edges lying on the faces
+        for (std::vector<FaceTessellation>::const_iterator it = faces.begin(); it != faces.end(); ++it) {
+            if (it->mesh.IsNull()) continue;
             TopExp_Explorer Exp;
-            for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
+            for(Exp.Init(it->face,TopAbs_EDGE);Exp.More();Exp.Next()) {
                 const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
                 // get the overall index of this edge
                 int edgeIndex = edgeMap.FindIndex(curEdge);
-                edgeVector.push_back((int32_t)edgeIndex-1);
                 // already processed this index ?
-                if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-                    
-                    // this holds the indices of the edge's triangulation to the current polygon
-                    Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                    if (aPoly.IsNull())
-                        continue; // polygon does not exist
-                    
-                    // getting the indexes of the edge polygon
-                    const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                    for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
-                        int nodeIndex = indices(i);
-                        int index = faceNodeOffset+nodeIndex-1;
-                        lineSetMap[edgeIndex].push_back(index);
-
-                        // usually the coordinates for this edge are already set by the
-                        // triangles of the face this edge belongs to. However, there are
-                        // rare cases where some points are only referenced by the polygon
-                        // but not by any triangle. Thus, we must apply the coordinates to
-                        // make sure that everything is properly set.
-                        gp_Pnt p(Nodes(nodeIndex));
-                        if (!identity)
-                            p.Transform(myTransf);
-                        verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
-                    }
-
-                    // remove the handled edge index from the set
-                    edgeIdxSet.erase(edgeIndex);
-                }
+                if (edgeDone[edgeIndex])
+                    continue;
+
+                // this holds the indices of the edge's triangulation to the current polygon
+                Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, it->mesh, it->loc);
+                if (aPoly.IsNull())
+                    continue; // polygon does not exist
+
+                // getting the indexes of the edge polygon
+                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+                std::vector<int32_t>& lineSet = lineSets[edgeIndex];
+                lineSet.reserve(indices.Length());
+                for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++)
+                    lineSet.push_back(it->nodeOffset+indices(i)-1);
+
+                edgeDone[edgeIndex] = true;
             }
-
-            edgeVector.push_back(-1);
-            
-            // counting up the per Face offsets
-            faceNodeOffset += nbNodesInFace;
-            faceTriaOffset += nbTriInFace;
         }
 
         // handling of the free edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
+        int faceNodeOffset = numNorms;
+        for (int i=1; i <= numEdges; i++) {
+            if (faceEdges[i])
+                continue;
+
             const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            Standard_Boolean identity = true;
-            gp_Trsf myTransf;
             TopLoc_Location aLoc;
+            Handle(Poly_Polygon3D) aPoly = BRep_Tool::Polygon3D(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                Standard_Boolean identity = true;
+                gp_Trsf myTransf;
+                if (!aLoc.IsIdentity()) {
+                    identity = false;
+                    myTransf = aLoc.Transformation();
+                }
 
-            // handling of the free edge that are not associated to a face
-            int hash = aEdge.HashCode(INT_MAX);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = BRep_Tool::Polygon3D(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    if (!aLoc.IsIdentity()) {
-                        identity = false;
-                        myTransf = aLoc.Transformation();
-                    }
-
-                    const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                    int nbNodesInEdge = aPoly->NbNodes();
-
-                    gp_Pnt pnt;
-                    for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
-                        pnt = aNodes(j);
-                        if (!identity)
-                            pnt.Transform(myTransf);
-                        int index = faceNodeOffset+j-1;
-                        verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-                        lineSetMap[i].push_back(index);
-                    }
-
-                    faceNodeOffset += nbNodesInEdge;
+                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
+                int nbNodesInEdge = aPoly->NbNodes();
+                std::vector<int32_t>& lineSet = lineSets[i];
+                lineSet.reserve(nbNodesInEdge);
+
+                gp_Pnt pnt;
+                for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
+                    pnt = aNodes(j);
+                    if (!identity)
+                        pnt.Transform(myTransf);
+                    int index = faceNodeOffset+j-1;
+                    verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+                    lineSet.push_back(index);
                 }
+
+                faceNodeOffset += nbNodesInEdge;
             }
         }
 
@@ -1016,24 +1373,22 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
             verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
         }
 
-        // normalize all normals 
-        for (int i = 0; i< numNorms ;i++)
-            norms[i].normalize();
-        
-        std::vector<int32_t> lineSetCoords;
-        for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
-            lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
-            lineSetCoords.push_back(-1);
-        }
-
         // preset the index vector size
-        numLines =  lineSetCoords.size();
+        for (std::vector< std::vector<int32_t> >::const_iterator it = lineSets.begin(); it != lineSets.end(); ++it) {
+            if (!it->empty())
+                numLines += (int)it->size() + 1;
+        }
         lineset ->coordIndex .setNum(numLines);
         int32_t* lines = lineset ->coordIndex  .startEditing();
 
         int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
+        for (std::vector< std::vector<int32_t> >::const_iterator it = lineSets.begin(); it != lineSets.end(); ++it) {
+            if (it->empty())
+                continue;
+            std::copy(it->begin(), it->end(), lines + l);
+            l += (int)it->size();
+            lines[l++] = -1;
+        }
 
         // end the editing of the nodes
         coords  ->point       .finishEditing();
@@ -1041,6 +1396,8 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
         faceset ->coordIndex  .finishEditing();
         faceset ->partIndex   .finishEditing();
         lineset ->coordIndex  .finishEditing();
+
+        visualShape = cShape;
     }
     catch (...) {
         Base::Console().Error("Cannot compute Inventor representation for the shape of %s.\n",pcObject->getNameInDocument());
@@ -30,6 +30,9 @@
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <map>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include "PropertyTessellationCache.h"
 
 class TopoDS_Shape;
 class TopoDS_Edge;
@@ -52,6 +55,10 @@ class SoNormalBinding;
 class SoMaterialBinding;
 class SoIndexedLineSet;
 
+namespace Part {
+class PropertyPartShape;
+}
+
 namespace PartGui {
 
 class SoBrepFaceSet;
@@ -81,6 +88,8 @@ public:
     App::PropertyEnumeration DrawStyle;
 
     App::PropertyColorList DiffuseColor;
+    /// the triangulation of the visual that is saved with the project
+    PropertyTessellationCache Tessellation;
 
 
     virtual void attach(App::DocumentObject *);
@@ -89,8 +98,19 @@ public:
     virtual std::vector<std::string> getDisplayModes(void) const;
     /// Update the view representation
     void reload();
+    /** Meshes the shapes in parallel as their view providers would do it, so that
+     * these only need to build their visual. A shape is meshed once for all its instances.
+     */
+    static void tessellate(const std::vector<TopoDS_Shape>&);
 
     virtual void updateData(const App::Property*);
+    virtual void startRestoring();
+    virtual void finishRestoring();
+
+    /// checks whether the visual shows the current shape and can be saved
+    bool hasTessellation() const;
+    /// writes the triangulation of the visual
+    void saveTessellation(std::ostream&) const;
 
       /** @name Selection handling
       * This group of methodes do the selection handling.
@@ -121,6 +141,10 @@ protected:
     virtual void onChanged(const App::Property* prop);
     bool loadParameter();
     void updateVisual(const TopoDS_Shape &);
+    /// uses the saved triangulation for the visual if it was made for the shape
+    bool restoreTessellation(const Part::PropertyPartShape &);
+    /// builds the visual of the shape, from the saved triangulation if possible
+    void updateShapeVisual();
 
     // nodes for the data representation
     SoMaterialBinding * pcShapeBind;
@@ -143,6 +167,16 @@ private:
     // settings stuff
     bool noPerVertexNormals;
     bool qualityNormals;
+    bool parallelTessellation;
+    bool restoring;
+    // the shape of the current visual without its placement, it is null if the
+    // visual was made from the saved triangulation of the shape with visualHash
+    TopoDS_Shape visualShape;
+    boost::uint64_t visualHash;
+    // the deviation, deflection and angular deflection in degrees of the current visual
+    double visualDeviation;
+    double visualDeflection;
+    double visualAngularDeflection;
     static App::PropertyFloatConstraint::Constraints sizeRange;
     static App::PropertyFloatConstraint::Constraints tessRange;
     static App::PropertyQuantityConstraint::Constraints angDeflectionRange;
@@ -19,7 +19,7 @@
 #   USA                                                                   *
 #**************************************************************************
 
-import FreeCAD, os, sys, unittest, Part
+import FreeCAD, os, sys, unittest, tempfile, Part
 App = FreeCAD
 
 #---------------------------------------------------------------------------
@@ -35,7 +35,231 @@ class PartTestCases(unittest.TestCase):
 		self.Box = App.ActiveDocument.addObject("Part::Box","Box")
 		self.Doc.recompute()
 		self.failUnless(len(self.Box.Shape.Faces)==6)
-		
+
+	def testSaveAndRestoreShape(self):
+		shape = Part.makeBox(1,2,3).cut(Part.makeCylinder(0.5,5))
+		shape.tessellate(0.1)
+		self.Doc.addObject("Part::Feature","Shape").Shape = shape
+		fileName = os.path.join(tempfile.gettempdir(), "PartTest.FCStd")
+		param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+		binary = param.GetBool("BinaryBrep", True)
+		try:
+			for value in [True, False]:
+				param.SetBool("BinaryBrep", value)
+				self.Doc.saveAs(fileName)
+				FreeCAD.closeDocument("PartTest")
+				self.Doc = FreeCAD.openDocument(fileName)
+				restored = self.Doc.Shape.Shape
+				self.failUnless(len(restored.Faces) == len(shape.Faces))
+				self.failUnless(abs(restored.Volume - shape.Volume) < 1e-7)
+		finally:
+			param.SetBool("BinaryBrep", binary)
+			os.remove(fileName)
+
+	def testRemoveSplitter(self):
+		box = Part.makeBox(1,1,1)
+		fused = box.fuse(Part.makeBox(1,1,1,FreeCAD.Vector(1,0,0)))
+		self.failUnless(len(fused.removeSplitter().Faces) == 6)
+		cylinder = Part.makeCylinder(1,1)
+		fused = cylinder.fuse(Part.makeCylinder(1,1,FreeCAD.Vector(0,0,1)))
+		self.failUnless(len(fused.removeSplitter().Faces) == 3)
+		# the shells of a compound are refined independently
+		other = fused.copy()
+		other.translate(FreeCAD.Vector(5,0,0))
+		refined = Part.makeCompound([fused, other]).removeSplitter()
+		self.failUnless(len(refined.Solids) == 2)
+		self.failUnless(len(refined.Faces) == 6)
+
+	def testMultiFuse(self):
+		box = Part.makeBox(1,1,1)
+		# two overlapping boxes and one apart from them
+		fused = box.multiFuse([Part.makeBox(1,1,1,FreeCAD.Vector(0.5,0,0)), Part.makeBox(1,1,1,FreeCAD.Vector(5,0,0))])
+		self.failUnless(len(fused.Solids) == 2)
+		self.failUnless(abs(fused.Volume - 2.5) < 1e-6)
+
+	def testSaveAndRestoreInstances(self):
+		shape = Part.makeCylinder(0.5,5)
+		for i in range(3):
+			feature = self.Doc.addObject("Part::Feature","Instance")
+			feature.Shape = shape
+			feature.Placement.Base = FreeCAD.Vector(2*i,0,0)
+		fileName = os.path.join(tempfile.gettempdir(), "PartTest.FCStd")
+		param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+		instances = param.GetBool("SaveInstances", False)
+		try:
+			param.SetBool("SaveInstances", True)
+			self.Doc.saveAs(fileName)
+			FreeCAD.closeDocument("PartTest")
+			self.Doc = FreeCAD.openDocument(fileName)
+			features = self.Doc.findObjects("Part::Feature")
+			self.failUnless(len(features) == 3)
+			for i in range(3):
+				restored = features[i].Shape
+				self.failUnless(restored.isPartner(features[0].Shape))
+				self.failUnless(abs(restored.Volume - shape.Volume) < 1e-7)
+				self.failUnless(restored.BoundBox.XMin > 2*i - 0.5 - 1e-7)
+				self.failUnless(features[i].Placement.Base == FreeCAD.Vector(2*i,0,0))
+			# a copy of an instance alone gets the geometry of its own
+			copy = self.Doc.copyObject(features[2])
+			self.failUnless(abs(copy.Shape.Volume - shape.Volume) < 1e-7)
+			self.failUnless(abs(copy.Shape.BoundBox.XMin - 3.5) < 1e-7)
+			# merged instances are linked once the files are read
+			merged = FreeCAD.newDocument("PartMerge")
+			try:
+				merged.mergeProject(fileName)
+				features = merged.findObjects("Part::Feature")
+				self.failUnless(len(features) == 3)
+				for i in range(3):
+					self.failUnless(abs(features[i].Shape.Volume - shape.Volume) < 1e-7)
+					self.failUnless(abs(features[i].Shape.BoundBox.XMin - (2*i - 0.5)) < 1e-7)
+			finally:
+				FreeCAD.closeDocument("PartMerge")
+		finally:
+			param.SetBool("SaveInstances", instances)
+			os.remove(fileName)
+
+	def testSaveAndRestoreCompound(self):
+		boxes = [Part.makeBox(1,1,1,FreeCAD.Vector(2*i,0,0)) for i in range(3)]
+		compound = Part.makeCompound(boxes)
+		compound.tessellate(0.1)
+		feature = self.Doc.addObject("Part::Feature","Compound")
+		feature.Shape = compound
+		feature.Placement.Base = FreeCAD.Vector(0,0,1)
+		fileName = os.path.join(tempfile.gettempdir(), "PartTest.FCStd")
+		param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+		container = param.GetBool("ShapeContainer", False)
+		try:
+			param.SetBool("ShapeContainer", True)
+			# the second time the shape is saved again without being decoded
+			for i in range(2):
+				self.Doc.saveAs(fileName)
+				FreeCAD.closeDocument("PartTest")
+				self.Doc = FreeCAD.openDocument(fileName)
+			restored = self.Doc.Compound
+			self.failUnless(restored.Placement.Base == FreeCAD.Vector(0,0,1))
+			self.failUnless(len(restored.Shape.Solids) == 3)
+			self.failUnless(abs(restored.Shape.Volume - 3.0) < 1e-7)
+			box = restored.Shape.BoundBox
+			self.failUnless(abs(box.XMax - 5.0) < 1e-7 and abs(box.ZMin - 1.0) < 1e-7)
+		finally:
+			param.SetBool("ShapeContainer", container)
+			os.remove(fileName)
+
+	def testSaveCorruptContainer(self):
+		# a container that can't be decoded completely must be written unchanged
+		import struct, zipfile
+		boxes = [Part.makeBox(1,1,1,FreeCAD.Vector(2*i,0,0)) for i in range(3)]
+		feature = self.Doc.addObject("Part::Feature","Compound")
+		feature.Shape = Part.makeCompound(boxes)
+		fileName = os.path.join(tempfile.gettempdir(), "PartTest.FCStd")
+		copyName = os.path.join(tempfile.gettempdir(), "PartTestCopy.FCStd")
+		param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+		docParam = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+		container = param.GetBool("ShapeContainer", False)
+		reuse = docParam.GetBool("ReuseUnchangedFiles", True)
+		try:
+			param.SetBool("ShapeContainer", True)
+			docParam.SetBool("ReuseUnchangedFiles", False)
+			self.Doc.saveAs(fileName)
+			FreeCAD.closeDocument("PartTest")
+
+			# overwrite the start of the BRep data of the second chunk
+			zin = zipfile.ZipFile(fileName)
+			entries = [(info, zin.read(info.filename)) for info in zin.infolist()]
+			zin.close()
+			zout = zipfile.ZipFile(fileName, "w", zipfile.ZIP_DEFLATED)
+			corrupt = None
+			for info, data in entries:
+				if info.filename.endswith(".bsc"):
+					# header of 156 bytes and 64 bytes per chunk, the BRep size is at offset 48
+					count = struct.unpack("<I", data[144:148])[0]
+					first = struct.unpack("<I", data[156+48:156+52])[0]
+					offset = 156 + 64 * count + first
+					data = data[:offset] + "x" * 16 + data[offset+16:]
+					corrupt = data
+				zout.writestr(info, data)
+			zout.close()
+			self.failUnless(corrupt is not None)
+
+			self.Doc = FreeCAD.openDocument(fileName)
+			self.failUnless(len(self.Doc.Compound.Shape.Solids) == 2)
+			param.SetBool("ShapeContainer", False)
+			self.Doc.saveAs(copyName)
+			zin = zipfile.ZipFile(copyName)
+			names = [name for name in zin.namelist() if name.endswith(".bsc")]
+			self.failUnless(len(names) == 1)
+			self.failUnless(zin.read(names[0]) == corrupt)
+			zin.close()
+		finally:
+			param.SetBool("ShapeContainer", container)
+			docParam.SetBool("ReuseUnchangedFiles", reuse)
+			for name in [fileName, copyName]:
+				if os.path.exists(name):
+					os.remove(name)
+
+	def testSaveMovedShape(self):
+		# a new placement moves the shape in place, so its file must not be reused
+		feature = self.Doc.addObject("Part::Feature","Moved")
+		feature.Shape = Part.makeBox(1,1,1)
+		fileName = os.path.join(tempfile.gettempdir(), "PartTest.FCStd")
+		param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+		reuse = param.GetBool("ReuseUnchangedFiles", True)
+		try:
+			param.SetBool("ReuseUnchangedFiles", True)
+			self.Doc.saveAs(fileName)
+			feature.Placement = FreeCAD.Placement(FreeCAD.Vector(5,0,0), FreeCAD.Rotation())
+			self.Doc.save()
+			FreeCAD.closeDocument("PartTest")
+			self.Doc = FreeCAD.openDocument(fileName)
+			restored = self.Doc.Moved
+			self.failUnless(restored.Placement.Base == FreeCAD.Vector(5,0,0))
+			self.failUnless(abs(restored.Shape.BoundBox.XMin - 5.0) < 1e-7)
+		finally:
+			param.SetBool("ReuseUnchangedFiles", reuse)
+			for name in [fileName, fileName + "1"]:
+				if os.path.exists(name):
+					os.remove(name)
+
+	def testInUseWhileReading(self):
+		# a pipe keeps the reading thread inside the operation until the data is written
+		if not hasattr(os, "mkfifo"):
+			return
+		import threading, time
+		data = Part.makeBox(1,2,3).exportBrepToString()
+		dirName = tempfile.mkdtemp()
+		fileName = os.path.join(dirName, "InUse.brep")
+		os.mkfifo(fileName)
+		shape = Part.Shape()
+		errors = []
+		def read():
+			try:
+				shape.read(fileName)
+			except Exception as e:
+				errors.append(e)
+		thread = threading.Thread(target=read)
+		thread.start()
+		try:
+			# opening the pipe succeeds once the other thread has opened it without the GIL
+			pipe = None
+			while pipe is None and thread.isAlive():
+				try:
+					pipe = os.open(fileName, os.O_WRONLY | os.O_NONBLOCK)
+				except OSError:
+					time.sleep(0.01)
+			self.failUnless(pipe is not None)
+			try:
+				self.failUnlessRaises(RuntimeError, shape.reverse)
+				self.failUnlessRaises(RuntimeError, shape.isNull)
+			finally:
+				os.write(pipe, data)
+				os.close(pipe)
+		finally:
+			thread.join()
+			os.remove(fileName)
+			os.rmdir(dirName)
+		self.failUnless(errors == [])
+		self.failUnless(abs(shape.Volume - 6.0) < 1e-7)
+
 	def tearDown(self):
 		#closing doc
 		FreeCAD.closeDocument("PartTest")
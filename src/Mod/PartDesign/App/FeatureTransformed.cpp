@@ -23,15 +23,23 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <iterator>
 # include <BRepBuilderAPI_Transform.hxx>
 # include <BRepAlgoAPI_Fuse.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
+# include <BRepBndLib.hxx>
 # include <BRep_Builder.hxx>
+# include <Bnd_Box.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <Precision.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <QtConcurrentMap>
 #endif
 
 
@@ -156,6 +164,56 @@ void Transformed::Restore(Base::XMLReader &reader)
     reader.readEndElement("Properties");
 }
 
+// the bounding box as used by Part::checkIntersection()
+static Bnd_Box getBoundBox(const TopoDS_Shape& shape)
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    box.SetGap(0);
+    return box;
+}
+
+/// two shapes with overlapping bounding boxes which must be checked exactly
+struct IntersectionCheck {
+    TopoDS_Shape first;
+    TopoDS_Shape second;
+    bool touch_is_intersection;
+};
+
+static bool runIntersectionCheck(const IntersectionCheck& check)
+{
+    try {
+        return Part::checkIntersection(check.first, check.second, false, check.touch_is_intersection);
+    }
+    catch (Standard_Failure) {
+        return false; // as for the other errors of the boolean operations
+    }
+}
+
+// The boolean operations may modify their arguments, e.g. the tolerances, and the
+// checks share the support and the transformed shapes share the original. So each
+// check that runs in parallel gets its own copy of the shapes.
+static std::vector<bool> runIntersectionChecks(const std::vector<IntersectionCheck>& checks)
+{
+    std::vector<bool> results;
+    if (checks.size() > 1) {
+        std::vector<IntersectionCheck> copies;
+        copies.reserve(checks.size());
+        for (std::vector<IntersectionCheck>::const_iterator it = checks.begin(); it != checks.end(); ++it) {
+            IntersectionCheck check = {BRepBuilderAPI_Copy(it->first).Shape(),
+                                       BRepBuilderAPI_Copy(it->second).Shape(),
+                                       it->touch_is_intersection};
+            copies.push_back(check);
+        }
+        QList<bool> list = QtConcurrent::blockingMapped< QList<bool> >(copies, runIntersectionCheck);
+        results.assign(list.begin(), list.end());
+    }
+    else {
+        std::transform(checks.begin(), checks.end(), std::back_inserter(results), runIntersectionCheck);
+    }
+    return results;
+}
+
 short Transformed::mustExecute() const
 {
     if (Originals.isTouched())
@@ -233,6 +291,12 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         std::vector<std::vector<gp_Trsf>::const_iterator> v_transformations;
         std::vector<TopoDS_Shape> v_transformedShapes;
 
+        // Only the transformed shapes whose bounding box overlaps the one of the support
+        // need the exact check for intersection with the support
+        Bnd_Box supportBox = getBoundBox(support);
+        std::vector<std::vector<gp_Trsf>::const_iterator> v_candidates;
+        std::vector<TopoDS_Shape> v_candidateShapes;
+
         std::vector<gp_Trsf>::const_iterator t = transformations.begin();
         ++t; // Skip first transformation, which is always the identity transformation
         for (; t != transformations.end(); ++t) {
@@ -247,15 +311,30 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             if (!mkTrf.IsDone())
                 return new App::DocumentObjectExecReturn("Transformation failed", (*o));
 
-            // Check for intersection with support
-            if (!Part::checkIntersection(support, mkTrf.Shape(), false, true)) {
+            if (supportBox.IsOut(getBoundBox(mkTrf.Shape()))) {
+                nointersect_trsfms.insert(t);
+            } else {
+                v_candidates.push_back(t);
+                v_candidateShapes.push_back(mkTrf.Shape());
+            }
+        }
+
+        // Check for intersection with support
+        std::vector<IntersectionCheck> supportChecks;
+        for (std::vector<TopoDS_Shape>::const_iterator s = v_candidateShapes.begin(); s != v_candidateShapes.end(); ++s) {
+            IntersectionCheck check = {support, *s, true};
+            supportChecks.push_back(check);
+        }
+        std::vector<bool> intersects = runIntersectionChecks(supportChecks);
+        for (std::size_t i = 0; i < v_candidates.size(); i++) {
+            if (!intersects[i]) {
 #ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
                 Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
 #endif
-                nointersect_trsfms.insert(t);
+                nointersect_trsfms.insert(v_candidates[i]);
             } else {
-                v_transformations.push_back(t);
-                v_transformedShapes.push_back(mkTrf.Shape());
+                v_transformations.push_back(v_candidates[i]);
+                v_transformedShapes.push_back(v_candidateShapes[i]);
                 // Note: Transformations that do not intersect the support are ignored in the overlap tests
             }
         }
@@ -277,61 +356,94 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             // For MultiTransform, just checking the first transformed shape is not sufficient - any two
             // features might overlap, even if the original and the first shape don't overlap!
 
-            std::set<std::vector<TopoDS_Shape>::iterator> rejected_iterators;
-
-            std::vector<TopoDS_Shape>::iterator s1 = v_transformedShapes.begin();
-            std::vector<TopoDS_Shape>::iterator s2 = s1;
-            ++s2;
-            std::vector<std::vector<gp_Trsf>::const_iterator>::const_iterator t1 = v_transformations.begin();
-            std::vector<std::vector<gp_Trsf>::const_iterator>::const_iterator t2 = t1;
-            ++t2;
-            for (; s2 != v_transformedShapes.end();) {
-                // Check intersection with the original
-                if (Part::checkIntersection(shape, *s1, false, false)) {
-                    rejected_iterators.insert(s1);
-                    overlapping_trsfms.insert(*t1);
+            // Index 0 is the original, index i the transformed shape i-1
+            std::vector<const TopoDS_Shape*> shapes;
+            shapes.push_back(&shape);
+            for (std::vector<TopoDS_Shape>::const_iterator s = v_transformedShapes.begin(); s != v_transformedShapes.end(); ++s)
+                shapes.push_back(&(*s));
+
+            // Only the pairs with overlapping bounding boxes can intersect. Sorting the boxes by
+            // their lower x bound finds these pairs without comparing all of them.
+            std::vector<Bnd_Box> boxes;
+            std::vector<std::pair<double, std::size_t> > order;
+            std::vector<double> xMax;
+            for (std::size_t i = 0; i < shapes.size(); i++) {
+                boxes.push_back(getBoundBox(*shapes[i]));
+                Standard_Real x0 = 0, y0 = 0, z0 = 0, x1 = 0, y1 = 0, z1 = 0;
+                if (!boxes.back().IsVoid())
+                    boxes.back().Get(x0, y0, z0, x1, y1, z1);
+                order.push_back(std::make_pair(x0, i));
+                xMax.push_back(x1);
+            }
+            std::sort(order.begin(), order.end());
+
+            std::vector<std::pair<std::size_t, std::size_t> > pairs;
+            std::vector<IntersectionCheck> overlapChecks;
+            for (std::size_t i = 0; i < order.size(); i++) {
+                std::size_t first = order[i].second;
+                for (std::size_t j = i + 1; j < order.size() && order[j].first <= xMax[first]; j++) {
+                    std::size_t second = order[j].second;
+                    if (boxes[first].IsOut(boxes[second]))
+                        continue;
+                    std::pair<std::size_t, std::size_t> candidate(std::min(first, second), std::max(first, second));
+                    IntersectionCheck check = {*shapes[candidate.first], *shapes[candidate.second], false};
+                    pairs.push_back(candidate);
+                    overlapChecks.push_back(check);
                 }
-                // Check intersection with other transformations
-                for (; s2 != v_transformedShapes.end(); ++s2, ++t2)
-                    if (Part::checkIntersection(*s1, *s2, false, false)) {
-                        rejected_iterators.insert(s1);
-                        rejected_iterators.insert(s2);
-                        overlapping_trsfms.insert(*t1);
-                        overlapping_trsfms.insert(*t2);
-                    }
-                ++s1;
-                s2 = s1;
-                ++s2;
-                ++t1;
-                t2 = t1;
-                ++t2;
             }
-            // Check intersection of last transformation with the original
-            if (Part::checkIntersection(shape, *s1, false, false)) {
-                rejected_iterators.insert(s1);
-                overlapping_trsfms.insert(*t1);
+
+            std::vector<bool> overlaps = runIntersectionChecks(overlapChecks);
+            std::vector<bool> rejected_shapes(shapes.size(), false);
+            for (std::size_t i = 0; i < pairs.size(); i++) {
+                if (!overlaps[i])
+                    continue;
+                // an overlap with the original only rejects the transformed shape
+                if (pairs[i].first > 0) {
+                    rejected_shapes[pairs[i].first] = true;
+                    overlapping_trsfms.insert(v_transformations[pairs[i].first - 1]);
+                }
+                rejected_shapes[pairs[i].second] = true;
+                overlapping_trsfms.insert(v_transformations[pairs[i].second - 1]);
             }
 
-            for (std::set<std::vector<TopoDS_Shape>::iterator>::reverse_iterator it = rejected_iterators.rbegin();
-                 it != rejected_iterators.rend(); ++it)
-                v_transformedShapes.erase(*it);
+            std::vector<TopoDS_Shape> v_remainingShapes;
+            for (std::size_t i = 1; i < shapes.size(); i++) {
+                if (!rejected_shapes[i])
+                    v_remainingShapes.push_back(*shapes[i]);
+            }
+            v_transformedShapes.swap(v_remainingShapes);
         }
 
         if (v_transformedShapes.empty())
             break; // Skip the boolean operation and go on to next original
 
+#if OCC_VERSION_HEX > 0x060800
+        // Pass all the valid transformations as tools of a single boolean operation
+        TopTools_ListOfShape shapeArguments, shapeTools;
+        shapeArguments.Append(support);
+        for (std::vector<TopoDS_Shape>::const_iterator s = v_transformedShapes.begin(); s != v_transformedShapes.end(); ++s)
+            shapeTools.Append(*s);
+#else
         // Build a compound from all the valid transformations
         BRep_Builder builder;
         TopoDS_Compound transformedShapes;
         builder.MakeCompound(transformedShapes);
         for (std::vector<TopoDS_Shape>::const_iterator s = v_transformedShapes.begin(); s != v_transformedShapes.end(); ++s)
             builder.Add(transformedShapes, *s);
+#endif
 
-        // Fuse/Cut the compounded transformed shapes with the support
+        // Fuse/Cut the transformed shapes with the support
         TopoDS_Shape result;
 
         if (fuse) {
+#if OCC_VERSION_HEX > 0x060800
+            BRepAlgoAPI_Fuse mkFuse;
+            mkFuse.SetArguments(shapeArguments);
+            mkFuse.SetTools(shapeTools);
+            mkFuse.Build();
+#else
             BRepAlgoAPI_Fuse mkFuse(support, transformedShapes);
+#endif
             if (!mkFuse.IsDone())
                 return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
             // we have to get the solids (fuse sometimes creates compounds)
@@ -341,7 +453,14 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
             result = refineShapeIfActive(result);
         } else {
+#if OCC_VERSION_HEX > 0x060800
+            BRepAlgoAPI_Cut mkCut;
+            mkCut.SetArguments(shapeArguments);
+            mkCut.SetTools(shapeTools);
+            mkCut.Build();
+#else
             BRepAlgoAPI_Cut mkCut(support, transformedShapes);
+#endif
             if (!mkCut.IsDone())
                 return new App::DocumentObjectExecReturn("Cut out of support failed", *o);
             result = mkCut.Shape();
@@ -177,7 +177,13 @@ PyObject* PathPy::deleteCommand(PyObject * args)
 PyObject* PathPy::toGCode(PyObject * args)
 {
     if (PyArg_ParseTuple(args, "")) {
-        std::string result = getToolpathPtr()->toGCode();
+        std::string result;
+        {
+            Base::PyAllowThreads threads;
+            threads.read(this);
+            threads.release();
+            result = getToolpathPtr()->toGCode();
+        }
         return PyString_FromString(result.c_str());
     }
     throw Py::Exception("This method accepts no argument");
@@ -188,7 +194,12 @@ PyObject* PathPy::setFromGCode(PyObject * args)
     char *pstr=0;
     if (PyArg_ParseTuple(args, "s", &pstr)) {
         std::string gcode(pstr);
-        getToolpathPtr()->setFromGCode(gcode);
+        {
+            Base::PyAllowThreads threads;
+            threads.write(this);
+            threads.release();
+            getToolpathPtr()->setFromGCode(gcode);
+        }
         Py_INCREF(Py_None);
         return Py_None;
     }
@@ -95,7 +95,11 @@ PyObject* PointsPy::read(PyObject * args)
         return NULL;                         
 
     PY_TRY {
-        getPointKernelPtr()->load(Name);
+        Base::Reference<PointKernel> kernel(getPointKernelPtr());
+        Base::PyAllowThreads threads;
+        threads.write(this);
+        threads.release();
+        kernel->load(Name);
     } PY_CATCH;
     
     Py_Return; 
@@ -108,7 +112,11 @@ PyObject* PointsPy::write(PyObject * args)
         return NULL;                         
 
     PY_TRY {
-        getPointKernelPtr()->save(Name);
+        Base::Reference<PointKernel> kernel(getPointKernelPtr());
+        Base::PyAllowThreads threads;
+        threads.read(this);
+        threads.release();
+        kernel->save(Name);
     } PY_CATCH;
     
     Py_Return; 
@@ -0,0 +1,700 @@
+#   (c) FreeCAD Developers 2015 LGPL
+#
+#   Performance benchmarks of the FreeCAD core and the modules.
+#   They are not part of TestApp.All() because they take a while. Run them with
+#     FreeCADCmd Mod/Test/Benchmarks.py
+#   with TestApp.Test("Benchmarks") or with the 'benchmark' build target. The timings are written as JSON to the
+#   file given by the environment variable FC_BENCHMARK_OUTPUT or to
+#   FreeCADBenchmark.json in the current directory. FC_BENCHMARK_SCALE scales
+#   the size of the synthetic data sets. FC_BENCHMARK_STEP may list reference
+#   STEP files, separated like the PATH, whose import is measured as well.
+
+import FreeCAD, os, sys, time, math, random, tempfile, unittest, json, platform
+
+Scale = float(os.environ.get("FC_BENCHMARK_SCALE", "1"))
+Results = []
+
+
+def size(n):
+    return max(1, int(n * Scale))
+
+
+def writeResults():
+    fileName = os.environ.get("FC_BENCHMARK_OUTPUT", "FreeCADBenchmark.json")
+    data = {}
+    data["version"] = FreeCAD.Version()
+    data["platform"] = platform.platform()
+    data["python"] = sys.version.split()[0]
+    data["date"] = time.strftime("%Y-%m-%dT%H:%M:%S")
+    data["scale"] = Scale
+    data["results"] = Results
+    file = open(fileName, "w")
+    json.dump(data, file, indent=1, sort_keys=True)
+    file.close()
+    FreeCAD.Console.PrintMessage("Benchmark results written to %s\n" % os.path.abspath(fileName))
+
+
+def tearDownModule():
+    writeResults()
+
+#---------------------------------------------------------------------------
+# reproducible synthetic data sets
+#---------------------------------------------------------------------------
+
+
+def makeSurfaceFacets(n):
+    """ a wavy surface of 2*n*n triangles """
+    def z(x, y):
+        return math.sin(0.3 * x) * math.cos(0.2 * y)
+    facets = []
+    for i in range(n):
+        for j in range(n):
+            p1 = (i, j, z(i, j))
+            p2 = (i + 1, j, z(i + 1, j))
+            p3 = (i + 1, j + 1, z(i + 1, j + 1))
+            p4 = (i, j + 1, z(i, j + 1))
+            facets.append([p1, p2, p3])
+            facets.append([p1, p3, p4])
+    return facets
+
+
+def makePointCloud(n, seed=4711):
+    rand = random.Random(seed)
+    return [FreeCAD.Vector(rand.uniform(-100, 100), rand.uniform(-100, 100), rand.uniform(-100, 100)) for i in range(n)]
+
+
+def makeGCode(n, seed=4711):
+    rand = random.Random(seed)
+    lines = ["G21", "G90", "G0 Z5.000"]
+    for i in range(n):
+        lines.append("G1 X%.3f Y%.3f Z%.3f F%.1f" % (rand.uniform(0, 200), rand.uniform(0, 200), rand.uniform(-5, 0), 600.0))
+    lines.append("G0 Z5.000")
+    return "\n".join(lines) + "\n"
+
+
+def makeChainDocument(doc, n):
+    """ n linked objects where each object takes its value by an expression from the previous one """
+    prev = None
+    for i in range(n):
+        obj = doc.addObject("App::FeatureTest", "Chain%d" % i)
+        if prev:
+            obj.Link = prev
+            obj.setExpression("Integer", "%s.Integer + 1" % prev.Name)
+        prev = obj
+    return doc
+
+
+def makePolygonSketch(sketch, n):
+    """ a closed, fully constrained polygon with n edges """
+    import Part, Sketcher
+    points = [FreeCAD.Vector(100 * math.cos(2 * math.pi * i / n), 100 * math.sin(2 * math.pi * i / n), 0) for i in range(n)]
+    for i in range(n):
+        sketch.addGeometry(Part.Line(points[i], points[(i + 1) % n]))
+    for i in range(n):
+        sketch.addConstraint(Sketcher.Constraint("Coincident", i, 2, (i + 1) % n, 1))
+    for i in range(n):
+        sketch.addConstraint(Sketcher.Constraint("Distance", i, 1, -1, 1, 100.0))
+    return sketch
+
+#---------------------------------------------------------------------------
+# the benchmarks
+#---------------------------------------------------------------------------
+
+
+class BenchmarkCase(unittest.TestCase):
+    Repeat = 3
+
+    def measure(self, name, count, func):
+        """ records the best time of several runs of func """
+        best = None
+        for i in range(self.Repeat):
+            start = time.time()
+            func()
+            elapsed = time.time() - start
+            if best is None or elapsed < best:
+                best = elapsed
+        Results.append({"name": name, "size": count, "seconds": best, "repeat": self.Repeat})
+        FreeCAD.Console.PrintMessage("%-40s %10d %10.4f s\n" % (name, count, best))
+        return best
+
+
+class MeshBenchmarks(BenchmarkCase):
+
+    def setUp(self):
+        import Mesh
+        self.facets = makeSurfaceFacets(size(300))
+        self.mesh = Mesh.Mesh(self.facets)
+        self.TempPath = tempfile.gettempdir()
+
+    def testMeshBuilder(self):
+        import Mesh
+        self.measure("Mesh.build", len(self.facets), lambda: Mesh.Mesh(self.facets))
+
+    def testMeshIO(self):
+        import Mesh
+        for ext in ["stl", "ast", "obj", "off", "ply"]:
+            fileName = os.path.join(self.TempPath, "benchmark." + ext)
+            self.measure("Mesh.write." + ext, self.mesh.CountFacets, lambda: self.mesh.write(fileName))
+            self.measure("Mesh.read." + ext, self.mesh.CountFacets, lambda: Mesh.Mesh().read(fileName))
+            os.remove(fileName)
+
+    def testMeshGrid(self):
+        n = size(300)
+        rays = [(FreeCAD.Vector(0.5 + i * n / 50.0, 0.5 + i * n / 70.0, 10), FreeCAD.Vector(0, 0, -1)) for i in range(50)]
+
+        def pick():
+            for pnt, dir in rays:
+                self.mesh.nearestFacetOnRay(pnt, dir)
+        self.measure("Mesh.nearestFacetOnRay", len(rays), pick)
+        planes = [(FreeCAD.Vector(i, 0, 0), FreeCAD.Vector(1, 0, 0)) for i in range(1, n, max(1, n / 20))]
+        self.measure("Mesh.crossSections", len(planes), lambda: self.mesh.crossSections(planes))
+
+    def testMeshAlgorithms(self):
+        def smooth():
+            self.mesh.copy().smooth(3)
+        self.measure("Mesh.smooth", self.mesh.CountFacets, smooth)
+        self.measure("Mesh.hasSelfIntersections", self.mesh.CountFacets, lambda: self.mesh.hasSelfIntersections())
+
+    def testMeshKernel(self):
+        # compare builds with and without FREECAD_USE_MESH_COMPACT_INDICES
+        import Mesh
+        result = {"name": "Mesh.memory", "size": self.mesh.CountFacets, "bytes": self.mesh.MemSize}
+        Results.append(result)
+        FreeCAD.Console.PrintMessage("%-40s %10d %10d bytes\n" % (result["name"], result["size"], result["bytes"]))
+        self.measure("Mesh.rebuildNeighbourHood", self.mesh.CountFacets, lambda: self.mesh.rebuildNeighbourHood())
+
+        def evaluate():
+            self.mesh.hasNonManifolds()
+            self.mesh.hasNonUniformOrientedFacets()
+            self.mesh.countComponents()
+            self.mesh.isSolid()
+        self.measure("Mesh.evaluate", self.mesh.CountFacets, evaluate)
+        fileName = os.path.join(self.TempPath, "benchmark.bms")
+        self.measure("Mesh.write.bms", self.mesh.CountFacets, lambda: self.mesh.write(fileName))
+        self.measure("Mesh.read.bms", self.mesh.CountFacets, lambda: Mesh.Mesh().read(fileName))
+        os.remove(fileName)
+
+
+class PointsBenchmarks(BenchmarkCase):
+
+    def testPointsIO(self):
+        import Points
+        cloud = Points.Points()
+        cloud.addPoints(makePointCloud(size(200000)))
+        fileName = os.path.join(tempfile.gettempdir(), "benchmark.asc")
+        self.measure("Points.write.asc", cloud.CountPoints, lambda: cloud.write(fileName))
+        self.measure("Points.read.asc", cloud.CountPoints, lambda: Points.Points().read(fileName))
+        os.remove(fileName)
+
+
+class DocumentBenchmarks(BenchmarkCase):
+
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("Benchmark")
+        self.count = size(500)
+        makeChainDocument(self.Doc, self.count)
+        self.Doc.recompute()
+        self.FileName = os.path.join(tempfile.gettempdir(), "Benchmark.FCStd")
+
+    def testRecompute(self):
+        def recompute():
+            self.Doc.Chain0.touch()
+            self.Doc.recompute()
+        self.measure("Document.recompute", self.count, recompute)
+        self.failUnless(self.Doc.getObject("Chain%d" % (self.count - 1)).Integer == self.Doc.Chain0.Integer + self.count - 1)
+
+    def testExpressions(self):
+        def evaluate():
+            self.Doc.Chain0.Integer = self.Doc.Chain0.Integer + 1
+            self.Doc.recompute()
+        self.measure("Expression.evaluate", self.count, evaluate)
+
+    def testSaveRestore(self):
+        self.measure("Document.save", self.count, lambda: self.Doc.saveCopy(self.FileName))
+
+        def restore():
+            doc = FreeCAD.openDocument(self.FileName)
+            FreeCAD.closeDocument(doc.Name)
+        self.measure("Document.restore", self.count, restore)
+        os.remove(self.FileName)
+
+    def testIncrementalSave(self):
+        values = [0.1 * i for i in range(size(5000))]
+        for obj in self.Doc.Objects:
+            obj.FloatList = values
+        self.Doc.saveAs(self.FileName)
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        reuse = param.GetBool("ReuseUnchangedFiles", True)
+
+        def save():
+            self.Doc.Chain0.FloatList = self.Doc.Chain0.FloatList + [1.0]
+            self.Doc.save()
+        try:
+            param.SetBool("ReuseUnchangedFiles", False)
+            self.measure("Document.save.full", self.count, save)
+            param.SetBool("ReuseUnchangedFiles", True)
+            self.measure("Document.save.incremental", self.count, save)
+        finally:
+            param.SetBool("ReuseUnchangedFiles", reuse)
+        for fileName in [self.FileName, self.FileName + "1"]:
+            if os.path.exists(fileName):
+                os.remove(fileName)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("Benchmark")
+
+
+class TypeBenchmarks(BenchmarkCase):
+
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("TypeBenchmark")
+        self.count = size(2000)
+        makeChainDocument(self.Doc, self.count)
+        self.Objects = self.Doc.Objects
+
+    def testOutList(self):
+        def outList():
+            for obj in self.Objects:
+                obj.OutList
+        self.measure("Document.OutList", self.count, outList)
+
+    def testIsDerivedFrom(self):
+        def derived():
+            for obj in self.Objects:
+                obj.isDerivedFrom("App::DocumentObject")
+                obj.isDerivedFrom("App::FeatureTest")
+        self.measure("Type.isDerivedFrom", 2 * self.count, derived)
+
+    def testSelectionFilter(self):
+        if not FreeCAD.GuiUp:
+            self.skipTest("Selection filters need the GUI")
+        import FreeCADGui
+        sel = FreeCADGui.Selection.Filter("SELECT App::DocumentObject COUNT 1")
+
+        def filter():
+            for obj in self.Objects:
+                sel.test(obj)
+        self.measure("Selection.Filter.test", self.count, filter)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("TypeBenchmark")
+
+
+class PropertyBenchmarks(BenchmarkCase):
+    """ property lookup by name from Python and from the C++ expression engine """
+    Names = ["Integer", "Float", "ExecCount", "TypeAll", "ConstraintFloat", "Label", "Dynamic"]
+    Numbers = ["Integer", "Float", "ExecCount", "TypeHidden", "TypeReadOnly", "TypeOutput", "TypeAll",
+               "ConstraintInt", "ConstraintFloat", "Dynamic"]
+
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("PropertyBenchmark")
+        self.count = size(20000)
+        self.Source = self.Doc.addObject("App::FeatureTest", "Source")
+        self.Source.addProperty("App::PropertyFloat", "Dynamic")
+
+    def testPythonAttribute(self):
+        obj = self.Source
+
+        def lookup():
+            for i in range(self.count):
+                for name in self.Names:
+                    getattr(obj, name)
+        self.measure("Property.lookup.python", self.count * len(self.Names), lookup)
+
+    def testGetPropertyByName(self):
+        obj = self.Source
+
+        def lookup():
+            for i in range(self.count):
+                for name in self.Names:
+                    obj.getPropertyByName(name)
+        self.measure("Property.getPropertyByName", self.count * len(self.Names), lookup)
+
+    def testExpression(self):
+        # each evaluation resolves all identifiers of the expression in C++
+        terms = size(100)
+        target = self.Doc.addObject("App::FeatureTest", "Target")
+        target.setExpression("Float", " + ".join(["Source.%s" % self.Numbers[i % len(self.Numbers)] for i in range(terms)]))
+        self.Doc.recompute()
+
+        def evaluate():
+            for i in range(100):
+                target.touch()
+                self.Doc.recompute()
+        self.measure("Property.lookup.expression", 100 * terms, evaluate)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("PropertyBenchmark")
+
+
+class PartBenchmarks(BenchmarkCase):
+
+    def setUp(self):
+        try:
+            import Part
+        except ImportError:
+            self.skipTest("Part module not available")
+        self.Doc = FreeCAD.newDocument("PartBenchmark")
+        self.count = size(500)
+        self.Doc.beginBulkCreation()
+        for i in range(self.count):
+            box = Part.makeBox(10, 10, 10, FreeCAD.Vector(20 * i, 0, 0))
+            cyl = Part.makeCylinder(3, 20, FreeCAD.Vector(20 * i + 5, 5, -5))
+            shape = box.cut(cyl)
+            shape.tessellate(0.1)
+            self.Doc.addObject("Part::Feature", "Shape%d" % i).Shape = shape
+        self.Doc.endBulkCreation()
+        self.FileName = os.path.join(tempfile.gettempdir(), "PartBenchmark.FCStd")
+        self.Param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+        self.Binary = self.Param.GetBool("BinaryBrep", True)
+        self.Container = self.Param.GetBool("ShapeContainer", False)
+
+    def saveRestore(self, format):
+        self.measure("PartShape.save." + format, self.count, lambda: self.Doc.saveCopy(self.FileName))
+
+        def restore():
+            doc = FreeCAD.openDocument(self.FileName)
+            FreeCAD.closeDocument(doc.Name)
+        self.measure("PartShape.restore." + format, self.count, restore)
+        os.remove(self.FileName)
+
+    def testBinary(self):
+        self.Param.SetBool("BinaryBrep", True)
+        self.Param.SetBool("ShapeContainer", False)
+        self.saveRestore("bin")
+
+    def testContainer(self):
+        self.Param.SetBool("BinaryBrep", True)
+        self.Param.SetBool("ShapeContainer", True)
+        self.saveRestore("bsc")
+
+    def testDecode(self):
+        # the shapes are only decoded when they are accessed after restoring
+        self.Param.SetBool("BinaryBrep", True)
+        self.Param.SetBool("ShapeContainer", True)
+        self.Doc.saveCopy(self.FileName)
+
+        def restore():
+            doc = FreeCAD.openDocument(self.FileName)
+            for obj in doc.Objects:
+                obj.Shape.Volume
+            FreeCAD.closeDocument(doc.Name)
+        self.measure("PartShape.decode.bsc", self.count, restore)
+        os.remove(self.FileName)
+
+    def testAscii(self):
+        self.Param.SetBool("BinaryBrep", False)
+        self.saveRestore("brp")
+
+    def tearDown(self):
+        self.Param.SetBool("BinaryBrep", self.Binary)
+        self.Param.SetBool("ShapeContainer", self.Container)
+        FreeCAD.closeDocument("PartBenchmark")
+
+
+class RefineBenchmarks(BenchmarkCase):
+    """ refining the result of a patterned union, like a PartDesign body with refine enabled """
+
+    def setUp(self):
+        try:
+            import Part
+        except ImportError:
+            self.skipTest("Part module not available")
+        self.count = size(100)
+        plate = Part.makeBox(10 * self.count, 10, 2)
+        tools = []
+        for i in range(self.count):
+            # a rib splitting the plate faces and a boss with coplanar cylinder faces
+            tools.append(Part.makeBox(2, 10, 4, FreeCAD.Vector(10 * i, 0, 0)))
+            tools.append(Part.makeCylinder(2, 3, FreeCAD.Vector(10 * i + 6, 5, 0)))
+            tools.append(Part.makeCylinder(2, 3, FreeCAD.Vector(10 * i + 6, 5, 2)))
+        self.shape = plate.multiFuse(tools)
+        self.compound = Part.makeCompound([self.shape.copy() for i in range(4)])
+
+    def testRefineSolid(self):
+        self.measure("Part.removeSplitter.solid", self.count, lambda: self.shape.removeSplitter())
+
+    def testRefineCompound(self):
+        self.measure("Part.removeSplitter.compound", 4 * self.count, lambda: self.compound.removeSplitter())
+
+
+class BooleanBenchmarks(BenchmarkCase):
+    """ fusing many solids, mostly apart from each other with some overlapping clusters """
+
+    def setUp(self):
+        try:
+            import Part
+        except ImportError:
+            self.skipTest("Part module not available")
+        self.count = size(100)
+        self.doc = FreeCAD.newDocument("BooleanBenchmarks")
+        self.shapes = []
+        for i in range(self.count):
+            pos = FreeCAD.Vector(20 * (i % 10), 20 * (i // 10), 0)
+            self.shapes.append(Part.makeBox(10, 10, 10, pos))
+            if i % 4 == 0:
+                self.shapes.append(Part.makeCylinder(3, 15, pos + FreeCAD.Vector(5, 5, 0)))
+                self.shapes.append(Part.makeSphere(4, pos + FreeCAD.Vector(10, 10, 10)))
+        features = []
+        for i, shape in enumerate(self.shapes):
+            feature = self.doc.addObject("Part::Feature", "Solid%d" % i)
+            feature.Shape = shape
+            features.append(feature)
+        self.fusion = self.doc.addObject("Part::MultiFuse", "Fusion")
+        self.fusion.Shapes = features
+        self.param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/Boolean")
+        self.treeReduction = self.param.GetBool("TreeReduction", False)
+
+    def testMultiFuse(self):
+        self.measure("Part.multiFuse", len(self.shapes), lambda: self.shapes[0].multiFuse(self.shapes[1:]))
+
+    def recompute(self, treeReduction):
+        self.param.SetBool("TreeReduction", treeReduction)
+        self.fusion.touch()
+        self.doc.recompute()
+        self.assertTrue(self.fusion.Shape.isValid())
+
+    def testGeneralFuse(self):
+        self.measure("Part.MultiFuse.general", len(self.shapes), lambda: self.recompute(False))
+
+    def testTreeReduction(self):
+        self.measure("Part.MultiFuse.tree", len(self.shapes), lambda: self.recompute(True))
+
+    def tearDown(self):
+        self.param.SetBool("TreeReduction", self.treeReduction)
+        FreeCAD.closeDocument(self.doc.Name)
+
+
+class PatternBenchmarks(BenchmarkCase):
+    """ patterns of a hole in a plate, a square pattern takes count*count holes """
+    Repeat = 1
+
+    def setUp(self):
+        try:
+            import Part, Sketcher, PartDesign
+        except ImportError:
+            self.skipTest("PartDesign module not available")
+        self.Doc = FreeCAD.newDocument("PatternBenchmark")
+        self.count = size(10)
+        half = 5.0 * self.count + 5.0
+        plate = self.Doc.addObject("Sketcher::SketchObject", "PlateSketch")
+        corners = [FreeCAD.Vector(-half, -half, 0), FreeCAD.Vector(half, -half, 0),
+                   FreeCAD.Vector(half, half, 0), FreeCAD.Vector(-half, half, 0)]
+        for i in range(4):
+            plate.addGeometry(Part.Line(corners[i], corners[(i + 1) % 4]))
+        for i in range(4):
+            plate.addConstraint(Sketcher.Constraint("Coincident", i, 2, (i + 1) % 4, 1))
+        self.Plate = self.Doc.addObject("PartDesign::Pad", "Plate")
+        self.Plate.Sketch = plate
+        self.Plate.Length = 5
+        self.Doc.recompute()
+
+        self.Corner = self.makeHole("Corner", FreeCAD.Vector(5 - half, 5 - half, 0))
+        self.Ring = self.makeHole("Ring", FreeCAD.Vector(half / 2, 0, 0))
+
+    def makeHole(self, name, center):
+        import Part
+        sketch = self.Doc.addObject("Sketcher::SketchObject", name + "Sketch")
+        sketch.Support = (self.Plate, ["Face6"])
+        sketch.addGeometry(Part.Circle(center, FreeCAD.Vector(0, 0, 1), 2))
+        pocket = self.Doc.addObject("PartDesign::Pocket", name)
+        pocket.Sketch = sketch
+        pocket.Type = 1 # through all
+        self.Doc.recompute()
+        return pocket
+
+    def makeLinearPattern(self, name, axis, original):
+        pattern = self.Doc.addObject("PartDesign::LinearPattern", name)
+        pattern.Direction = (self.Plate.Sketch, [axis])
+        pattern.Length = 10.0 * (self.count - 1)
+        pattern.Occurrences = self.count
+        if original:
+            pattern.Originals = [original]
+        return pattern
+
+    def recompute(self, pattern):
+        pattern.touch()
+        self.Doc.recompute()
+
+    def testLinearPattern(self):
+        pattern = self.makeLinearPattern("LinearPattern", "H_Axis", self.Corner)
+        self.measure("PartDesign.LinearPattern", self.count, lambda: self.recompute(pattern))
+
+    def testPolarPattern(self):
+        pattern = self.Doc.addObject("PartDesign::PolarPattern", "PolarPattern")
+        pattern.Axis = (self.Ring.Sketch, ["N_Axis"])
+        pattern.Occurrences = self.count
+        pattern.Originals = [self.Ring]
+        self.measure("PartDesign.PolarPattern", self.count, lambda: self.recompute(pattern))
+
+    def testMultiTransform(self):
+        pattern = self.Doc.addObject("PartDesign::MultiTransform", "MultiTransform")
+        rows = self.makeLinearPattern("Rows", "H_Axis", None)
+        columns = self.makeLinearPattern("Columns", "V_Axis", None)
+        pattern.Transformations = [rows, columns]
+        pattern.Originals = [self.Corner]
+        self.measure("PartDesign.MultiTransform", self.count * self.count, lambda: self.recompute(pattern))
+
+    def tearDown(self):
+        FreeCAD.closeDocument("PatternBenchmark")
+
+
+class StepBenchmarks(BenchmarkCase):
+    """ an assembly with many placed instances of the same fastener """
+
+    def setUp(self):
+        try:
+            import Part, Import
+        except ImportError:
+            self.skipTest("Import module not available")
+        self.Doc = FreeCAD.newDocument("StepBenchmark")
+        self.count = size(500)
+        head = Part.makeCylinder(5, 3)
+        shaft = Part.makeCylinder(2.5, 20, FreeCAD.Vector(0, 0, -20))
+        screw = head.fuse(shaft)
+        self.Doc.beginBulkCreation()
+        for i in range(self.count):
+            feature = self.Doc.addObject("Part::Feature", "Screw%d" % i)
+            feature.Shape = screw
+            feature.Placement.Base = FreeCAD.Vector(15 * (i % 25), 15 * (i / 25), 0)
+        self.Doc.endBulkCreation()
+        self.StepFile = os.path.join(tempfile.gettempdir(), "StepBenchmark.step")
+        self.FileName = os.path.join(tempfile.gettempdir(), "StepBenchmark.FCStd")
+        Import.export(self.Doc.Objects, self.StepFile)
+
+    def testImportInstances(self):
+        import Import
+
+        def insert():
+            doc = FreeCAD.newDocument("StepImport")
+            Import.insert(self.StepFile, doc.Name)
+            FreeCAD.closeDocument(doc.Name)
+        self.measure("Step.import.instances", self.count, insert)
+
+        doc = FreeCAD.newDocument("StepImport")
+        Import.insert(self.StepFile, doc.Name)
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/General")
+        instances = param.GetBool("SaveInstances", False)
+        param.SetBool("SaveInstances", True)
+        try:
+            self.measure("Step.save.instances", self.count, lambda: doc.saveCopy(self.FileName))
+        finally:
+            param.SetBool("SaveInstances", instances)
+        FreeCAD.closeDocument(doc.Name)
+        result = {"name": "Step.file.instances", "size": self.count}
+        result["bytes"] = os.path.getsize(self.FileName)
+        try:
+            import resource
+            result["maxrss"] = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        except ImportError:
+            pass
+        Results.append(result)
+        FreeCAD.Console.PrintMessage("%-40s %10d %10d bytes\n" % (result["name"], self.count, result["bytes"]))
+        os.remove(self.FileName)
+
+    def recordStages(self, name, count):
+        import Import
+        for stage, seconds in Import.stageTimes():
+            Results.append({"name": "%s.%s" % (name, stage), "size": count, "seconds": seconds, "repeat": 1})
+            FreeCAD.Console.PrintMessage("%-40s %10d %10.4f s\n" % ("%s.%s" % (name, stage), count, seconds))
+
+    def testStages(self):
+        import Import
+        doc = FreeCAD.newDocument("StepImport")
+        Import.insert(self.StepFile, doc.Name)
+        self.recordStages("Step.import.stage", self.count)
+        Import.export(doc.Objects, self.StepFile)
+        self.recordStages("Step.export.stage", self.count)
+        FreeCAD.closeDocument(doc.Name)
+
+    def testReferenceFiles(self):
+        import Import
+        files = [f for f in os.environ.get("FC_BENCHMARK_STEP", "").split(os.pathsep) if f]
+        if not files:
+            self.skipTest("no reference STEP files given")
+        for fileName in files:
+            name = "Step.import.%s" % os.path.splitext(os.path.basename(fileName))[0]
+
+            def insert():
+                doc = FreeCAD.newDocument("StepReference")
+                Import.insert(fileName, doc.Name)
+                FreeCAD.closeDocument(doc.Name)
+            self.measure(name, 1, insert)
+            self.recordStages(name, 1)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("StepBenchmark")
+        if os.path.exists(self.StepFile):
+            os.remove(self.StepFile)
+
+
+class ConsoleBenchmarks(BenchmarkCase):
+    """ the time a thread spends in the console calls, not the time until the output appears """
+
+    def setUp(self):
+        self.count = size(20000)
+
+    def printLog(self):
+        for i in range(self.count):
+            FreeCAD.Console.PrintLog("Benchmark log message %d\n" % i)
+
+    def testSynchronous(self):
+        FreeCAD.Console.SetAsync(False)
+        self.measure("Console.PrintLog.sync", self.count, self.printLog)
+
+    def testAsynchronous(self):
+        FreeCAD.Console.SetAsync(True)
+        try:
+            self.measure("Console.PrintLog.async", self.count, self.printLog)
+        finally:
+            FreeCAD.Console.SetAsync(False)
+
+    def testFiltered(self):
+        status = {}
+        for name in ["Console", "File", "GUIConsole", "ReportOutput"]:
+            value = FreeCAD.Console.GetStatus(name, "Log")
+            if value is not None:
+                status[name] = value
+                FreeCAD.Console.SetStatus(name, "Log", False)
+        try:
+            self.measure("Console.PrintLog.filtered", self.count, self.printLog)
+        finally:
+            for name, value in status.items():
+                FreeCAD.Console.SetStatus(name, "Log", value)
+
+
+class SketcherBenchmarks(BenchmarkCase):
+
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("SketchBenchmark")
+
+    def testSolve(self):
+        try:
+            import Sketcher
+        except ImportError:
+            self.skipTest("Sketcher module not available")
+        sketch = self.Doc.addObject("Sketcher::SketchObject", "Polygon")
+        n = size(100)
+        makePolygonSketch(sketch, n)
+        self.measure("GCS.solve", n, lambda: sketch.solve())
+
+    def tearDown(self):
+        FreeCAD.closeDocument("SketchBenchmark")
+
+
+class PathBenchmarks(BenchmarkCase):
+
+    def testGCode(self):
+        try:
+            import Path
+        except ImportError:
+            self.skipTest("Path module not available")
+        n = size(50000)
+        gcode = makeGCode(n)
+        self.measure("Path.parse", n, lambda: Path.Path(gcode))
+        path = Path.Path(gcode)
+        self.measure("Path.toGCode", n, lambda: path.toGCode())
+
+
+if __name__ == "__main__":
+    unittest.TextTestRunner(stream=sys.stdout, verbosity=2).run(unittest.defaultTestLoader.loadTestsFromName("Benchmarks"))
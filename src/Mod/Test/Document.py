@@ -141,6 +141,118 @@ class DocumentBasicCases(unittest.TestCase):
   def testMem(self):
     self.Doc.MemSize
 
+  def testInList(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L3 = self.Doc.addObject("App::FeatureTest","Label_3")
+    L2.Link = L1
+    L3.LinkList = [L1, L2]
+    self.failUnless(L1.InList == [L2, L3])
+    self.failUnless(L2.InList == [L3])
+    self.failUnless(L3.OutList == [L1, L2])
+    L2.Link = None
+    self.failUnless(L1.InList == [L3])
+    self.Doc.openTransaction("Rem")
+    self.Doc.removeObject(L3.Name)
+    self.Doc.commitTransaction()
+    self.failUnless(L1.InList == [])
+    self.failUnless(L2.InList == [])
+    self.Doc.undo()
+    L3 = self.Doc.getObject("Label_3")
+    self.failUnless(L1.InList == [L3])
+    self.failUnless(L2.InList == [L3])
+
+  def testExpressionInList(self):
+    T1 = self.Doc.addObject("App::FeatureTest","Target")
+    E = self.Doc.addObject("App::FeatureTest","Expression")
+    E.setExpression("Integer", "Target.Integer + 1")
+    self.failUnless(T1.InList == [E])
+    self.Doc.removeObject(T1.Name)
+    self.failUnless(E.OutList == [])
+    T2 = self.Doc.addObject("App::FeatureTest","Target")
+    self.failUnless(T2.InList == [E])
+    self.failUnless(E.OutList == [T2])
+
+  def testUniqueName(self):
+    names = [self.Doc.addObject("App::FeatureTest","Box").Name for i in range(4)]
+    self.failUnless(names == ["Box", "Box001", "Box002", "Box003"])
+    self.Doc.removeObject("Box003")
+    self.failUnless(self.Doc.addObject("App::FeatureTest","Box").Name == "Box003")
+    self.Doc.addObject("App::FeatureTest","Box0099")
+    self.failUnless(self.Doc.addObject("App::FeatureTest","Box").Name == "Box0100")
+    self.failUnless(self.Doc.addObject("App::FeatureTest","Box001").Name == "Box001001")
+    self.failUnless(self.Doc.addObject("App::FeatureTest","Box001").Name == "Box001002")
+
+  def testBulkCreation(self):
+    self.Doc.beginBulkCreation()
+    self.Doc.beginBulkCreation()
+    L1 = self.Doc.addObject("App::FeatureTest","Bulk")
+    L2 = self.Doc.addObject("App::FeatureTest","Bulk")
+    L2.Link = L1
+    self.Doc.endBulkCreation()
+    L3 = self.Doc.addObject("App::FeatureTest","Bulk")
+    self.Doc.removeObject(L3.Name)
+    self.Doc.endBulkCreation()
+    self.failUnless(self.Doc.Objects == [L1, L2])
+    self.failUnless(self.Doc.ActiveObject == L2)
+    self.failUnless(L1.InList == [L2])
+
+  def testBulkCreationScope(self):
+    class Observer:
+      def __init__(self):
+        self.created = []
+      def slotCreatedObject(self, obj):
+        self.created.append(obj.Name)
+    obs = Observer()
+    FreeCAD.addDocumentObserver(obs)
+    try:
+      try:
+        with FreeCAD.BulkCreation(self.Doc):
+          self.Doc.addObject("App::FeatureTest","Bulk")
+          self.failUnless(obs.created == [])
+          raise ValueError("abort")
+      except ValueError:
+        pass
+      self.failUnless(obs.created == ["Bulk"])
+      # the bulk creation has ended, so new objects are announced immediately
+      self.Doc.addObject("App::FeatureTest","Single")
+      self.failUnless(obs.created == ["Bulk", "Single"])
+    finally:
+      FreeCAD.removeDocumentObserver(obs)
+
+  def testRecomputeProfile(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L2.Link = L1
+    table = self.Doc.recomputeProfile()
+    self.failUnless(table.find("Label_1") >= 0)
+    self.failUnless(table.find("Label_2") >= 0)
+    table = self.Doc.recomputeProfile()
+    self.failUnless(table.find("Label_1") < 0)
+    trace = os.path.join(tempfile.gettempdir(), "RecomputeProfile.json")
+    table = self.Doc.recomputeProfile(trace, True)
+    self.failUnless(table.find("Label_2") >= 0)
+    file = open(trace)
+    data = file.read()
+    file.close()
+    os.remove(trace)
+    self.failUnless(data.startswith('{"traceEvents":['))
+
+  def testProfiling(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    FreeCAD.setProfiling(True)
+    try:
+      self.Doc.recompute()
+    finally:
+      FreeCAD.setProfiling(False)
+    self.failUnless(FreeCAD.writeProfile().find("Label_1") >= 0)
+    # disabled profiler doesn't record anything
+    L1.touch()
+    self.Doc.recompute()
+    FreeCAD.setProfiling(True)
+    FreeCAD.setProfiling(False)
+    self.failUnless(FreeCAD.writeProfile().find("Label_1") < 0)
+
   def testAddRemove(self):
     L1 = self.Doc.addObject("App::FeatureTest","Label_1")
     # must delete object
@@ -594,6 +706,27 @@ class DocumentPlatformCases(unittest.TestCase):
     self.failUnless(abs(self.Doc.Test.ColourList[1][2] - 1.0) < 0.01)
     self.failUnless(abs(self.Doc.Test.ColourList[1][3] - 0.0) < 0.01)
 
+  def testIncrementalSave(self):
+    self.Doc.Test.FloatList = [1.0, 2.0]
+    other = self.Doc.addObject("App::FeatureTest", "Other")
+    other.FloatList = [3.0, 4.0]
+    self.Doc.saveAs(self.DocName)
+    FreeCAD.closeDocument("PlatformTests")
+    self.Doc = FreeCAD.open(self.DocName)
+
+    # only the changed list is written anew, the other one is copied from the last file
+    self.Doc.Test.FloatList = [5.0]
+    self.Doc.addObject("App::FeatureTest", "Added").FloatList = [6.0]
+    self.Doc.save()
+    self.Doc.removeObject("Added")
+    self.Doc.save()
+    FreeCAD.closeDocument("PlatformTests")
+    self.Doc = FreeCAD.open(self.DocName)
+
+    self.failUnless(self.Doc.Test.FloatList == [5.0])
+    self.failUnless(self.Doc.Other.FloatList == [3.0, 4.0])
+    self.failUnless(self.Doc.getObject("Added") is None)
+
   def testVectorList(self):
     self.Doc.Test.VectorList = [(-0.05, 2.5, 5.2),(-0.05, 2.5, 5.2)]
 
@@ -758,6 +891,19 @@ class DocumentPropertyCases(unittest.TestCase):
     FreeCAD.closeDocument("PropertyTests")
     self.Doc = FreeCAD.open(tempFile)
 
+  def testPropertyLookup(self):
+    self.Obj.addProperty("App::PropertyInteger","Count","Group1","Number of items")
+    self.failUnless(self.Obj.getGroupOfProperty("Count") == "Group1")
+    self.failUnless(self.Obj.getDocumentationOfProperty("Count") == "Number of items")
+    self.failUnless(self.Obj.getGroupOfProperty("Label") == "Base")
+    self.Obj.Count = 5
+    self.failUnless(self.Obj.Count == 5)
+    self.Obj.removeProperty("Count")
+    self.failUnless(not "Count" in self.Obj.PropertiesList)
+    self.Obj.addProperty("App::PropertyString","Count")
+    self.Obj.Count = "five"
+    self.failUnless(self.Obj.Count == "five")
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("PropertyTests")
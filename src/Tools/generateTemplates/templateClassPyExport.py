@@ -447,6 +447,18 @@ PyObject * @self.export.Name@::staticCallback_@i.Name@ (PyObject *self, PyObject
         PyErr_SetString(PyExc_ReferenceError, "This object is immutable, you can not set any attribute or call a non const method");
         return NULL;
     }
+
+    // test if another thread works on the object without holding the GIL
+    if (static_cast<PyObjectBase*>(self)->isBusy()) {
+        PyErr_SetString(PyExc_RuntimeError, "This object is in use by another thread, you can not call a non const method");
+        return NULL;
+    }
+= else:
+    // test if another thread modifies the object without holding the GIL
+    if (static_cast<PyObjectBase*>(self)->isModifying()) {
+        PyErr_SetString(PyExc_RuntimeError, "This object is being modified by another thread");
+        return NULL;
+    }
 -
 
     try { // catches all exceptions coming up from c++ and generate a python exception
@@ -525,6 +537,10 @@ PyObject * @self.export.Name@::staticCallback_get@i.Name@ (PyObject *self, void
         PyErr_SetString(PyExc_ReferenceError, "This object is already deleted most likely through closing a document. This reference is no longer valid!");
         return NULL;
     }
+    if (static_cast<PyObjectBase*>(self)->isModifying()){
+        PyErr_SetString(PyExc_RuntimeError, "This object is being modified by another thread");
+        return NULL;
+    }
 
     try {
         return Py::new_reference_to(static_cast<@self.export.Name@*>(self)->get@i.Name@());
@@ -559,6 +575,10 @@ int @self.export.Name@::staticCallback_set@i.Name@ (PyObject *self, PyObject *va
         PyErr_SetString(PyExc_ReferenceError, "This object is immutable, you can not set any attribute or call a method");
         return -1;
     }
+    if (static_cast<PyObjectBase*>(self)->isBusy()){
+        PyErr_SetString(PyExc_RuntimeError, "This object is in use by another thread, you can not set any attribute");
+        return -1;
+    }
 
     try {
 + if (i.Parameter.Type == "Float"):
@@ -54,6 +54,10 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes an entry whose data is already compressed. The compressed
+      data is copied from is. See ZipOutputStreambuf::putRawEntry(). */
+  void putRawEntry( const ZipCDirEntry &entry, std::istream &is ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
@@ -81,6 +81,40 @@ void ZipOutputStreambuf::putNextEntry( const ZipCDirEntry &entry ) {
 }
 
 
+void ZipOutputStreambuf::putRawEntry( const ZipCDirEntry &entry, istream &is ) {
+  // check that all the raw data is there before anything is written, a
+  // failure after the local header would leave a corrupt archive behind
+  istream::pos_type start = is.tellg() ;
+  is.seekg( 0, ios::end ) ;
+  istream::pos_type end = is.tellg() ;
+  is.seekg( start ) ;
+  if ( !is || start == istream::pos_type( -1 ) ||
+       end - start < static_cast< streamoff >( entry.getCompressedSize() ) )
+    throw IOException( "ZipOutputStreambuf::putRawEntry(): raw data is missing" ) ;
+
+  if ( _open_entry )
+    closeEntry() ;
+
+  _entries.push_back( entry ) ;
+  ZipCDirEntry &ent = _entries.back() ;
+
+  ostream os( _outbuf ) ;
+  ent.setLocalHeaderOffset( os.tellp() ) ;
+  os << static_cast< ZipLocalEntry >( ent ) ;
+
+  vector< char > buf( 65536 ) ;
+  uint32 remaining = ent.getCompressedSize() ;
+  while ( remaining > 0 ) {
+    uint32 count = min< uint32 >( remaining, buf.size() ) ;
+    is.read( &buf[ 0 ], count ) ;
+    if ( static_cast< uint32 >( is.gcount() ) != count )
+      throw IOException( "ZipOutputStreambuf::putRawEntry(): unexpected end of the raw data" ) ;
+    os.write( &buf[ 0 ], count ) ;
+    remaining -= count ;
+  }
+}
+
+
 void ZipOutputStreambuf::setComment( const string &comment ) {
   _zip_comment = comment ;
 }
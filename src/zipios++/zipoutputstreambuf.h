@@ -49,6 +49,13 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes an entry whose data is already compressed, e.g. an entry of
+      another zip archive. The compressed size, crc, size and method must
+      be set in entry. The compressed data is read from is and copied
+      without being decompressed. If is doesn't hold the whole compressed
+      data an IOException is thrown before anything is written. */
+  void putRawEntry( const ZipCDirEntry &entry, istream &is ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 